@@ -191,6 +191,10 @@ namespace asio2::detail
 			// close all async_events
 			this->notify_all_events();
 
+			// execute the events which are pushed from the other threads, they hold the self
+			// shared_ptr, if they are left in the lock free queue, will cause loop refrence.
+			this->_drain_mpsc_events();
+
 			// destroy user data, maybe the user data is self shared_ptr, if don't destroy it,
 			// will cause loop refrence.
 			this->user_data_.reset();
@@ -230,6 +234,27 @@ namespace asio2::detail
 		 */
 		inline io_t & io() { return this->io_; }
 
+		/**
+		 * @function : set the granularity of the coarse timer wheel of the io_contexts, then the
+		 * silence timer, the connect timeout timer and the rpc call timeout timer are registered
+		 * to the timer wheel of the io_context instead of owning an asio::steady_timer each. It's
+		 * useful when there are a large number of mostly idle sessions, the cost is that these
+		 * timers maybe expired one granularity later. zero means disabled, the default is disabled.
+		 * must be called before start.
+		 * eg : timer_granularity(std::chrono::milliseconds(100));
+		 */
+		template<class Rep, class Period>
+		inline derived_t & timer_granularity(std::chrono::duration<Rep, Period> granularity)
+		{
+			this->_timer_granularity(std::chrono::duration_cast<std::chrono::milliseconds>(granularity));
+			return this->derived();
+		}
+
+		/**
+		 * @function : get the granularity of the coarse timer wheel
+		 */
+		inline std::chrono::milliseconds timer_granularity() { return this->io_.timer_granularity(); }
+
 		/**
 		 * @function : set the default remote call timeout for rpc/rdc
 		 */
@@ -324,7 +324,7 @@ namespace asio2::detail
 
 			if constexpr (args_t::is_session)
 			{
-				ASIO2_ASSERT(derive.sessions().io().strand().running_in_this_thread());
+				ASIO2_ASSERT(derive.sessions().io(derive.hash_key()).strand().running_in_this_thread());
 			}
 			else
 			{
@@ -373,7 +373,7 @@ namespace asio2::detail
 				// Is session : Only call fire_connect notification when the connection is succeed.
 				if constexpr (args_t::is_session)
 				{
-					ASIO2_ASSERT(derive.sessions().io().strand().running_in_this_thread());
+					ASIO2_ASSERT(derive.sessions().io(derive.hash_key()).strand().running_in_this_thread());
 
 					if (!ec)
 					{
@@ -22,6 +22,8 @@
 #include <asio2/base/error.hpp>
 #include <asio2/base/log.hpp>
 
+#include <asio2/base/detail/coarse_timer.hpp>
+
 namespace asio2::detail
 {
 	template<class derived_t, class args_t = void>
@@ -32,7 +34,7 @@ namespace asio2::detail
 		 * @constructor
 		 */
 		explicit connect_timeout_cp(io_t & io)
-			: connect_timeout_timer_(io.context())
+			: connect_timeout_timer_(io)
 		{
 			this->connect_timer_canceled_.clear();
 		}
@@ -84,8 +86,7 @@ namespace asio2::detail
 			// reset the "canceled" flag to false, see reconnect_timer_cp.hpp -> _make_reconnect_timer
 			this->connect_timer_canceled_.clear();
 
-			this->connect_timeout_timer_.expires_after(duration);
-			this->connect_timeout_timer_.async_wait(asio::bind_executor(derive.io().strand(),
+			this->connect_timeout_timer_.async_wait(duration,
 			[&derive, self_ptr = std::move(this_ptr)](const error_code& ec) mutable
 			{
 				// bug fixed : 
@@ -98,7 +99,7 @@ namespace asio2::detail
 
 				// can't do it like below, beacuse "this" maybe deleted already.
 				// this->...
-			}));
+			});
 		}
 
 		inline void _handle_connect_timeout_timer(const error_code& ec, std::shared_ptr<derived_t> this_ptr)
@@ -160,8 +161,7 @@ namespace asio2::detail
 			// reset the "canceled" flag to false, see reconnect_timer_cp.hpp -> _make_reconnect_timer
 			this->connect_timer_canceled_.clear();
 
-			this->connect_timeout_timer_.expires_after(duration);
-			this->connect_timeout_timer_.async_wait(asio::bind_executor(derive.io().strand(),
+			this->connect_timeout_timer_.async_wait(duration,
 			[this, self_ptr = std::move(this_ptr), f = std::forward<Fn>(fn)]
 			(const error_code& ec) mutable
 			{
@@ -180,7 +180,7 @@ namespace asio2::detail
 				this->connect_timer_canceled_.clear();
 
 				f(ec);
-			}));
+			});
 		}
 
 		inline void _stop_connect_timeout_timer(asio::error_code ec)
@@ -210,12 +210,11 @@ namespace asio2::detail
 			this->is_stop_connect_timeout_timer_called_ = true;
 		#endif
 
-			error_code ec_ignore{};
 			try
 			{
 				this->connect_error_code_ = ec;
 				this->connect_timer_canceled_.test_and_set();
-				this->connect_timeout_timer_.cancel(ec_ignore);
+				this->connect_timeout_timer_.cancel();
 			}
 			catch (system_error&) {}
 			catch (std::exception&) {}
@@ -232,7 +231,7 @@ namespace asio2::detail
 		}
 
 	protected:
-		asio::steady_timer                          connect_timeout_timer_;
+		coarse_timer                                connect_timeout_timer_;
 
 		std::atomic_flag                            connect_timer_canceled_;
 
@@ -32,6 +32,7 @@
 #include <asio2/base/detail/util.hpp>
 #include <asio2/base/detail/function_traits.hpp>
 #include <asio2/base/detail/buffer_wrap.hpp>
+#include <asio2/base/detail/slab_allocator.hpp>
 
 namespace asio2::detail
 {
@@ -50,6 +51,10 @@ namespace asio2::detail
 		~data_persistence_cp() = default;
 
 	protected:
+		/**
+		 * @function : copy the data which doesn't own the memory into a string, the string is
+		 * allocated from the slab cache, so the small sends don't touch the global heap.
+		 */
 		template<class T>
 		inline auto _data_persistence(T&& data)
 		{
@@ -63,12 +68,12 @@ namespace asio2::detail
 				if constexpr /**/ (is_string_view_v<data_type>)
 				{
 					using value_type = typename data_type::value_type;
-					return std::basic_string<value_type>(data.data(), data.size());
+					return slab_basic_string<value_type>(data.data(), data.size());
 				}
 				// char* , const char* 
 				else if constexpr (is_char_pointer_v<data_type>)
 				{
-					return std::basic_string<std::remove_cv_t<std::remove_pointer_t<data_type>>>(std::forward<T>(data));
+					return slab_basic_string<std::remove_cv_t<std::remove_pointer_t<data_type>>>(std::forward<T>(data));
 				}
 				// object like : std::string, std::vector
 				else
@@ -80,7 +85,7 @@ namespace asio2::detail
 			{
 				// PodType (&data)[N] like : char buf[5], int buf[5], double buf[5]
 				auto buffer = asio::buffer(data);
-				return std::string(reinterpret_cast<const std::string::value_type*>(
+				return slab_basic_string<char>(reinterpret_cast<const char*>(
 					const_cast<const void*>(buffer.data())), buffer.size());
 			}
 		}
@@ -89,7 +94,7 @@ namespace asio2::detail
 		inline auto _data_persistence(CharT * s, SizeT count)
 		{
 			using value_type = typename std::remove_cv_t<std::remove_reference_t<CharT>>;
-			return std::basic_string<value_type>(s, count);
+			return slab_basic_string<value_type>(s, count);
 		}
 
 		template<typename = void>
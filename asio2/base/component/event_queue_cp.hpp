@@ -21,6 +21,8 @@
 #include <string>
 #include <future>
 #include <queue>
+#include <deque>
+#include <atomic>
 #include <tuple>
 #include <utility>
 #include <string_view>
@@ -32,6 +34,9 @@
 #include <asio2/base/detail/util.hpp>
 #include <asio2/base/detail/function_traits.hpp>
 #include <asio2/base/detail/buffer_wrap.hpp>
+#include <asio2/base/detail/mpsc_queue.hpp>
+#include <asio2/base/detail/slab_allocator.hpp>
+#include <asio2/base/detail/metrics.hpp>
 
 namespace asio2::detail
 {
@@ -153,7 +158,36 @@ namespace asio2::detail
 		/**
 		 * @destructor
 		 */
-		~event_queue_cp() = default;
+		~event_queue_cp()
+		{
+			// the events which are not executed, eg : the io_context is destroyed before them
+			if (this->metrics_)
+				this->metrics_->send_queue_depth.sub(static_cast<std::int64_t>(this->events_.size()));
+		}
+
+	public:
+		/**
+		 * @function : enable or disable the lock free event queue, default is disabled.
+		 * When enabled, the events (eg : async_send) which are pushed from the threads that are
+		 * not the io thread are enqueued into a lock free multi producer single consumer queue
+		 * directly, and only the first event after the queue is idle posts a task into the io
+		 * strand to drain the queue, instead of posting a task into the strand for each event.
+		 * It's useful when many threads send data into the same session at a high rate.
+		 * note : must be called before start.
+		 */
+		inline derived_t& mpsc_event_queue(bool enable)
+		{
+			this->mpsc_enabled_ = enable;
+			return static_cast<derived_t&>(*this);
+		}
+
+		/**
+		 * @function : get whether the lock free event queue is enabled.
+		 */
+		inline bool mpsc_event_queue() const
+		{
+			return this->mpsc_enabled_;
+		}
 
 	protected:
 		/**
@@ -177,7 +211,8 @@ namespace asio2::detail
 			if (derive.io().strand().running_in_this_thread())
 			{
 				bool empty = this->events_.empty();
-				this->events_.emplace(std::forward<Callback>(f));
+				this->events_.emplace_back(std::forward<Callback>(f));
+				this->_event_pushed(derive);
 				if (empty)
 				{
 					(this->events_.front())(event_queue_guard<derived_t>{derive});
@@ -185,6 +220,24 @@ namespace asio2::detail
 				return (derive);
 			}
 
+			if (this->mpsc_enabled_)
+			{
+				this->mpsc_events_.push(std::forward<Callback>(f));
+
+				// only the first event after the queue is drained need to post the drain task, the
+				// release makes the pushed event visible to the drain task.
+				if (!this->mpsc_draining_.exchange(true, std::memory_order_acq_rel))
+				{
+					asio::post(derive.io().strand(), make_allocator(derive.wallocator(),
+					[this, p = derive.selfptr()]() mutable
+					{
+						this->_drain_mpsc_events();
+					}));
+				}
+
+				return (derive);
+			}
+
 			// beacuse the callback "f" hold the derived_ptr already,
 			// so this callback for asio::post don't need hold the derived_ptr again.
 			asio::post(derive.io().strand(), make_allocator(derive.wallocator(),
@@ -193,7 +246,8 @@ namespace asio2::detail
 				ASIO2_ASSERT(this->events_.size() < std::size_t(32767));
 
 				bool empty = this->events_.empty();
-				this->events_.emplace(std::move(f));
+				this->events_.emplace_back(std::move(f));
+				this->_event_pushed(derive);
 				if (empty)
 				{
 					(this->events_.front())(event_queue_guard<derived_t>{derive});
@@ -219,7 +273,8 @@ namespace asio2::detail
 
 				if (!this->events_.empty())
 				{
-					this->events_.pop();
+					this->events_.pop_front();
+					this->metrics_->send_queue_depth.sub(1);
 
 					if (!this->events_.empty())
 					{
@@ -243,7 +298,8 @@ namespace asio2::detail
 
 				if (!this->events_.empty())
 				{
-					this->events_.pop();
+					this->events_.pop_front();
+					this->metrics_->send_queue_depth.sub(1);
 
 					if (!this->events_.empty())
 					{
@@ -258,8 +314,69 @@ namespace asio2::detail
 			return (derive);
 		}
 
+		/**
+		 * count the event which is pushed into the event queue, must be called in the strand.
+		 */
+		inline void _event_pushed(derived_t& derive) noexcept
+		{
+			if (!this->metrics_)
+				this->metrics_ = derive.io().metrics_ptr();
+
+			this->metrics_->send_queue_depth.add(1);
+		}
+
+		/**
+		 * Move the events of the lock free queue into the event queue, and execute the front
+		 * element of the event queue if the event queue was empty.
+		 */
+		inline void _drain_mpsc_events()
+		{
+			derived_t& derive = static_cast<derived_t&>(*this);
+
+			ASIO2_ASSERT(derive.io().strand().running_in_this_thread());
+
+			// must clear the flag before pop, the event which is pushed after here will post
+			// another drain task, so no event will be left in the queue. the acquire pairs with
+			// the release of the producers, so all the events pushed before are visible.
+			this->mpsc_draining_.exchange(false, std::memory_order_acq_rel);
+
+			bool empty = this->events_.empty();
+
+			event_function f;
+
+			while (this->mpsc_events_.pop(f))
+			{
+				ASIO2_ASSERT(this->events_.size() < std::size_t(32767));
+
+				this->events_.emplace_back(std::move(f));
+				this->_event_pushed(derive);
+			}
+
+			if (empty && !this->events_.empty())
+			{
+				(this->events_.front())(event_queue_guard<derived_t>{derive});
+			}
+		}
+
 	protected:
-		std::queue<std::function<void(event_queue_guard<derived_t>&&)>> events_;
+		/// the event and the queue nodes are allocated from the slab cache of the io_context thread
+		using event_function = slab_function<void(event_queue_guard<derived_t>&&)>;
+
+		/// the coalesced tcp sends are found by walking the queue, so it is a deque, not a queue
+		std::deque<event_function, slab_allocator<event_function>>       events_;
+
+		/// the lock free queue for the events which are pushed from the other threads
+		mpsc_queue<event_function>                                       mpsc_events_;
+
+		/// whether a drain task of the lock free queue is posted already
+		std::atomic_bool                                                 mpsc_draining_{ false };
+
+		/// whether the lock free queue is enabled
+		bool                                                             mpsc_enabled_ = false;
+
+		/// the metrics of the io which the events are executed in, the count of the events in
+		/// the queue is the send_queue_depth.
+		std::shared_ptr<io_metrics>                                      metrics_;
 	};
 }
 
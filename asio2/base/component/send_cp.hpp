@@ -87,12 +87,8 @@ namespace asio2::detail
 				if (!derive.is_started())
 					asio::detail::throw_error(asio::error::not_connected);
 
-				derive.push_event(
-				[&derive, p = derive.selfptr(), data = derive._data_persistence(std::forward<DataT>(data))]
-				(event_queue_guard<derived_t>&& g) mutable
-				{
-					derive._do_send(data, [g = std::move(g)](const error_code&, std::size_t) mutable {});
-				});
+				derive._send_enqueue(derive._data_persistence(std::forward<DataT>(data)),
+				[](const error_code&, std::size_t) mutable {});
 			}
 			catch (system_error & e) { set_last_error(e); }
 			catch (std::exception &) { set_last_error(asio::error::eof); }
@@ -136,11 +132,8 @@ namespace asio2::detail
 				if (!s)
 					asio::detail::throw_error(asio::error::invalid_argument);
 
-				derive.push_event([&derive, p = derive.selfptr(), data = derive._data_persistence(s, count)]
-				(event_queue_guard<derived_t>&& g) mutable
-				{
-					derive._do_send(data, [g = std::move(g)](const error_code&, std::size_t) mutable {});
-				});
+				derive._send_enqueue(derive._data_persistence(s, count),
+				[](const error_code&, std::size_t) mutable {});
 			}
 			catch (system_error & e) { set_last_error(e); }
 			catch (std::exception &) { set_last_error(asio::error::eof); }
@@ -175,15 +168,10 @@ namespace asio2::detail
 				if (!derive.is_started())
 					asio::detail::throw_error(asio::error::not_connected);
 
-				derive.push_event([&derive, p = derive.selfptr(), promise = std::move(promise),
-					data = derive._data_persistence(std::forward<DataT>(data))]
-				(event_queue_guard<derived_t>&& g) mutable
+				derive._send_enqueue(derive._data_persistence(std::forward<DataT>(data)),
+				[promise = std::move(promise)](const error_code& ec, std::size_t bytes_sent) mutable
 				{
-					derive._do_send(data, [&promise, g = std::move(g)]
-					(const error_code& ec, std::size_t bytes_sent) mutable
-					{
-						promise().set_value(std::pair<error_code, std::size_t>(ec, bytes_sent));
-					});
+					promise().set_value(std::pair<error_code, std::size_t>(ec, bytes_sent));
 				});
 			}
 			catch (system_error & e)
@@ -247,14 +235,10 @@ namespace asio2::detail
 				if (!s)
 					asio::detail::throw_error(asio::error::invalid_argument);
 
-				derive.push_event([&derive, p = derive.selfptr(), data = derive._data_persistence(s, count),
-					promise = std::move(promise)](event_queue_guard<derived_t>&& g) mutable
+				derive._send_enqueue(derive._data_persistence(s, count),
+				[promise = std::move(promise)](const error_code& ec, std::size_t bytes_sent) mutable
 				{
-					derive._do_send(data, [&promise, g = std::move(g)]
-					(const error_code& ec, std::size_t bytes_sent) mutable
-					{
-						promise().set_value(std::pair<error_code, std::size_t>(ec, bytes_sent));
-					});
+					promise().set_value(std::pair<error_code, std::size_t>(ec, bytes_sent));
 				});
 			}
 			catch (system_error & e)
@@ -294,15 +278,10 @@ namespace asio2::detail
 				if (!derive.is_started())
 					asio::detail::throw_error(asio::error::not_connected);
 
-				derive.push_event([&derive, p = derive.selfptr(), data = derive._data_persistence(std::forward<DataT>(data)),
-					fn = std::forward<Callback>(fn)](event_queue_guard<derived_t>&& g) mutable
+				derive._send_enqueue(derive._data_persistence(std::forward<DataT>(data)),
+				[fn = std::forward<Callback>(fn)](const error_code&, std::size_t bytes_sent) mutable
 				{
-					derive._do_send(data, [&fn, g = std::move(g)]
-					(const error_code&, std::size_t bytes_sent) mutable
-					{
-						ASIO2_ASSERT(g.valid());
-						callback_helper::call(fn, bytes_sent);
-					});
+					callback_helper::call(fn, bytes_sent);
 				});
 				return;
 			}
@@ -360,14 +339,10 @@ namespace asio2::detail
 				if (!s)
 					asio::detail::throw_error(asio::error::invalid_argument);
 
-				derive.push_event([&derive, p = derive.selfptr(), data = derive._data_persistence(s, count),
-					fn = std::forward<Callback>(fn)](event_queue_guard<derived_t>&& g) mutable
+				derive._send_enqueue(derive._data_persistence(s, count),
+				[fn = std::forward<Callback>(fn)](const error_code&, std::size_t bytes_sent) mutable
 				{
-					derive._do_send(data, [&fn, g = std::move(g)]
-					(const error_code&, std::size_t bytes_sent) mutable
-					{
-						callback_helper::call(fn, bytes_sent);
-					});
+					callback_helper::call(fn, bytes_sent);
 				});
 				return;
 			}
@@ -475,6 +450,32 @@ namespace asio2::detail
 		}
 
 	protected:
+		/**
+		 * @function : push a send event to the tail of the event queue, the data will be sent
+		 *             when the event is at the head of the queue.
+		 * note : the data must be persisted already.
+		 * Callback signature : void(const error_code& ec, std::size_t bytes_sent)
+		 */
+		template<class Data, class Callback>
+		inline void _send_enqueue(Data&& data, Callback&& callback)
+		{
+			derived_t& derive = static_cast<derived_t&>(*this);
+
+			derive.push_event([&derive, p = derive.selfptr(), data = std::forward<Data>(data),
+				callback = std::forward<Callback>(callback)](event_queue_guard<derived_t>&& g) mutable
+			{
+				derive._do_send(data, [&derive, &callback, g = std::move(g)]
+				(const error_code& ec, std::size_t bytes_sent) mutable
+				{
+					ASIO2_ASSERT(g.valid());
+
+					if (!ec)
+						derive.io().metrics().sent(bytes_sent);
+
+					callback(ec, bytes_sent);
+				});
+			});
+		}
 	};
 }
 
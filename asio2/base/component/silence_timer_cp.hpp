@@ -22,6 +22,8 @@
 #include <asio2/base/error.hpp>
 #include <asio2/base/log.hpp>
 
+#include <asio2/base/detail/coarse_timer.hpp>
+
 namespace asio2::detail
 {
 	template<class derived_t, class args_t = void>
@@ -32,7 +34,7 @@ namespace asio2::detail
 		 * @constructor
 		 */
 		explicit silence_timer_cp(io_t & io)
-			: silence_timer_(io.context())
+			: silence_timer_(io)
 		{
 			this->silence_timer_canceled_.clear();
 		}
@@ -88,12 +90,11 @@ namespace asio2::detail
 			// start the timer of check silence timeout
 			if (duration > std::chrono::duration<Rep, Period>::zero())
 			{
-				this->silence_timer_.expires_after(duration);
-				this->silence_timer_.async_wait(asio::bind_executor(derive.io().strand(),
+				this->silence_timer_.async_wait(duration,
 				[&derive, self_ptr = std::move(this_ptr)](const error_code & ec) mutable
 				{
 					derive._handle_silence_timer(ec, std::move(self_ptr));
-				}));
+				});
 			}
 		}
 
@@ -150,15 +151,13 @@ namespace asio2::detail
 			this->is_stop_silence_timer_called_ = true;
 		#endif
 
-			error_code ec_ignore{};
-
 			this->silence_timer_canceled_.test_and_set();
-			this->silence_timer_.cancel(ec_ignore);
+			this->silence_timer_.cancel();
 		}
 
 	protected:
 		/// timer for session silence time out
-		asio::steady_timer                          silence_timer_;
+		coarse_timer                                silence_timer_;
 
 		/// 
 		std::atomic_flag                            silence_timer_canceled_;
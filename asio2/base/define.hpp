@@ -49,6 +49,8 @@
 	template <class, class>                      KEYWORD ws_stream_cp;              \
 	template <class, class>                      KEYWORD http_recv_op;              \
 	template <class, class>                      KEYWORD http_send_op;              \
+	template <class, class>                      KEYWORD http_static_op;            \
+	template <class, class>                      KEYWORD http_pipeline_op;          \
 	template <class, class>                      KEYWORD ws_send_op;                \
 	template <class, class>                      KEYWORD rpc_call_cp;               \
 	template <class, class>                      KEYWORD rpc_recv_op;               \
@@ -23,6 +23,8 @@
 
 #include <asio2/base/log.hpp>
 
+#include <asio2/base/detail/slab_allocator.hpp>
+
 namespace asio2::detail
 {
 	//template<typename = void>
@@ -87,7 +89,7 @@ namespace asio2::detail
 	// Class to manage the memory to be used for handler-based custom allocation.
 	// It contains a single block of memory which may be returned for allocation
 	// requests. If the memory is in use when an allocation request is made, the
-	// allocator delegates allocation to the global heap.
+	// allocator delegates allocation to the slab cache of the current thread.
 	template<typename SizeN>
 	class handler_memory<SizeN, std::false_type>
 	{
@@ -116,11 +118,11 @@ namespace asio2::detail
 				__unlock_new_counter__++;
 			#endif
 
-				return ::operator new(size);
+				return slab_allocate(size);
 			}
 		}
 
-		inline void deallocate(void* pointer)
+		inline void deallocate(void* pointer, std::size_t size)
 		{
 			if (pointer == &storage_)
 			{
@@ -128,7 +130,7 @@ namespace asio2::detail
 			}
 			else
 			{
-				::operator delete(pointer);
+				slab_deallocate(pointer, size);
 			}
 		}
 
@@ -167,11 +169,11 @@ namespace asio2::detail
 				__atomic_new_counter__++;
 			#endif
 
-				return ::operator new(size);
+				return slab_allocate(size);
 			}
 		}
 
-		inline void deallocate(void* pointer)
+		inline void deallocate(void* pointer, std::size_t size)
 		{
 			if (pointer == &storage_)
 			{
@@ -179,7 +181,7 @@ namespace asio2::detail
 			}
 			else
 			{
-				::operator delete(pointer);
+				slab_deallocate(pointer, size);
 			}
 		}
 
@@ -225,9 +227,9 @@ namespace asio2::detail
 			return static_cast<T*>(memory_.allocate(sizeof(T) * n));
 		}
 
-		inline void deallocate(T* p, std::size_t /*n*/) const
+		inline void deallocate(T* p, std::size_t n) const
 		{
-			return memory_.deallocate(p);
+			return memory_.deallocate(p, sizeof(T) * n);
 		}
 
 	private:
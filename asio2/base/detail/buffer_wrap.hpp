@@ -21,6 +21,8 @@
 #include <type_traits>
 
 #include <asio2/3rd/asio.hpp>
+#include <asio2/base/detail/shared_buffer.hpp>
+#include <asio2/base/detail/pooled_buffer.hpp>
 
 namespace asio2
 {
@@ -40,6 +42,39 @@ namespace asio2
 		template<class T>
 		struct buffer_has_max_size<T, std::void_t<decltype(std::declval<T>().max_size())>> : std::true_type {};
 
+		template<class, class = std::void_t<>>
+		struct buffer_has_release : std::false_type {};
+
+		template<class T>
+		struct buffer_has_release<T, std::void_t<decltype(std::declval<T&>().release())>> : std::true_type {};
+
+		/**
+		 * The dynamic buffer which refers to a buffer, the asio::async_read and asio::async_read_until
+		 * take the ownership of the dynamic buffer which is not a asio::streambuf, so the buffer of the
+		 * session is passed by this reference.
+		 */
+		template<class Buffer>
+		class dynamic_buffer_ref
+		{
+		public:
+			using size_type            = std::size_t;
+			using const_buffers_type   = typename Buffer::const_buffers_type;
+			using mutable_buffers_type = typename Buffer::mutable_buffers_type;
+
+			explicit dynamic_buffer_ref(Buffer& b) noexcept : b_(b) {}
+
+			inline size_type size() const { return b_.size(); }
+			inline size_type max_size() const { return b_.max_size(); }
+			inline size_type capacity() const { return b_.capacity(); }
+			inline const_buffers_type data() const { return b_.data(); }
+			inline mutable_buffers_type prepare(size_type n) { return b_.prepare(n); }
+			inline void commit(size_type n) { b_.commit(n); }
+			inline void consume(size_type n) { b_.consume(n); }
+
+		protected:
+			Buffer& b_;
+		};
+
 		//template<typename T>
 		//struct buffer_has_limit
 		//{
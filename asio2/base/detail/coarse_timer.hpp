@@ -0,0 +1,140 @@
+/*
+ * COPYRIGHT (C) 2017-2021, zhllxt
+ *
+ * author   : zhllxt
+ * email    : 37792738@qq.com
+ *
+ * Distributed under the GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+ * (See accompanying file LICENSE or see <http://www.gnu.org/licenses/>)
+ */
+
+#ifndef __ASIO2_COARSE_TIMER_HPP__
+#define __ASIO2_COARSE_TIMER_HPP__
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+#pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <chrono>
+#include <memory>
+#include <functional>
+
+#include <asio2/3rd/asio.hpp>
+#include <asio2/base/iopool.hpp>
+#include <asio2/base/error.hpp>
+#include <asio2/base/detail/timer_wheel.hpp>
+
+namespace asio2::detail
+{
+	/**
+	 * A one shot timer used like the asio::steady_timer, if the timer granularity of the io is not
+	 * zero (see server/client timer_granularity function), the timer is registered to the coarse
+	 * timer wheel of the io, otherwise the asio::steady_timer is used.
+	 * The asio::steady_timer is created only when it is used, so there is only a timer entry in
+	 * the object when the coarse timer wheel is enabled.
+	 * The handler is always called in the io's strand, and it is called with operation_aborted
+	 * when the timer is canceled, just like the asio::steady_timer.
+	 * All the functions must be called in the io's strand.
+	 */
+	class coarse_timer
+	{
+	public:
+		/**
+		 * @constructor
+		 */
+		explicit coarse_timer(io_t& io) : io_(io)
+		{
+			this->entry_.callback([this]() mutable
+			{
+				// the handler maybe destroy this object, so move it to the stack first.
+				std::function<void(const error_code&)> handler = std::move(this->handler_);
+
+				handler(error_code{});
+			});
+		}
+
+		/**
+		 * @destructor
+		 */
+		~coarse_timer() = default;
+
+		coarse_timer(coarse_timer&&) = delete;
+		coarse_timer(coarse_timer const&) = delete;
+		coarse_timer& operator=(coarse_timer&&) = delete;
+		coarse_timer& operator=(coarse_timer const&) = delete;
+
+		/**
+		 * @function : start an asynchronous wait on the timer, the previous wait will be canceled.
+		 * Function signature : void(const asio::error_code& ec)
+		 */
+		template<class Rep, class Period, class WaitHandler>
+		inline void async_wait(std::chrono::duration<Rep, Period> duration, WaitHandler&& handler)
+		{
+			ASIO2_ASSERT(this->io_.strand().running_in_this_thread());
+
+			std::chrono::milliseconds granularity = this->io_.timer_granularity();
+
+			if (granularity > std::chrono::milliseconds::zero())
+			{
+				this->_cancel_entry();
+
+				this->handler_ = std::forward<WaitHandler>(handler);
+
+				this->io_.wheel(granularity).schedule(this->entry_, duration);
+			}
+			else
+			{
+				if (!this->timer_)
+					this->timer_ = std::make_unique<asio::steady_timer>(this->io_.context());
+
+				this->timer_->expires_after(duration);
+				this->timer_->async_wait(asio::bind_executor(this->io_.strand(),
+					std::forward<WaitHandler>(handler)));
+			}
+		}
+
+		/**
+		 * @function : cancel the timer, the handler will be called with operation_aborted.
+		 */
+		inline void cancel()
+		{
+			ASIO2_ASSERT(this->io_.strand().running_in_this_thread());
+
+			this->_cancel_entry();
+
+			if (this->timer_)
+			{
+				error_code ec_ignore{};
+				this->timer_->cancel(ec_ignore);
+			}
+		}
+
+	protected:
+		inline void _cancel_entry()
+		{
+			if (!this->entry_.scheduled())
+				return;
+
+			this->io_.wheel(this->io_.timer_granularity()).cancel(this->entry_);
+
+			asio::post(this->io_.strand(), [handler = std::move(this->handler_)]() mutable
+			{
+				handler(asio::error::operation_aborted);
+			});
+		}
+
+	protected:
+		io_t                                   & io_;
+
+		/// the timer entry in the coarse timer wheel of the io
+		timer_entry                              entry_;
+
+		/// the wait handler when the timer entry is scheduled
+		std::function<void(const error_code&)>   handler_;
+
+		/// the steady timer when the coarse timer wheel is disabled
+		std::unique_ptr<asio::steady_timer>      timer_;
+	};
+}
+
+#endif // !__ASIO2_COARSE_TIMER_HPP__
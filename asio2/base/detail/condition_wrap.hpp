@@ -27,6 +27,8 @@
 #include <asio2/ecs/rdc/rdc_option.hpp>
 #include <asio2/ecs/socks/socks5_option.hpp>
 
+#include <asio2/base/detail/reuse_port.hpp>
+
 namespace asio2::detail
 {
 	namespace
@@ -307,6 +309,38 @@ namespace asio2::detail
 			return std::get<socks5_index()>(components_);
 		}
 
+		template<typename = void>
+		static constexpr bool has_reuse_port()
+		{
+			return (std::is_same_v<asio2::reuse_port, Args> || ...);
+		}
+
+		template<std::size_t I, typename T1, typename... TN>
+		static constexpr std::size_t reuse_port_index_helper()
+		{
+			if constexpr (std::is_same_v<asio2::reuse_port, T1>)
+				return I;
+			else
+			{
+				if constexpr (sizeof...(TN) == 0)
+					return std::size_t(0);
+				else
+					return reuse_port_index_helper<I + 1, TN...>();
+			}
+		}
+
+		template<typename = void>
+		static constexpr std::size_t reuse_port_index()
+		{
+			return reuse_port_index_helper<0, Args...>();
+		}
+
+		template<class Tag, std::enable_if_t<std::is_same_v<Tag, std::in_place_t>, int> = 0>
+		typename components<reuse_port_index()>::type& reuse_port_option(Tag)
+		{
+			return std::get<reuse_port_index()>(components_);
+		}
+
 		condition_traits<type>           condition_;
 		tuple_type                       components_;
 	};
@@ -393,6 +427,8 @@ namespace asio2::detail
 				return true;
 			else if constexpr (std::is_base_of_v<asio2::socks5::detail::option_base, type>)
 				return true;
+			else if constexpr (std::is_same_v<asio2::reuse_port, type>)
+				return true;
 			else
 				return false;
 		}
@@ -454,6 +490,19 @@ namespace asio2::detail
 				return false;
 			}
 		}
+
+		template<typename MatchCondition>
+		static constexpr bool has_reuse_port()
+		{
+			if constexpr (is_template_instance_of_v<ecs_t, MatchCondition>)
+			{
+				return MatchCondition::has_reuse_port();
+			}
+			else
+			{
+				return false;
+			}
+		}
 	};
 }
 
@@ -18,9 +18,13 @@
 #include <limits>
 #include <memory>
 #include <vector>
+#include <cstring>
+#include <algorithm>
 
 #include <asio2/3rd/asio.hpp>
 
+#include <asio2/base/detail/slab_allocator.hpp>
+
 namespace asio2
 {
 	template<class Container>
@@ -87,8 +91,8 @@ namespace asio2
 			size_type const cap = Container::capacity();
 			if (n <= cap - wpos_)
 			{
-				Container::resize(wpos_ + n);
 				// existing capacity is sufficient
+				this->_grow(wpos_ + n);
 				return{ Container::data() + wpos_, n };
 			}
 			size_type const size = this->size();
@@ -100,18 +104,19 @@ namespace asio2
 					std::memmove(Container::data(), Container::data() + rpos_, size);
 				rpos_ = 0;
 				wpos_ = size;
-				Container::resize(wpos_ + n);
+				this->_grow(wpos_ + n);
 				return { Container::data() + wpos_, n };
 			}
 			// enforce maximum capacity
 			if (n > max_ - size)
 				asio::detail::throw_exception(std::length_error{ "basic_linear_buffer overflow" });
-			// allocate a new buffer
+			// allocate a new buffer, the bytes after the input sequence are not copied.
 			size_type const new_size = (std::max<size_type>)((std::min<size_type>)(
 				max_,
 				(std::max<size_type>)(2 * cap, wpos_ + n)), min_size);
-			Container::resize(new_size);
-			Container::resize(wpos_ + n);
+			Container::resize(wpos_);
+			Container::reserve(new_size);
+			this->_grow(wpos_ + n);
 			return { Container::data() + wpos_, n };
 		}
 
@@ -143,7 +148,6 @@ namespace asio2
 			{
 				wpos_ = 0;
 				rpos_ = 0;
-				Container::resize(0);
 				return;
 			}
 			rpos_ += n;
@@ -151,9 +155,40 @@ namespace asio2
 
 		inline void shrink_to_fit()
 		{
+			Container::resize(wpos_);
 			Container::shrink_to_fit();
 		}
 
+		/// Make sure the next `n` bytes can be prepared without an allocation.
+		inline void reserve(size_type n)
+		{
+			if (n > Container::capacity() - this->size())
+				this->prepare(n);
+		}
+
+		/// Free the storage if the input sequence is empty, return false if it is not empty.
+		inline bool release()
+		{
+			if (wpos_ != rpos_)
+				return false;
+
+			wpos_ = 0;
+			rpos_ = 0;
+
+			Container().swap(static_cast<Container&>(*this));
+
+			return true;
+		}
+
+	protected:
+		/// The size of the container is only grown, it is the high water mark of the prepared
+		/// bytes, so the bytes are not initialized again by each prepare after a consume.
+		inline void _grow(size_type n)
+		{
+			if (Container::size() < n)
+				Container::resize(n);
+		}
+
 	protected:
 		size_type rpos_ = 0;
 		size_type wpos_ = 0;
@@ -163,6 +198,38 @@ namespace asio2
 	};
 
 	using linear_buffer = basic_linear_buffer<std::vector<char>>;
+
+	/**
+	 * The linear buffer whose buffer sequence types are the same as the asio::streambuf, so the
+	 * match condition of the asio::async_read_until is the same as the asio::streambuf, it is used
+	 * as the recv buffer of the tcp session and tcp client, the storage is allocated from the slab
+	 * cache and can be released when the session is idle.
+	 */
+	template<class Container>
+	class basic_stream_buffer : public basic_linear_buffer<Container>
+	{
+	public:
+		using super = basic_linear_buffer<Container>;
+
+		using size_type = typename super::size_type;
+
+		using const_buffers_type   = typename asio::streambuf::const_buffers_type;
+		using mutable_buffers_type = typename asio::streambuf::mutable_buffers_type;
+
+		using super::super;
+
+		inline const_buffers_type data() const
+		{
+			return const_buffers_type(super::data());
+		}
+
+		inline mutable_buffers_type prepare(size_type n)
+		{
+			return mutable_buffers_type(super::prepare(n));
+		}
+	};
+
+	using stream_buffer = basic_stream_buffer<std::vector<char, detail::slab_allocator<char>>>;
 }
 
 #endif // !__ASIO2_LINEAR_BUFFER_HPP__
@@ -0,0 +1,456 @@
+/*
+ * COPYRIGHT (C) 2017-2021, zhllxt
+ *
+ * author   : zhllxt
+ * email    : 37792738@qq.com
+ *
+ * Distributed under the GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+ * (See accompanying file LICENSE or see <http://www.gnu.org/licenses/>)
+ */
+
+#ifndef __ASIO2_METRICS_HPP__
+#define __ASIO2_METRICS_HPP__
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+#pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <array>
+#include <limits>
+#include <utility>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <string_view>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace asio2::detail
+{
+	/**
+	 * The metrics are kept by each io_t (each io_context of a server or a client), the counters
+	 * and the histograms are written in the io strand only, so they are single writer, and they
+	 * are updated by a relaxed load and store without any lock or atomic read-modify-write. The
+	 * gauges may be changed by the other threads, they use the atomic add. All of the metrics of
+	 * a server or a client are merged when they are read, see iopool_cp::metrics().
+	 * Define ASIO2_DISABLE_METRICS to make all of the recording functions do nothing.
+	 */
+	class metrics_counter
+	{
+	public:
+		inline void add(std::uint64_t n = 1) noexcept
+		{
+		#if !defined(ASIO2_DISABLE_METRICS)
+			this->value_.store(this->value_.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+		#else
+			(void)n;
+		#endif
+		}
+
+		inline std::uint64_t value() const noexcept
+		{
+			return this->value_.load(std::memory_order_relaxed);
+		}
+
+	protected:
+		std::atomic<std::uint64_t> value_{ 0 };
+	};
+
+	class metrics_gauge
+	{
+	public:
+		inline void add(std::int64_t n = 1) noexcept
+		{
+		#if !defined(ASIO2_DISABLE_METRICS)
+			std::int64_t v = this->value_.fetch_add(n, std::memory_order_relaxed) + n;
+			std::int64_t m = this->peak_ .load(std::memory_order_relaxed);
+			while (v > m && !this->peak_.compare_exchange_weak(m, v, std::memory_order_relaxed));
+		#else
+			(void)n;
+		#endif
+		}
+
+		inline void sub(std::int64_t n = 1) noexcept
+		{
+		#if !defined(ASIO2_DISABLE_METRICS)
+			this->value_.fetch_sub(n, std::memory_order_relaxed);
+		#else
+			(void)n;
+		#endif
+		}
+
+		inline std::int64_t value() const noexcept { return this->value_.load(std::memory_order_relaxed); }
+
+		/// the high water mark of the value
+		inline std::int64_t peak () const noexcept { return this->peak_ .load(std::memory_order_relaxed); }
+
+	protected:
+		std::atomic<std::int64_t> value_{ 0 };
+		std::atomic<std::int64_t> peak_ { 0 };
+	};
+
+	/**
+	 * A log linear histogram like the HdrHistogram, each power of two range is divided into 8
+	 * linear sub buckets, so the relative error of a recorded value is 12.5% at most, and all of
+	 * the uint64 values are covered by 496 buckets, the recording is a few bit operations.
+	 */
+	class metrics_histogram
+	{
+	public:
+		static constexpr std::size_t sub_bits     = 3;
+		static constexpr std::size_t sub_buckets  = std::size_t(1) << sub_bits;
+		static constexpr std::size_t bucket_count = (64 - sub_bits + 1) * sub_buckets;
+
+		struct snapshot
+		{
+			std::array<std::uint64_t, bucket_count> buckets{};
+
+			std::uint64_t count = 0;
+			std::uint64_t sum   = 0;
+			std::uint64_t max   = 0;
+
+			inline snapshot& operator+=(const snapshot& other) noexcept
+			{
+				for (std::size_t i = 0; i < bucket_count; ++i)
+					this->buckets[i] += other.buckets[i];
+
+				this->count += other.count;
+				this->sum   += other.sum;
+				this->max    = (std::max)(this->max, other.max);
+
+				return (*this);
+			}
+
+			inline double mean() const noexcept
+			{
+				return this->count ? double(this->sum) / double(this->count) : 0.0;
+			}
+
+			/**
+			 * @function : get the value at the percentile, eg : percentile(99.9), the returned
+			 * value is the upper bound of the bucket which the percentile falls into.
+			 */
+			inline std::uint64_t percentile(double p) const noexcept
+			{
+				if (this->count == 0)
+					return 0;
+
+				std::uint64_t rank = static_cast<std::uint64_t>(double(this->count) * p / 100.0 + 0.5);
+
+				rank = (std::max)(rank, std::uint64_t(1));
+
+				std::uint64_t n = 0;
+
+				for (std::size_t i = 0; i < bucket_count; ++i)
+				{
+					n += this->buckets[i];
+
+					if (n >= rank)
+						return (std::min)(metrics_histogram::upper(i), this->max);
+				}
+
+				return this->max;
+			}
+
+			/**
+			 * @function : get the count of the recorded values which are less than or equal to v,
+			 * the boundary is rounded to the bucket which v falls into.
+			 */
+			inline std::uint64_t count_le(std::uint64_t v) const noexcept
+			{
+				std::uint64_t n = 0;
+
+				for (std::size_t i = 0, last = metrics_histogram::index(v); i <= last; ++i)
+					n += this->buckets[i];
+
+				return n;
+			}
+		};
+
+		inline void record(std::uint64_t v) noexcept
+		{
+		#if !defined(ASIO2_DISABLE_METRICS)
+			_increase(this->buckets_[index(v)], 1);
+			_increase(this->count_, 1);
+			_increase(this->sum_  , v);
+
+			if (v > this->max_.load(std::memory_order_relaxed))
+				this->max_.store(v, std::memory_order_relaxed);
+		#else
+			(void)v;
+		#endif
+		}
+
+		inline void collect(snapshot& s) const noexcept
+		{
+			snapshot t;
+
+			for (std::size_t i = 0; i < bucket_count; ++i)
+				t.buckets[i] = this->buckets_[i].load(std::memory_order_relaxed);
+
+			t.count = this->count_.load(std::memory_order_relaxed);
+			t.sum   = this->sum_  .load(std::memory_order_relaxed);
+			t.max   = this->max_  .load(std::memory_order_relaxed);
+
+			s += t;
+		}
+
+		static inline std::size_t index(std::uint64_t v) noexcept
+		{
+			if (v < sub_buckets)
+				return static_cast<std::size_t>(v);
+
+			std::size_t msb = _msb(v);
+
+			return (msb - sub_bits + 1) * sub_buckets + static_cast<std::size_t>((v >> (msb - sub_bits)) & (sub_buckets - 1));
+		}
+
+		static inline std::uint64_t lower(std::size_t i) noexcept
+		{
+			if (i < sub_buckets)
+				return static_cast<std::uint64_t>(i);
+
+			return (std::uint64_t(sub_buckets) + (i % sub_buckets)) << (i / sub_buckets - 1);
+		}
+
+		static inline std::uint64_t upper(std::size_t i) noexcept
+		{
+			return (i + 1 < bucket_count) ? lower(i + 1) - 1 : (std::numeric_limits<std::uint64_t>::max)();
+		}
+
+	protected:
+		static inline std::size_t _msb(std::uint64_t v) noexcept
+		{
+		#if defined(__GNUC__) || defined(__clang__)
+			return static_cast<std::size_t>(63 - __builtin_clzll(v));
+		#elif defined(_MSC_VER) && defined(_M_X64)
+			unsigned long r;
+			_BitScanReverse64(&r, v);
+			return static_cast<std::size_t>(r);
+		#else
+			std::size_t r = 0;
+			while (v >>= 1)
+				++r;
+			return r;
+		#endif
+		}
+
+		static inline void _increase(std::atomic<std::uint64_t>& v, std::uint64_t n) noexcept
+		{
+			v.store(v.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+		}
+
+	protected:
+		std::array<std::atomic<std::uint64_t>, bucket_count> buckets_{};
+
+		std::atomic<std::uint64_t> count_{ 0 };
+		std::atomic<std::uint64_t> sum_  { 0 };
+		std::atomic<std::uint64_t> max_  { 0 };
+	};
+
+	/**
+	 * The merged metrics of a server or a client, see iopool_cp::metrics().
+	 * The rate (eg : the accept rate) is the difference of two snapshots divided by the
+	 * difference of the time of them.
+	 */
+	struct metrics_snapshot
+	{
+		std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now();
+
+		std::uint64_t bytes_in         = 0;
+		std::uint64_t bytes_out        = 0;
+		std::uint64_t messages_in      = 0;
+		std::uint64_t messages_out     = 0;
+		std::uint64_t accepts          = 0;
+		std::uint64_t kcp_retransmits  = 0;
+		std::uint64_t udp_truncated    = 0;
+
+		std::int64_t  send_queue_depth = 0;
+		std::int64_t  send_queue_peak  = 0;
+		std::int64_t  rpc_in_flight    = 0;
+		std::int64_t  rpc_in_flight_peak = 0;
+
+		/// the time of the recv handlers, in nanoseconds
+		metrics_histogram::snapshot handler_latency;
+
+		/// the count of the subscribers which a mqtt publish message is sent to
+		metrics_histogram::snapshot mqtt_fanout;
+
+		/**
+		 * @function : format the metrics in the prometheus text exposition format, the
+		 * histograms are exported with the fixed "le" buckets.
+		 */
+		inline std::string to_prometheus(std::string_view prefix = "asio2") const
+		{
+			std::string s;
+
+			s.reserve(4096);
+
+			auto counter = [&s, prefix](const char* name, const char* help, std::uint64_t v)
+			{
+				_append(s, "# HELP ", prefix, name, " ", help, "\n");
+				_append(s, "# TYPE ", prefix, name, " counter\n");
+				_append(s, prefix, name, " ", std::to_string(v), "\n");
+			};
+
+			auto gauge = [&s, prefix](const char* name, const char* help, std::int64_t v)
+			{
+				_append(s, "# HELP ", prefix, name, " ", help, "\n");
+				_append(s, "# TYPE ", prefix, name, " gauge\n");
+				_append(s, prefix, name, " ", std::to_string(v), "\n");
+			};
+
+			counter("_bytes_in_total"       , "Bytes recved."                   , this->bytes_in       );
+			counter("_bytes_out_total"      , "Bytes sent."                     , this->bytes_out      );
+			counter("_messages_in_total"    , "Messages recved."                , this->messages_in    );
+			counter("_messages_out_total"   , "Messages sent."                  , this->messages_out   );
+			counter("_accepts_total"        , "Connections accepted."           , this->accepts        );
+			counter("_kcp_retransmits_total", "Kcp segments retransmitted."     , this->kcp_retransmits);
+			counter("_udp_truncated_total"  , "Truncated udp datagrams dropped.", this->udp_truncated  );
+
+			gauge("_send_queue_depth"       , "Events in the send queues."      , this->send_queue_depth  );
+			gauge("_send_queue_depth_peak"  , "Peak events in the send queues." , this->send_queue_peak   );
+			gauge("_rpc_in_flight"          , "Rpc calls waiting for response." , this->rpc_in_flight     );
+			gauge("_rpc_in_flight_peak"     , "Peak rpc calls in flight."       , this->rpc_in_flight_peak);
+
+			// 1us, 2.5us, 5us ... 1s, the histogram is recorded in nanoseconds
+			static constexpr std::uint64_t latency_bounds[] = {
+				1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000, 500000,
+				1000000, 2500000, 5000000, 10000000, 25000000, 50000000, 100000000,
+				250000000, 500000000, 1000000000 };
+
+			_histogram(s, prefix, "_handler_latency_seconds", "Time of the recv handlers.",
+				this->handler_latency, latency_bounds, 1e-9);
+
+			static constexpr std::uint64_t fanout_bounds[] = {
+				1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024, 4096, 16384, 65536 };
+
+			_histogram(s, prefix, "_mqtt_fanout", "Subscribers a publish message is sent to.",
+				this->mqtt_fanout, fanout_bounds, 1.0);
+
+			return s;
+		}
+
+	protected:
+		template<class... Args>
+		static inline void _append(std::string& s, Args&&... args)
+		{
+			(s.append(std::forward<Args>(args)), ...);
+		}
+
+		template<std::size_t N>
+		static inline void _histogram(std::string& s, std::string_view prefix, const char* name,
+			const char* help, const metrics_histogram::snapshot& h, const std::uint64_t(&bounds)[N], double scale)
+		{
+			char buf[64];
+
+			_append(s, "# HELP ", prefix, name, " ", help, "\n");
+			_append(s, "# TYPE ", prefix, name, " histogram\n");
+
+			for (std::uint64_t bound : bounds)
+			{
+				std::snprintf(buf, sizeof(buf), "%g", double(bound) * scale);
+				_append(s, prefix, name, "_bucket{le=\"", buf, "\"} ", std::to_string(h.count_le(bound)), "\n");
+			}
+
+			_append(s, prefix, name, "_bucket{le=\"+Inf\"} ", std::to_string(h.count), "\n");
+
+			std::snprintf(buf, sizeof(buf), "%.9g", double(h.sum) * scale);
+			_append(s, prefix, name, "_sum ", buf, "\n");
+			_append(s, prefix, name, "_count ", std::to_string(h.count), "\n");
+		}
+	};
+
+	/**
+	 * The metrics of an io_t.
+	 */
+	struct io_metrics
+	{
+		metrics_counter   bytes_in;
+		metrics_counter   bytes_out;
+		metrics_counter   messages_in;
+		metrics_counter   messages_out;
+		metrics_counter   accepts;
+		metrics_counter   kcp_retransmits;
+		metrics_counter   udp_truncated;
+
+		metrics_gauge     send_queue_depth;
+		metrics_gauge     rpc_in_flight;
+
+		metrics_histogram handler_latency;
+		metrics_histogram mqtt_fanout;
+
+		/// count a message which is sent successfully
+		inline void sent(std::size_t bytes) noexcept
+		{
+			this->messages_out.add(1);
+			this->bytes_out   .add(bytes);
+		}
+
+		inline void collect(metrics_snapshot& s) const noexcept
+		{
+			s.bytes_in           += this->bytes_in       .value();
+			s.bytes_out          += this->bytes_out      .value();
+			s.messages_in        += this->messages_in    .value();
+			s.messages_out       += this->messages_out   .value();
+			s.accepts            += this->accepts        .value();
+			s.kcp_retransmits    += this->kcp_retransmits.value();
+			s.udp_truncated      += this->udp_truncated  .value();
+
+			s.send_queue_depth   += this->send_queue_depth.value();
+			s.send_queue_peak    += this->send_queue_depth.peak ();
+			s.rpc_in_flight      += this->rpc_in_flight   .value();
+			s.rpc_in_flight_peak += this->rpc_in_flight   .peak ();
+
+			this->handler_latency.collect(s.handler_latency);
+			this->mqtt_fanout    .collect(s.mqtt_fanout    );
+		}
+	};
+
+	/**
+	 * Count a recved message and record the time of the recv handler, used in the _fire_recv
+	 * of the sessions and the clients : metrics_recv_scope ms(derive.io().metrics(), data.size());
+	 */
+	class metrics_recv_scope
+	{
+	public:
+		metrics_recv_scope(const metrics_recv_scope&) = delete;
+		metrics_recv_scope& operator=(const metrics_recv_scope&) = delete;
+
+	#if !defined(ASIO2_DISABLE_METRICS)
+		metrics_recv_scope(io_metrics& m, std::size_t bytes) noexcept
+			: metrics_(m), begin_(std::chrono::steady_clock::now())
+		{
+			m.messages_in.add(1);
+			m.bytes_in   .add(bytes);
+		}
+
+		~metrics_recv_scope() noexcept
+		{
+			this->metrics_.handler_latency.record(static_cast<std::uint64_t>(
+				std::chrono::duration_cast<std::chrono::nanoseconds>(
+					std::chrono::steady_clock::now() - this->begin_).count()));
+		}
+
+	protected:
+		io_metrics                          & metrics_;
+		std::chrono::steady_clock::time_point begin_;
+	#else
+		metrics_recv_scope(io_metrics&, std::size_t) noexcept {}
+	#endif
+	};
+}
+
+namespace asio2
+{
+	using metrics_snapshot  = detail::metrics_snapshot;
+	using metrics_histogram = detail::metrics_histogram;
+}
+
+#endif // !__ASIO2_METRICS_HPP__
@@ -0,0 +1,150 @@
+/*
+ * COPYRIGHT (C) 2017-2021, zhllxt
+ *
+ * author   : zhllxt
+ * email    : 37792738@qq.com
+ *
+ * Distributed under the GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+ * (See accompanying file LICENSE or see <http://www.gnu.org/licenses/>)
+ *
+ * Dmitry Vyukov's intrusive multi producer single consumer queue
+ * http://www.1024cores.net/home/lock-free-algorithms/queues/intrusive-mpsc-node-based-queue
+ */
+
+#ifndef __ASIO2_MPSC_QUEUE_HPP__
+#define __ASIO2_MPSC_QUEUE_HPP__
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+#pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <atomic>
+#include <utility>
+
+#include <asio2/base/detail/slab_allocator.hpp>
+
+namespace asio2::detail
+{
+	/**
+	 * A lock free unbounded queue, many threads can push at the same time, but only one thread
+	 * can pop at the same time. The push operation is wait free (one atomic exchange), the pop
+	 * operation maybe return false when a push is in progress even if the queue is not empty,
+	 * in this case the pushing thread will finish the push soon, so the consumer should be
+	 * notified by the producer after the push, and try it again.
+	 */
+	template<class T>
+	class mpsc_queue
+	{
+	protected:
+		struct node
+		{
+			node() = default;
+
+			template<class... Args>
+			explicit node(std::in_place_t, Args&&... args) : value(std::forward<Args>(args)...) {}
+
+			// the nodes are pushed by any thread and freed by the consumer thread, the slab cache
+			// of the consumer thread recycles them.
+			static inline void* operator new(std::size_t size) { return slab_allocate(size); }
+
+			static inline void operator delete(void* p, std::size_t size) noexcept { slab_deallocate(p, size); }
+
+			std::atomic<node*> next{ nullptr };
+
+			T                  value{};
+		};
+
+	public:
+		/**
+		 * @constructor
+		 */
+		mpsc_queue() : head_(&stub_), tail_(&stub_) {}
+
+		/**
+		 * @destructor
+		 */
+		~mpsc_queue()
+		{
+			T value;
+			while (this->pop(value)) {}
+		}
+
+		mpsc_queue(mpsc_queue&&) = delete;
+		mpsc_queue(mpsc_queue const&) = delete;
+		mpsc_queue& operator=(mpsc_queue&&) = delete;
+		mpsc_queue& operator=(mpsc_queue const&) = delete;
+
+		/**
+		 * @function : push an element to the tail of the queue, it's multi thread safed.
+		 */
+		template<class... Args>
+		inline void push(Args&&... args)
+		{
+			this->_push(new node(std::in_place, std::forward<Args>(args)...));
+		}
+
+		/**
+		 * @function : pop an element from the head of the queue, it can be called in only one
+		 * thread at the same time.
+		 * @return   : false if the queue is empty or the next element is being pushed.
+		 */
+		inline bool pop(T& value)
+		{
+			node* tail = this->tail_;
+			node* next = tail->next.load(std::memory_order_acquire);
+
+			if (tail == &(this->stub_))
+			{
+				if (next == nullptr)
+					return false;
+
+				this->tail_ = next;
+				tail = next;
+				next = next->next.load(std::memory_order_acquire);
+			}
+
+			if (next == nullptr)
+			{
+				// some producer has exchanged the head, but has't linked the node yet.
+				if (tail != this->head_.load(std::memory_order_acquire))
+					return false;
+
+				this->_push(&(this->stub_));
+
+				next = tail->next.load(std::memory_order_acquire);
+
+				if (next == nullptr)
+					return false;
+			}
+
+			this->tail_ = next;
+
+			value = std::move(tail->value);
+
+			delete tail;
+
+			return true;
+		}
+
+	protected:
+		inline void _push(node* n)
+		{
+			n->next.store(nullptr, std::memory_order_relaxed);
+
+			node* prev = this->head_.exchange(n, std::memory_order_acq_rel);
+
+			prev->next.store(n, std::memory_order_release);
+		}
+
+	protected:
+		node                 stub_;
+
+		/// the producers push the element at the head
+		std::atomic<node*>   head_;
+
+		/// the consumer pop the element at the tail
+		node               * tail_;
+	};
+}
+
+#endif // !__ASIO2_MPSC_QUEUE_HPP__
@@ -0,0 +1,211 @@
+/*
+ * COPYRIGHT (C) 2017-2021, zhllxt
+ *
+ * author   : zhllxt
+ * email    : 37792738@qq.com
+ *
+ * Distributed under the GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+ * (See accompanying file LICENSE or see <http://www.gnu.org/licenses/>)
+ */
+
+#ifndef __ASIO2_POOLED_BUFFER_HPP__
+#define __ASIO2_POOLED_BUFFER_HPP__
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+#pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <cstddef>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <asio2/3rd/asio.hpp>
+#include <asio2/base/error.hpp>
+
+namespace asio2::detail
+{
+	/**
+	 * A pool of the reusable string buffers, the buffers which are released into the pool keep
+	 * their capacity, so the next acquired buffer don't need to allocate memory again.
+	 * The pool is multi thread safed, because the buffer maybe released in any thread.
+	 */
+	class buffer_pool
+	{
+	public:
+		/**
+		 * @constructor
+		 * @param    : max_count - the max count of the buffers which are kept in the pool
+		 * @param    : max_capacity - the buffer whose capacity is greater than it will be freed
+		 *             directly, instead of being kept in the pool.
+		 */
+		explicit buffer_pool(std::size_t max_count = 16, std::size_t max_capacity = 64 * 1024)
+			: max_count_(max_count), max_capacity_(max_capacity)
+		{
+		}
+
+		/**
+		 * @destructor
+		 */
+		~buffer_pool() = default;
+
+		buffer_pool(buffer_pool&&) = delete;
+		buffer_pool(buffer_pool const&) = delete;
+		buffer_pool& operator=(buffer_pool&&) = delete;
+		buffer_pool& operator=(buffer_pool const&) = delete;
+
+		/**
+		 * @function : get an empty buffer from the pool, or a new buffer if the pool is empty.
+		 */
+		inline std::string acquire()
+		{
+			std::lock_guard<std::mutex> guard(this->mutex_);
+
+			if (this->buffers_.empty())
+				return std::string{};
+
+			std::string s = std::move(this->buffers_.back());
+			this->buffers_.pop_back();
+			return s;
+		}
+
+		/**
+		 * @function : put the buffer back into the pool.
+		 */
+		inline void release(std::string&& s)
+		{
+			if (s.capacity() > this->max_capacity_)
+				return;
+
+			s.clear();
+
+			std::lock_guard<std::mutex> guard(this->mutex_);
+
+			if (this->buffers_.size() < this->max_count_)
+				this->buffers_.emplace_back(std::move(s));
+		}
+
+		/**
+		 * @function : get the count of the buffers in the pool.
+		 */
+		inline std::size_t size()
+		{
+			std::lock_guard<std::mutex> guard(this->mutex_);
+
+			return this->buffers_.size();
+		}
+
+	protected:
+		std::mutex               mutex_;
+
+		std::vector<std::string> buffers_;
+
+		std::size_t              max_count_;
+
+		std::size_t              max_capacity_;
+	};
+
+	/**
+	 * A move only buffer which is acquired from the buffer_pool, it is put back into the pool
+	 * when it is destroyed, eg : when the async_send is completed.
+	 */
+	class pooled_buffer
+	{
+	public:
+		using value_type = char;
+
+		/**
+		 * @constructor
+		 */
+		pooled_buffer() = default;
+
+		/**
+		 * @constructor
+		 */
+		pooled_buffer(std::shared_ptr<buffer_pool> pool, std::string&& s)
+			: pool_(std::move(pool)), data_(std::move(s))
+		{
+		}
+
+		pooled_buffer(pooled_buffer&& o) noexcept
+			: pool_(std::move(o.pool_)), data_(std::move(o.data_))
+		{
+		}
+
+		pooled_buffer& operator=(pooled_buffer&& o) noexcept
+		{
+			if (this != std::addressof(o))
+			{
+				this->_release();
+				this->pool_ = std::move(o.pool_);
+				this->data_ = std::move(o.data_);
+			}
+			return (*this);
+		}
+
+		// the events are move only, so the buffer is never copied, the copy would release the
+		// same string into the pool twice.
+		pooled_buffer(const pooled_buffer&) = delete;
+		pooled_buffer& operator=(const pooled_buffer&) = delete;
+
+		/**
+		 * @destructor
+		 */
+		~pooled_buffer()
+		{
+			this->_release();
+		}
+
+		inline const char* data() const noexcept { return this->data_.data(); }
+
+		inline std::size_t size() const noexcept { return this->data_.size(); }
+
+		inline bool empty() const noexcept { return this->data_.empty(); }
+
+		inline const std::string& str() const noexcept { return this->data_; }
+
+		inline operator std::string_view() const noexcept
+		{
+			return std::string_view(this->data_.data(), this->data_.size());
+		}
+
+	protected:
+		inline void _release()
+		{
+			if (this->pool_)
+			{
+				this->pool_->release(std::move(this->data_));
+				this->pool_.reset();
+			}
+		}
+
+	protected:
+		std::shared_ptr<buffer_pool> pool_;
+
+		std::string                  data_;
+	};
+}
+
+namespace asio
+{
+	/*
+	 * make the pooled_buffer can be used by asio::buffer(...) directly, then all the send
+	 * operations which call asio::buffer(data) can send the pooled_buffer without copying.
+	 */
+
+	inline ASIO_CONST_BUFFER buffer(const ::asio2::detail::pooled_buffer& data) ASIO_NOEXCEPT
+	{
+		return ASIO_CONST_BUFFER(data.data(), data.size());
+	}
+
+	inline ASIO_CONST_BUFFER buffer(const ::asio2::detail::pooled_buffer& data,
+		std::size_t max_size_in_bytes) ASIO_NOEXCEPT
+	{
+		return ASIO_CONST_BUFFER(data.data(), (std::min)(data.size(), max_size_in_bytes));
+	}
+}
+
+#endif // !__ASIO2_POOLED_BUFFER_HPP__
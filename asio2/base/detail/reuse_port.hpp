@@ -0,0 +1,96 @@
+/*
+ * COPYRIGHT (C) 2017-2021, zhllxt
+ *
+ * author   : zhllxt
+ * email    : 37792738@qq.com
+ *
+ * Distributed under the GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+ * (See accompanying file LICENSE or see <http://www.gnu.org/licenses/>)
+ */
+
+#ifndef __ASIO2_REUSE_PORT_HPP__
+#define __ASIO2_REUSE_PORT_HPP__
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+#pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <cstddef>
+#include <algorithm>
+
+#include <asio2/3rd/asio.hpp>
+
+namespace asio2::detail
+{
+#if defined(SO_REUSEPORT)
+	/// the SO_REUSEPORT socket option, many sockets can be bound to the same address and port,
+	/// the kernel will distribute the incoming connections(datagrams) between these sockets.
+	using reuse_port_option = asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>;
+
+	static constexpr bool reuse_port_supported = true;
+#else
+	static constexpr bool reuse_port_supported = false;
+#endif
+
+	/**
+	 * @function : set the SO_REUSEPORT option for the socket, do nothing if the platform
+	 * don't support SO_REUSEPORT.
+	 */
+	template<class Socket>
+	inline void set_reuse_port(Socket& socket)
+	{
+	#if defined(SO_REUSEPORT)
+		socket.set_option(reuse_port_option(true));
+	#else
+		(void)socket;
+	#endif
+	}
+}
+
+namespace asio2
+{
+	/**
+	 * The start option of the server, open N listening sockets with the SO_REUSEPORT option
+	 * and bind them to the same address and port, each socket is owned by a different
+	 * io_context of the iopool, then the kernel distribute the new connections between them,
+	 * and the accept operations can be executed in multi threads, eg :
+	 * server.start("0.0.0.0", 8080, asio2::reuse_port(4));
+	 * If the count is 0, the count will be equal to the iopool's size, if the count is greater
+	 * than the iopool's size, it will be reduced to the iopool's size.
+	 * If the platform don't support SO_REUSEPORT (like windows), only one listening socket
+	 * will be opened.
+	 */
+	class reuse_port
+	{
+	public:
+		explicit reuse_port(std::size_t count = 0) noexcept : count_(count) {}
+
+		reuse_port(reuse_port&&) noexcept = default;
+		reuse_port(reuse_port const&) noexcept = default;
+		reuse_port& operator=(reuse_port&&) noexcept = default;
+		reuse_port& operator=(reuse_port const&) noexcept = default;
+
+		/**
+		 * @function : get the listening socket count
+		 */
+		inline std::size_t count() const noexcept { return this->count_; }
+
+		/**
+		 * @function : get the real listening socket count for the iopool's size
+		 */
+		inline std::size_t count(std::size_t iopool_size) const noexcept
+		{
+			if constexpr (!detail::reuse_port_supported)
+				return std::size_t(1);
+
+			std::size_t n = (this->count_ == 0 ? iopool_size : (std::min)(this->count_, iopool_size));
+
+			return (n == 0 ? std::size_t(1) : n);
+		}
+
+	protected:
+		std::size_t count_ = 0;
+	};
+}
+
+#endif // !__ASIO2_REUSE_PORT_HPP__
@@ -0,0 +1,178 @@
+/*
+ * COPYRIGHT (C) 2017-2021, zhllxt
+ *
+ * author   : zhllxt
+ * email    : 37792738@qq.com
+ *
+ * Distributed under the GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+ * (See accompanying file LICENSE or see <http://www.gnu.org/licenses/>)
+ */
+
+#ifndef __ASIO2_SHARED_BUFFER_HPP__
+#define __ASIO2_SHARED_BUFFER_HPP__
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+#pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <cstddef>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <asio2/3rd/asio.hpp>
+
+namespace asio2::detail
+{
+	/**
+	 * A reference counted immutable buffer, copy it only increase the reference count.
+	 * It's used to send the same message to many sessions without copying the message
+	 * for each session, eg :
+	 * asio2::shared_buffer msg(std::move(str));
+	 * server.foreach_session([&msg](auto& session_ptr) { session_ptr->async_send(msg); });
+	 */
+	class shared_buffer
+	{
+	public:
+		using value_type = char;
+
+		/**
+		 * @constructor
+		 */
+		shared_buffer() = default;
+
+		/**
+		 * @constructor : take the ownership of the string, no copy.
+		 */
+		explicit shared_buffer(std::string&& s)
+			: data_(std::make_shared<const std::string>(std::move(s)))
+		{
+		}
+
+		/**
+		 * @constructor : copy the data once.
+		 */
+		explicit shared_buffer(const std::string& s)
+			: data_(std::make_shared<const std::string>(s))
+		{
+		}
+
+		/**
+		 * @constructor : copy the data once.
+		 */
+		explicit shared_buffer(std::string_view s)
+			: data_(std::make_shared<const std::string>(s.data(), s.size()))
+		{
+		}
+
+		/**
+		 * @constructor : copy the data once.
+		 */
+		explicit shared_buffer(const char* s)
+			: data_(std::make_shared<const std::string>(s ? s : ""))
+		{
+		}
+
+		/**
+		 * @constructor : copy the data once.
+		 */
+		explicit shared_buffer(const void* data, std::size_t size)
+			: data_(std::make_shared<const std::string>(static_cast<const char*>(data), size))
+		{
+		}
+
+		/**
+		 * @constructor : copy the data once, support all the types which asio::buffer supported,
+		 *                like : std::vector<PodType>, std::array<PodType, N>, PodType(&)[N]
+		 */
+		template<class T, std::enable_if_t<
+			!std::is_same_v<std::remove_cv_t<std::remove_reference_t<T>>, shared_buffer> &&
+			!std::is_same_v<std::remove_cv_t<std::remove_reference_t<T>>, std::string> &&
+			!std::is_convertible_v<T, std::string_view>, int> = 0>
+		explicit shared_buffer(const T& data)
+		{
+			asio::const_buffer buffer = asio::buffer(data);
+			this->data_ = std::make_shared<const std::string>(
+				static_cast<const char*>(buffer.data()), buffer.size());
+		}
+
+		shared_buffer(const shared_buffer&) = default;
+		shared_buffer(shared_buffer&&) noexcept = default;
+		shared_buffer& operator=(const shared_buffer&) = default;
+		shared_buffer& operator=(shared_buffer&&) noexcept = default;
+
+		/**
+		 * @destructor
+		 */
+		~shared_buffer() = default;
+
+		inline const char* data() const noexcept
+		{
+			return (this->data_ ? this->data_->data() : nullptr);
+		}
+
+		inline std::size_t size() const noexcept
+		{
+			return (this->data_ ? this->data_->size() : 0);
+		}
+
+		inline bool empty() const noexcept
+		{
+			return (this->size() == 0);
+		}
+
+		/**
+		 * @function : get the count of the objects which shared the same data.
+		 */
+		inline long use_count() const noexcept
+		{
+			return this->data_.use_count();
+		}
+
+		inline operator std::string_view() const noexcept
+		{
+			return std::string_view(this->data(), this->size());
+		}
+
+	protected:
+		std::shared_ptr<const std::string> data_;
+	};
+
+	template<class, class = void>
+	struct is_shared_buffer : std::false_type {};
+
+	template<class T>
+	struct is_shared_buffer<T, std::enable_if_t<std::is_same_v<
+		std::remove_cv_t<std::remove_reference_t<T>>, shared_buffer>>> : std::true_type {};
+
+	template<class T>
+	inline constexpr bool is_shared_buffer_v = is_shared_buffer<T>::value;
+}
+
+namespace asio2
+{
+	using shared_buffer = detail::shared_buffer;
+}
+
+namespace asio
+{
+	/*
+	 * make the shared_buffer can be used by asio::buffer(...) directly, then all the send
+	 * operations which call asio::buffer(data) can send the shared_buffer without copying.
+	 */
+
+	inline ASIO_CONST_BUFFER buffer(const ::asio2::detail::shared_buffer& data) ASIO_NOEXCEPT
+	{
+		return ASIO_CONST_BUFFER(data.data(), data.size());
+	}
+
+	inline ASIO_CONST_BUFFER buffer(const ::asio2::detail::shared_buffer& data,
+		std::size_t max_size_in_bytes) ASIO_NOEXCEPT
+	{
+		return ASIO_CONST_BUFFER(data.data(), (std::min)(data.size(), max_size_in_bytes));
+	}
+}
+
+#endif // !__ASIO2_SHARED_BUFFER_HPP__
@@ -0,0 +1,511 @@
+/*
+ * COPYRIGHT (C) 2017-2021, zhllxt
+ *
+ * author   : zhllxt
+ * email    : 37792738@qq.com
+ *
+ * Distributed under the GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+ * (See accompanying file LICENSE or see <http://www.gnu.org/licenses/>)
+ */
+
+#ifndef __ASIO2_SLAB_ALLOCATOR_HPP__
+#define __ASIO2_SLAB_ALLOCATOR_HPP__
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+#pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <atomic>
+#include <string>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+namespace asio2::detail
+{
+	/**
+	 * The slab allocator is a thread local cache of the freed memory blocks, the blocks are grouped
+	 * by the size classes 32, 64, 128 ... 4096 bytes. Each io_context is run by one thread, so the
+	 * thread local cache is a per io_context cache, the handlers, the event queue nodes and the
+	 * persisted send data of the sessions which are running in the io_context are allocated from
+	 * it without any lock.
+	 * Each block is allocated by ::operator new alone, so a block can be freed in any thread, it is
+	 * put into the cache of the freeing thread. The larger allocations are not cached.
+	 * Define ASIO2_DISABLE_SLAB_ALLOCATOR to allocate all the memory from the global heap directly.
+	 */
+	struct slab_stats
+	{
+		/// the allocations which are got from the cache
+		std::uint64_t hits         = 0;
+
+		/// the allocations which are got from the global heap, because the cache is empty
+		std::uint64_t misses       = 0;
+
+		/// the allocations which are larger than the max size class, they are not cached
+		std::uint64_t large        = 0;
+
+		/// the deallocations which are put into the cache
+		std::uint64_t recycled     = 0;
+
+		/// the deallocations which are freed to the global heap, because the cache is full
+		std::uint64_t released     = 0;
+
+		/// the bytes of the blocks which are in the caches now
+		std::uint64_t cached_bytes = 0;
+
+		inline slab_stats& operator+=(const slab_stats& o) noexcept
+		{
+			hits         += o.hits;
+			misses       += o.misses;
+			large        += o.large;
+			recycled     += o.recycled;
+			released     += o.released;
+			cached_bytes += o.cached_bytes;
+			return *this;
+		}
+	};
+
+	class slab_cache;
+
+	struct slab_registry
+	{
+		std::mutex                mutex;
+
+		/// the caches of the running threads
+		std::vector<slab_cache*>  caches;
+
+		/// the statistics of the exited threads
+		slab_stats                retired;
+	};
+
+	template<typename = void>
+	inline slab_registry& _slab_registry() noexcept
+	{
+		static slab_registry registry;
+		return registry;
+	}
+
+	class slab_cache
+	{
+	public:
+		static constexpr std::size_t min_size    = 32;
+		static constexpr std::size_t max_size    = 4096;
+		static constexpr std::size_t class_count = 8;
+
+		/// the max bytes of the cached blocks of each size class
+		static constexpr std::size_t class_bytes = 256 * 1024;
+
+		slab_cache()
+		{
+			slab_registry& r = _slab_registry();
+			std::lock_guard<std::mutex> guard(r.mutex);
+			r.caches.emplace_back(this);
+		}
+
+		~slab_cache()
+		{
+			{
+				slab_registry& r = _slab_registry();
+				std::lock_guard<std::mutex> guard(r.mutex);
+				r.caches.erase(std::remove(r.caches.begin(), r.caches.end(), this), r.caches.end());
+				slab_stats s = this->stats();
+				s.cached_bytes = 0;
+				r.retired += s;
+			}
+
+			for (free_list& list : this->lists_)
+			{
+				while (block* b = list.head)
+				{
+					list.head = b->next;
+					::operator delete(static_cast<void*>(b));
+				}
+			}
+
+			this->cached_bytes_.store(0, std::memory_order_relaxed);
+		}
+
+		slab_cache(const slab_cache&) = delete;
+		slab_cache& operator=(const slab_cache&) = delete;
+
+		static inline std::size_t size_class(std::size_t size) noexcept
+		{
+			std::size_t index = 0;
+			for (std::size_t n = min_size; n < size; n <<= 1)
+				++index;
+			return index;
+		}
+
+		inline void* allocate(std::size_t size)
+		{
+			if (size > max_size)
+			{
+				_increase(this->large_);
+				return ::operator new(size);
+			}
+
+			std::size_t index = size_class(size);
+
+			free_list& list = this->lists_[index];
+
+			if (block* b = list.head; b)
+			{
+				list.head = b->next;
+				--list.count;
+
+				_increase(this->hits_);
+				_decrease(this->cached_bytes_, min_size << index);
+
+				return static_cast<void*>(b);
+			}
+
+			_increase(this->misses_);
+
+			return ::operator new(min_size << index);
+		}
+
+		inline void deallocate(void* p, std::size_t size) noexcept
+		{
+			if (size > max_size)
+			{
+				::operator delete(p);
+				return;
+			}
+
+			std::size_t index = size_class(size);
+
+			free_list& list = this->lists_[index];
+
+			if (list.count < class_bytes / (min_size << index))
+			{
+				block* b = ::new (p) block{ list.head };
+				list.head = b;
+				++list.count;
+
+				_increase(this->recycled_);
+				_increase(this->cached_bytes_, min_size << index);
+			}
+			else
+			{
+				_increase(this->released_);
+
+				::operator delete(p);
+			}
+		}
+
+		/**
+		 * @function : get the statistics of this cache, it can be called in any thread.
+		 */
+		inline slab_stats stats() const noexcept
+		{
+			slab_stats s;
+			s.hits         = this->hits_        .load(std::memory_order_relaxed);
+			s.misses       = this->misses_      .load(std::memory_order_relaxed);
+			s.large        = this->large_       .load(std::memory_order_relaxed);
+			s.recycled     = this->recycled_    .load(std::memory_order_relaxed);
+			s.released     = this->released_    .load(std::memory_order_relaxed);
+			s.cached_bytes = this->cached_bytes_.load(std::memory_order_relaxed);
+			return s;
+		}
+
+	protected:
+		// the counters are only written by the owner thread, so the read-modify-write is not needed.
+		static inline void _increase(std::atomic<std::uint64_t>& v, std::uint64_t n = 1) noexcept
+		{
+			v.store(v.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+		}
+
+		static inline void _decrease(std::atomic<std::uint64_t>& v, std::uint64_t n) noexcept
+		{
+			v.store(v.load(std::memory_order_relaxed) - n, std::memory_order_relaxed);
+		}
+
+	protected:
+		struct block
+		{
+			block* next;
+		};
+
+		struct free_list
+		{
+			block*      head  = nullptr;
+			std::size_t count = 0;
+		};
+
+		free_list                  lists_[class_count];
+
+		std::atomic<std::uint64_t> hits_        { 0 };
+		std::atomic<std::uint64_t> misses_      { 0 };
+		std::atomic<std::uint64_t> large_       { 0 };
+		std::atomic<std::uint64_t> recycled_    { 0 };
+		std::atomic<std::uint64_t> released_    { 0 };
+		std::atomic<std::uint64_t> cached_bytes_{ 0 };
+	};
+
+	/**
+	 * the flag is trivially destructible, so it can still be read when the thread local cache has
+	 * been destroyed, the memory which is freed by the other thread local destructors after that
+	 * is freed to the global heap directly.
+	 */
+	template<typename = void>
+	inline bool& _slab_cache_destroyed() noexcept
+	{
+		thread_local bool destroyed = false;
+		return destroyed;
+	}
+
+	template<typename = void>
+	inline slab_cache* _slab_local_cache() noexcept
+	{
+		if (_slab_cache_destroyed())
+			return nullptr;
+
+		struct local_cache : public slab_cache
+		{
+			~local_cache() { _slab_cache_destroyed() = true; }
+		};
+
+		thread_local local_cache cache;
+
+		return &cache;
+	}
+
+	/**
+	 * @function : allocate the memory from the slab cache of the current thread.
+	 */
+	inline void* slab_allocate(std::size_t size)
+	{
+	#if !defined(ASIO2_DISABLE_SLAB_ALLOCATOR)
+		if (slab_cache* cache = _slab_local_cache(); cache)
+			return cache->allocate(size);
+	#endif
+
+		return ::operator new(size);
+	}
+
+	/**
+	 * @function : free the memory which is allocated by slab_allocate, the size must be the same
+	 * as the size which is passed to slab_allocate, it can be called in any thread.
+	 */
+	inline void slab_deallocate(void* p, std::size_t size) noexcept
+	{
+	#if !defined(ASIO2_DISABLE_SLAB_ALLOCATOR)
+		if (slab_cache* cache = _slab_local_cache(); cache)
+		{
+			cache->deallocate(p, size);
+			return;
+		}
+	#else
+		std::ignore = size;
+	#endif
+
+		::operator delete(p);
+	}
+
+	/**
+	 * @function : get the statistics of the slab caches of all the threads.
+	 */
+	template<typename = void>
+	inline slab_stats slab_statistics() noexcept
+	{
+		slab_registry& r = _slab_registry();
+
+		std::lock_guard<std::mutex> guard(r.mutex);
+
+		slab_stats s = r.retired;
+
+		for (slab_cache* cache : r.caches)
+		{
+			s += cache->stats();
+		}
+
+		return s;
+	}
+
+	/**
+	 * The standard allocator which allocates the memory from the slab cache, it can be used by the
+	 * standard containers.
+	 */
+	template<class T>
+	class slab_allocator
+	{
+	public:
+		using value_type = T;
+
+		static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+			"The over aligned type can't be allocated by the slab allocator.");
+
+		slab_allocator() noexcept = default;
+
+		template<class U>
+		slab_allocator(const slab_allocator<U>&) noexcept {}
+
+		inline T* allocate(std::size_t n)
+		{
+			return static_cast<T*>(slab_allocate(sizeof(T) * n));
+		}
+
+		inline void deallocate(T* p, std::size_t n) noexcept
+		{
+			slab_deallocate(static_cast<void*>(p), sizeof(T) * n);
+		}
+
+		/// the value constructed by no argument is default initialized instead of value initialized,
+		/// so resizing a vector of chars doesn't fill the new bytes with zero.
+		template<class U>
+		inline void construct(U* p) noexcept(std::is_nothrow_default_constructible_v<U>)
+		{
+			::new (static_cast<void*>(p)) U;
+		}
+
+		template<class U, class... Args>
+		inline void construct(U* p, Args&&... args)
+		{
+			::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+		}
+
+		template<class U>
+		inline bool operator==(const slab_allocator<U>&) const noexcept { return true; }
+
+		template<class U>
+		inline bool operator!=(const slab_allocator<U>&) const noexcept { return false; }
+	};
+
+	template<class CharT>
+	using slab_basic_string = std::basic_string<CharT, std::char_traits<CharT>, slab_allocator<CharT>>;
+
+	template<class Signature>
+	class slab_function;
+
+	/**
+	 * The move only function wrapper which stores the callable object in the slab cache, it is used
+	 * instead of the std::function for the queued events, the std::function requires the callable
+	 * object is copyable, and allocates it from the global heap when it is larger than two pointers.
+	 */
+	template<class R, class... Args>
+	class slab_function<R(Args...)>
+	{
+	public:
+		slab_function() noexcept = default;
+
+		slab_function(std::nullptr_t) noexcept {}
+
+		template<class F, std::enable_if_t<!std::is_same_v<std::decay_t<F>, slab_function>, int> = 0>
+		slab_function(F&& f)
+		{
+			using fun_type = std::decay_t<F>;
+
+			void* p = slab_allocate(sizeof(fun_type));
+
+			try
+			{
+				::new (p) fun_type(std::forward<F>(f));
+			}
+			catch (...)
+			{
+				slab_deallocate(p, sizeof(fun_type));
+				throw;
+			}
+
+			this->ptr_ = p;
+			this->ops_ = &ops_for<fun_type>;
+		}
+
+		slab_function(slab_function&& o) noexcept
+			: ptr_(std::exchange(o.ptr_, nullptr))
+			, ops_(std::exchange(o.ops_, nullptr))
+		{
+		}
+
+		slab_function& operator=(slab_function&& o) noexcept
+		{
+			if (this != std::addressof(o))
+			{
+				this->reset();
+				this->ptr_ = std::exchange(o.ptr_, nullptr);
+				this->ops_ = std::exchange(o.ops_, nullptr);
+			}
+			return *this;
+		}
+
+		slab_function(const slab_function&) = delete;
+		slab_function& operator=(const slab_function&) = delete;
+
+		~slab_function()
+		{
+			this->reset();
+		}
+
+		inline void reset() noexcept
+		{
+			if (this->ops_)
+			{
+				this->ops_->destroy(this->ptr_);
+				this->ptr_ = nullptr;
+				this->ops_ = nullptr;
+			}
+		}
+
+		inline R operator()(Args... args)
+		{
+			return this->ops_->invoke(this->ptr_, std::forward<Args>(args)...);
+		}
+
+		inline explicit operator bool() const noexcept
+		{
+			return this->ops_ != nullptr;
+		}
+
+		/**
+		 * @function : get the pointer of the stored callable object, like std::function::target.
+		 * @return   : nullptr if the type of the stored callable object is not F.
+		 */
+		template<class F>
+		inline F* target() noexcept
+		{
+			return (this->ops_ == &ops_for<F> ? static_cast<F*>(this->ptr_) : nullptr);
+		}
+
+	protected:
+		struct operations
+		{
+			R    (*invoke )(void*, Args&&...);
+			void (*destroy)(void*) noexcept;
+		};
+
+		template<class F>
+		static inline R _invoke(void* p, Args&&... args)
+		{
+			return (*static_cast<F*>(p))(std::forward<Args>(args)...);
+		}
+
+		template<class F>
+		static inline void _destroy(void* p) noexcept
+		{
+			static_cast<F*>(p)->~F();
+			slab_deallocate(p, sizeof(F));
+		}
+
+		template<class F>
+		static constexpr operations ops_for{ &_invoke<F>, &_destroy<F> };
+
+	protected:
+		void*             ptr_ = nullptr;
+		const operations* ops_ = nullptr;
+	};
+}
+
+namespace asio2
+{
+	using slab_stats = detail::slab_stats;
+
+	using detail::slab_statistics;
+}
+
+#endif // !__ASIO2_SLAB_ALLOCATOR_HPP__
@@ -0,0 +1,355 @@
+/*
+ * COPYRIGHT (C) 2017-2021, zhllxt
+ *
+ * author   : zhllxt
+ * email    : 37792738@qq.com
+ *
+ * Distributed under the GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+ * (See accompanying file LICENSE or see <http://www.gnu.org/licenses/>)
+ */
+
+#ifndef __ASIO2_TIMER_WHEEL_HPP__
+#define __ASIO2_TIMER_WHEEL_HPP__
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+#pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <cstdint>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <functional>
+
+#include <asio2/3rd/asio.hpp>
+#include <asio2/base/error.hpp>
+#include <asio2/base/detail/util.hpp>
+
+namespace asio2::detail
+{
+	class timer_wheel;
+
+	/**
+	 * The timer entry of the timer_wheel, it's a intrusive list node, so the schedule and cancel
+	 * operations of the timer_wheel don't allocate memory. The entry is usually a member of the
+	 * object which owns the timer, the callback is set only once, and then the entry can be
+	 * scheduled and canceled many times.
+	 * The entry must be scheduled, canceled and destroyed in the thread of the timer_wheel.
+	 */
+	class timer_entry
+	{
+		friend class timer_wheel;
+
+	public:
+		timer_entry() = default;
+
+		template<class Fun>
+		explicit timer_entry(Fun&& callback) : callback_(std::forward<Fun>(callback)) {}
+
+		~timer_entry()
+		{
+			this->_unlink();
+		}
+
+		timer_entry(timer_entry&&) = delete;
+		timer_entry(timer_entry const&) = delete;
+		timer_entry& operator=(timer_entry&&) = delete;
+		timer_entry& operator=(timer_entry const&) = delete;
+
+		/**
+		 * @function : set the callback which is called when the entry is expired, signature : void()
+		 */
+		template<class Fun>
+		inline timer_entry& callback(Fun&& fun)
+		{
+			this->callback_ = std::forward<Fun>(fun);
+			return (*this);
+		}
+
+		/**
+		 * @function : check whether the entry is scheduled and not expired yet
+		 */
+		inline bool scheduled() const noexcept { return (this->wheel_ != nullptr); }
+
+	protected:
+		inline void _unlink() noexcept;
+
+	protected:
+		timer_wheel         * wheel_ = nullptr;
+		timer_entry         * prev_  = nullptr;
+		timer_entry         * next_  = nullptr;
+
+		/// the tick when the entry is expired
+		std::uint64_t         due_   = 0;
+
+		std::function<void()> callback_;
+	};
+
+	/**
+	 * A hashed timer wheel driven by one asio::steady_timer, many entries can be scheduled on it
+	 * with the precision of a tick, and the schedule and cancel operations are O(1), so it is
+	 * much cheaper than one asio::steady_timer per object when there are many objects which
+	 * are re-armed frequently.
+	 * The underlying timer is armed only when there are scheduled entries, and it is armed to
+	 * the nearest tick which has entries, so the idle wheel don't wake up the thread.
+	 * All the functions must be called in the thread of the strand.
+	 */
+	class timer_wheel : public std::enable_shared_from_this<timer_wheel>
+	{
+		friend class timer_entry;
+
+	public:
+		using clock_type = std::chrono::steady_clock;
+
+		/**
+		 * @constructor
+		 * @param    : strand - the entries are expired in the thread of this strand
+		 * @param    : tick   - the precision of the wheel
+		 * @param    : slots  - the slot count of the wheel, the entries that expired after
+		 *                      slots * tick are stored in the wheel too, just be visited
+		 *                      one time more every round.
+		 */
+		explicit timer_wheel(io_strand_t strand,
+			std::chrono::milliseconds tick = std::chrono::milliseconds(1), std::size_t slots = 1024)
+			: strand_(std::move(strand))
+			, timer_ (strand_.context())
+			, tick_  ((std::max)(tick, std::chrono::milliseconds(1)))
+			, epoch_ (clock_type::now())
+			, slots_ ((std::max)(slots, std::size_t(2)))
+		{
+			for (timer_entry& head : this->slots_)
+			{
+				head.prev_ = std::addressof(head);
+				head.next_ = std::addressof(head);
+			}
+
+			this->current_ = this->_now_tick();
+		}
+
+		/**
+		 * @destructor
+		 */
+		~timer_wheel()
+		{
+			for (timer_entry& head : this->slots_)
+			{
+				while (head.next_ != std::addressof(head))
+					head.next_->_unlink();
+			}
+		}
+
+		/**
+		 * @function : schedule the entry to be expired after the duration, if the entry is
+		 * scheduled already, it will be rescheduled.
+		 */
+		template<class Rep, class Period>
+		inline void schedule(timer_entry& entry, std::chrono::duration<Rep, Period> duration)
+		{
+			ASIO2_ASSERT(this->strand_.running_in_this_thread());
+
+			entry._unlink();
+
+			// round up, the entry can't be expired before the duration.
+			std::uint64_t ticks = static_cast<std::uint64_t>(
+				(std::chrono::duration_cast<std::chrono::milliseconds>(duration).count() +
+					this->tick_.count() - 1) / this->tick_.count());
+
+			std::uint64_t due = (std::max)(this->_now_tick(), this->current_) + (std::max)(ticks, std::uint64_t(1));
+
+			timer_entry& head = this->slots_[due % this->slots_.size()];
+
+			entry.wheel_ = this;
+			entry.due_   = due;
+			entry.prev_  = head.prev_;
+			entry.next_  = std::addressof(head);
+			head.prev_->next_ = std::addressof(entry);
+			head.prev_ = std::addressof(entry);
+
+			++(this->count_);
+
+			// if the timer is armed to a later tick, or isn't armed, arm it again.
+			if (this->armed_ == 0 || due < this->armed_)
+				this->_post_timer(due);
+		}
+
+		/**
+		 * @function : cancel the entry, the callback will not be called.
+		 */
+		inline void cancel(timer_entry& entry)
+		{
+			ASIO2_ASSERT(entry.wheel_ == nullptr || this->strand_.running_in_this_thread());
+
+			entry._unlink();
+		}
+
+		/**
+		 * @function : get the count of the scheduled entries
+		 */
+		inline std::size_t size() const noexcept { return this->count_; }
+
+		/**
+		 * @function : get the precision of the wheel
+		 */
+		inline std::chrono::milliseconds tick() const noexcept { return this->tick_; }
+
+		/**
+		 * @function : get the strand of the wheel
+		 */
+		inline io_strand_t & strand() noexcept { return this->strand_; }
+
+	protected:
+		inline std::uint64_t _now_tick() const
+		{
+			return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+				clock_type::now() - this->epoch_).count() / this->tick_.count());
+		}
+
+		inline void _on_unlink() noexcept
+		{
+			ASIO2_ASSERT(this->count_ > 0);
+
+			// there is no entry, cancel the timer, otherwise the timer will hold the io_context
+			// and the io_context can't be stopped.
+			if (--(this->count_) == 0 && this->armed_ != 0)
+			{
+				this->armed_ = 0;
+
+				error_code ec_ignore{};
+				this->timer_.cancel(ec_ignore);
+			}
+		}
+
+		inline void _post_timer(std::uint64_t due)
+		{
+			this->armed_ = due;
+
+			this->timer_.expires_at(this->epoch_ + this->tick_ * due);
+			this->timer_.async_wait(asio::bind_executor(this->strand_,
+			[this, self = this->shared_from_this(), due](const error_code& ec) mutable
+			{
+				detail::ignore_unused(self);
+
+				// the timer is canceled or rearmed to another tick already
+				if (ec == asio::error::operation_aborted || this->armed_ != due)
+					return;
+
+				this->armed_ = 0;
+
+				this->_handle_timer();
+			}));
+		}
+
+		inline void _handle_timer()
+		{
+			std::uint64_t now = this->_now_tick();
+
+			// collect the expired entries into a temporary list first, because the callback
+			// may reschedule the entry into the current slot.
+			timer_entry expired;
+			expired.prev_ = std::addressof(expired);
+			expired.next_ = std::addressof(expired);
+
+			std::uint64_t last = (std::min)(now, this->current_ + this->slots_.size() - 1);
+
+			for (std::uint64_t tick = this->current_; tick <= last; ++tick)
+			{
+				timer_entry& head = this->slots_[tick % this->slots_.size()];
+
+				for (timer_entry* e = head.next_; e != std::addressof(head);)
+				{
+					timer_entry* next = e->next_;
+
+					if (e->due_ <= now)
+					{
+						// move to the expired list, the entry is still scheduled
+						e->prev_->next_ = e->next_;
+						e->next_->prev_ = e->prev_;
+
+						e->prev_ = expired.prev_;
+						e->next_ = std::addressof(expired);
+						expired.prev_->next_ = e;
+						expired.prev_ = e;
+					}
+
+					e = next;
+				}
+			}
+
+			this->current_ = now;
+
+			// the entry maybe canceled or destroyed by the callback of another entry, so pop the
+			// entry from the head of the list one by one, the canceled entry is unlinked from the
+			// expired list automatically, and don't access the entry after the callback is called.
+			while (expired.next_ != std::addressof(expired))
+			{
+				timer_entry* e = expired.next_;
+
+				e->_unlink();
+
+				if (e->callback_)
+					e->callback_();
+			}
+
+			expired.prev_ = nullptr;
+			expired.next_ = nullptr;
+
+			if (this->count_ > 0 && this->armed_ == 0)
+				this->_post_timer(this->_next_due(now));
+		}
+
+		inline std::uint64_t _next_due(std::uint64_t now) const
+		{
+			// find the nearest tick which has entries, the entries of the slot maybe expired
+			// in the later rounds, then the timer is just waked up once more.
+			for (std::uint64_t tick = now + 1; tick <= now + this->slots_.size(); ++tick)
+			{
+				const timer_entry& head = this->slots_[tick % this->slots_.size()];
+				if (head.next_ != std::addressof(head))
+					return tick;
+			}
+			return now + 1;
+		}
+
+	protected:
+		io_strand_t                strand_;
+
+		asio::steady_timer         timer_;
+
+		std::chrono::milliseconds  tick_;
+
+		clock_type::time_point     epoch_;
+
+		/// the slots, each slot is the head of a circular list
+		std::vector<timer_entry>   slots_;
+
+		/// the tick which has been handled
+		std::uint64_t              current_ = 0;
+
+		/// the tick which the timer is armed to, 0 means not armed
+		std::uint64_t              armed_   = 0;
+
+		/// the count of the scheduled entries
+		std::size_t                count_   = 0;
+	};
+
+	inline void timer_entry::_unlink() noexcept
+	{
+		if (this->prev_ && this->next_ && this->prev_ != this && this->next_ != this)
+		{
+			this->prev_->next_ = this->next_;
+			this->next_->prev_ = this->prev_;
+		}
+
+		this->prev_ = nullptr;
+		this->next_ = nullptr;
+
+		if (this->wheel_)
+		{
+			timer_wheel* wheel = this->wheel_;
+			this->wheel_ = nullptr;
+			wheel->_on_unlink();
+		}
+	}
+}
+
+#endif // !__ASIO2_TIMER_WHEEL_HPP__
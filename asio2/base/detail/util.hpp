@@ -222,8 +222,94 @@ namespace asio2::detail
 	inline constexpr bool is_copyable_wrapper_v = is_copyable_wrapper<T>::value;
 
 
+#if defined(ASIO2_THREAD_PER_CORE)
+	/**
+	 * The thread which runs the io_context in the thread per core mode, it's recorded when the
+	 * io_context is checked by io_strand_t::running_in_this_thread at the first time, and the
+	 * following checks must be in the same thread. The check is only compiled in the debug mode,
+	 * the same as ASIO2_ASSERT.
+	 */
+	class io_owner_service : public asio::execution_context::service
+	{
+	public:
+		inline static asio::execution_context::id id;
+
+		explicit io_owner_service(asio::execution_context& ctx) : asio::execution_context::service(ctx) {}
+
+		inline void check() noexcept
+		{
+		#if defined(_DEBUG) || defined(DEBUG)
+			std::thread::id curr_tid = std::this_thread::get_id();
+			std::thread::id owner    = this->owner_.load(std::memory_order_relaxed);
+
+			// only the first check writes the owner, the following checks are loads only.
+			if (owner == std::thread::id{} &&
+				this->owner_.compare_exchange_strong(owner, curr_tid, std::memory_order_relaxed))
+				return;
+
+			ASIO2_ASSERT(owner == curr_tid &&
+				"The io_context must be run by only one thread in the thread per core mode.");
+		#endif
+		}
+
+		/**
+		 * @function : forget the recorded thread, called when the threads of the iopool are exited.
+		 */
+		inline void reset() noexcept
+		{
+			this->owner_.store(std::thread::id{}, std::memory_order_relaxed);
+		}
+
+	protected:
+		virtual void shutdown() override {}
+
+	protected:
+		std::atomic<std::thread::id> owner_{};
+	};
+
+	/**
+	 * In the thread per core mode, each io_context is run by only one thread, so the handlers
+	 * of the same io_context never run concurrently, the strand is elided and the executor of
+	 * the io_context is used directly, there is no strand queueing and locking for the handlers.
+	 * The running_in_this_thread checks that the io_context is always run by the same thread.
+	 */
+	class io_strand_t : public asio::io_context::executor_type
+	{
+	public:
+		using executor_type = asio::io_context::executor_type;
+
+		explicit io_strand_t(asio::io_context& ioc)
+			: executor_type(ioc.get_executor()), owner_(std::addressof(asio::use_service<io_owner_service>(ioc)))
+		{
+		}
+
+		inline bool running_in_this_thread() const noexcept
+		{
+			if (!executor_type::running_in_this_thread())
+				return false;
+
+			this->owner_->check();
+
+			return true;
+		}
+
+	protected:
+		io_owner_service * owner_ = nullptr;
+	};
+
+	inline io_strand_t make_io_strand(asio::io_context& ioc) { return io_strand_t(ioc); }
+
+	inline void reset_io_owner(asio::io_context& ioc) { asio::use_service<io_owner_service>(ioc).reset(); }
+#else
+	using io_strand_t = asio::io_context::strand;
+
+	inline io_strand_t make_io_strand(asio::io_context& ioc) { return io_strand_t(ioc); }
+
+	inline void reset_io_owner(asio::io_context& ioc) { std::ignore = ioc; }
+#endif
+
 	template<class Rep, class Period, class Fn>
-	std::shared_ptr<asio::steady_timer> mktimer(asio::io_context& ioc, asio::io_context::strand& strand,
+	std::shared_ptr<asio::steady_timer> mktimer(asio::io_context& ioc, io_strand_t& strand,
 		std::chrono::duration<Rep, Period> duration, Fn&& fn)
 	{
 		std::shared_ptr<asio::steady_timer> timer = std::make_shared<asio::steady_timer>(ioc);
@@ -15,17 +15,32 @@
 #pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include <cstdint>
+#include <cstdio>
 #include <vector>
 #include <thread>
 #include <mutex>
+#include <atomic>
 #include <chrono>
+#include <fstream>
+#include <string>
+#include <tuple>
 #include <type_traits>
 #include <memory>
 #include <algorithm>
+#include <functional>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#endif
 
 #include <asio2/3rd/asio.hpp>
 #include <asio2/base/error.hpp>
 #include <asio2/base/detail/util.hpp>
+#include <asio2/base/detail/timer_wheel.hpp>
+#include <asio2/base/detail/metrics.hpp>
 
 namespace asio2::detail
 {
@@ -76,6 +91,50 @@ namespace asio2::detail
 	static_assert(is_io_context_object<asio::io_context&&>::value);
 
 
+	/**
+	 * The load counters of an io_context, they can be read in any thread to see the load skew of
+	 * the io_contexts.
+	 */
+	struct io_load
+	{
+		/// the count of the sessions which are running in this io_context now
+		std::atomic<std::size_t>   sessions        { 0 };
+
+		/// the total count of the sessions which were placed in this io_context
+		std::atomic<std::uint64_t> placed          { 0 };
+
+		/// the count of the handlers which were run, only counted when the busy time is measured
+		std::atomic<std::uint64_t> handlers        { 0 };
+
+		/// the total busy time of the io_context thread in nanoseconds, only counted when the
+		/// busy time is measured, see iopool::measure_busy_time
+		std::atomic<std::uint64_t> busy_time       { 0 };
+
+		/// the busy time of the io_context thread in the last second, in nanoseconds
+		std::atomic<std::uint64_t> recent_busy_time{ 0 };
+
+		/// the count of the sessions when the recent_busy_time was updated, the sessions which
+		/// are placed after it are not counted in the recent_busy_time yet
+		std::atomic<std::size_t>   recent_sessions { 0 };
+	};
+
+	/**
+	 * The policy to choose the io_context for a new session.
+	 */
+	enum class io_placement : std::uint8_t
+	{
+		/// the io_contexts are used in turn, this is the default
+		round_robin,
+
+		/// the io_context which has the least running sessions
+		least_sessions,
+
+		/// the io_context whose thread was the least busy in the last second, and the sessions
+		/// placed after that second are counted by the average busy time of a session. the busy
+		/// time is measured by the iopool threads, so it is only useful for the default iopool
+		least_busy,
+	};
+
 	/**
 	 * io_context pool
 	 */
@@ -96,6 +155,7 @@ namespace asio2::detail
 			for (std::size_t i = 0; i < concurrency; ++i)
 			{
 				this->ios_.emplace_back(std::make_unique<asio::io_context>(1));
+				this->loads_.emplace_back(std::make_shared<io_load>());
 			}
 
 			this->threads_.reserve(this->ios_.size());
@@ -132,8 +192,10 @@ namespace asio2::detail
 			}
 
 			// Create a pool of threads to run all of the io_contexts. 
-			for (auto & ioc : this->ios_)
+			for (std::size_t i = 0; i < this->ios_.size(); ++i)
 			{
+				std::unique_ptr<asio::io_context>& ioc = this->ios_[i];
+
 				/// Restart the io_context in preparation for a subsequent run() invocation.
 				/**
 				 * This function must be called prior to any second or later set of
@@ -150,9 +212,15 @@ namespace asio2::detail
 				this->guards_.emplace_back(ioc->get_executor());
 
 				// start work thread
-				this->threads_.emplace_back([&ioc]() mutable
+				this->threads_.emplace_back([this, &ioc, i]() mutable
 				{
-					ioc->run();
+					if (!this->cpus_.empty())
+						this->_bind_cpu(this->cpus_[i % this->cpus_.size()]);
+
+					if (this->measure_busy_time_)
+						this->_run_measured(*ioc, *(this->loads_[i]));
+					else
+						ioc->run();
 				});
 			}
 
@@ -212,6 +280,12 @@ namespace asio2::detail
 					thread.join();
 				}
 
+				// the io_contexts will be run by the new threads when the pool is started again.
+				for (auto & ioc : this->ios_)
+				{
+					reset_io_owner(*ioc);
+				}
+
 				this->guards_.clear();
 				this->threads_.clear();
 			}
@@ -236,6 +310,98 @@ namespace asio2::detail
 			return *(this->ios_[index < this->ios_.size() ? index : ((++(this->next_)) % this->ios_.size())]);
 		}
 
+		/**
+		 * @function : get the load counters of the io_context by index
+		 */
+		inline std::shared_ptr<io_load> load(std::size_t index) const
+		{
+			ASIO2_ASSERT(index < this->loads_.size());
+
+			return this->loads_[index];
+		}
+
+		/**
+		 * @function : pin the pool threads to the cpus, the thread i is pinned to the cpu
+		 * cpus[i % cpus.size()], empty means the threads are not pinned, the default is empty.
+		 * it's only supported on linux and windows, and must be called before start.
+		 * eg : cpu_affinity(iopool::numa_node_cpus(0)); // pin the threads to the numa node 0
+		 */
+		inline iopool& cpu_affinity(std::vector<std::size_t> cpus)
+		{
+			ASIO2_ASSERT(this->stopped_);
+
+			this->cpus_ = std::move(cpus);
+
+			return (*this);
+		}
+
+		/**
+		 * @function : get the cpus which the pool threads are pinned to
+		 */
+		inline const std::vector<std::size_t>& cpu_affinity() const
+		{
+			return this->cpus_;
+		}
+
+		/**
+		 * @function : whether measure the busy time of the pool threads, see io_load, the
+		 * thread runs the ready handlers by poll and measures the time of it, and then waits
+		 * for the next handler, the handler which is run by the waiting is measured by the cpu
+		 * time of the thread (linux and windows only). the default is false, and must be called
+		 * before start.
+		 */
+		inline iopool& measure_busy_time(bool enable)
+		{
+			ASIO2_ASSERT(this->stopped_);
+
+			this->measure_busy_time_ = enable;
+
+			return (*this);
+		}
+
+		/**
+		 * @function : whether the busy time of the pool threads is measured
+		 */
+		inline bool measure_busy_time() const
+		{
+			return this->measure_busy_time_;
+		}
+
+		/**
+		 * @function : get the cpus of the numa node, it's read from the linux sysfs, the result
+		 * is empty on other platforms or if the node is not exists.
+		 */
+		static std::vector<std::size_t> numa_node_cpus(std::size_t node)
+		{
+			std::vector<std::size_t> cpus;
+
+		#if defined(__linux__)
+			// the cpulist is like this : 0-3,8-11
+			std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+
+			std::string range;
+
+			while (std::getline(file, range, ','))
+			{
+				std::size_t first = 0, last = 0;
+
+				if (std::sscanf(range.data(), "%zu-%zu", &first, &last) == 2)
+				{
+					for (std::size_t cpu = first; cpu <= last; ++cpu)
+						cpus.emplace_back(cpu);
+				}
+				else if (std::sscanf(range.data(), "%zu", &first) == 1)
+				{
+					cpus.emplace_back(first);
+				}
+			}
+		#else
+			std::ignore = node;
+		#endif
+
+			return cpus;
+		}
+
 		/**
 		 * @function : call user custom callback function for every io_context
 		 * the custom callback function is like this :
@@ -341,6 +507,121 @@ namespace asio2::detail
 			}
 		}
 
+	protected:
+		inline void _bind_cpu(std::size_t cpu)
+		{
+		#if defined(__linux__)
+			// the cpu_set_t can only hold CPU_SETSIZE cpus, CPU_SET with a larger cpu is undefined.
+			if (cpu >= static_cast<std::size_t>(CPU_SETSIZE))
+				return;
+
+			cpu_set_t set;
+			CPU_ZERO(&set);
+			CPU_SET(cpu, &set);
+			::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+		#elif defined(_WIN32) || defined(_WIN64) || defined(_WINDOWS_) || defined(WIN32)
+			if (cpu < sizeof(DWORD_PTR) * 8)
+				::SetThreadAffinityMask(::GetCurrentThread(), DWORD_PTR(1) << cpu);
+		#else
+			std::ignore = cpu;
+		#endif
+		}
+
+		/**
+		 * get the cpu time of the current thread in nanoseconds, the time which the thread is
+		 * blocked in waiting is not counted in it. returns 0 if it is not supported.
+		 */
+		static inline std::uint64_t _thread_cpu_time() noexcept
+		{
+		#if defined(__linux__)
+			struct timespec ts{};
+			if (::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+				return static_cast<std::uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<std::uint64_t>(ts.tv_nsec);
+		#elif defined(_WIN32) || defined(_WIN64) || defined(_WINDOWS_) || defined(WIN32)
+			FILETIME creation_time, exit_time, kernel_time, user_time;
+			if (::GetThreadTimes(::GetCurrentThread(), &creation_time, &exit_time, &kernel_time, &user_time))
+			{
+				ULARGE_INTEGER k, u;
+				k.LowPart = kernel_time.dwLowDateTime; k.HighPart = kernel_time.dwHighDateTime;
+				u.LowPart = user_time  .dwLowDateTime; u.HighPart = user_time  .dwHighDateTime;
+				// the unit of the FILETIME is 100 nanoseconds
+				return (static_cast<std::uint64_t>(k.QuadPart) + static_cast<std::uint64_t>(u.QuadPart)) * 100;
+			}
+		#endif
+			return 0;
+		}
+
+		/**
+		 * run the io_context and measure the busy time, the ready handlers are run by poll and
+		 * the time of it is the busy time, when there is no ready handler, wait for the next
+		 * handler at most one second, then the recent busy time is updated even if it's idle.
+		 * the waiting time can't be separated from the handler which is run by the waiting, so
+		 * the busy time of that handler is the cpu time of the thread, waiting uses no cpu time.
+		 */
+		inline void _run_measured(asio::io_context& ioc, io_load& load)
+		{
+			using clock_type = std::chrono::steady_clock;
+
+			constexpr auto window = std::chrono::seconds(1);
+
+			clock_type::time_point window_begin = clock_type::now();
+
+			std::uint64_t busy = 0;
+
+			for (;;)
+			{
+				clock_type::time_point t1 = clock_type::now();
+
+				std::size_t n = ioc.poll();
+
+				clock_type::time_point t2 = clock_type::now();
+
+				if (n > 0)
+				{
+					std::uint64_t ns = static_cast<std::uint64_t>(
+						std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count());
+
+					busy += ns;
+
+					load.busy_time.fetch_add(ns, std::memory_order_relaxed);
+					load.handlers .fetch_add(n , std::memory_order_relaxed);
+				}
+
+				if (auto elapsed = t2 - window_begin; elapsed >= window)
+				{
+					load.recent_busy_time.store(static_cast<std::uint64_t>(double(busy) *
+						double(std::chrono::nanoseconds(window).count()) /
+						double(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count())),
+						std::memory_order_relaxed);
+
+					load.recent_sessions.store(load.sessions.load(std::memory_order_relaxed),
+						std::memory_order_relaxed);
+
+					busy = 0;
+					window_begin = t2;
+				}
+
+				if (n > 0)
+					continue;
+
+				std::uint64_t cpu_time = _thread_cpu_time();
+
+				if (ioc.run_one_for(window) > 0)
+				{
+					std::uint64_t ns = _thread_cpu_time() - cpu_time;
+
+					busy += ns;
+
+					load.busy_time.fetch_add(ns, std::memory_order_relaxed);
+					load.handlers .fetch_add(1 , std::memory_order_relaxed);
+				}
+				else if (ioc.stopped())
+				{
+					break;
+				}
+			}
+		}
+
 	protected:
 		/// threads to run all of the io_context
 		std::vector<std::thread>                                     threads_;
@@ -348,6 +629,15 @@ namespace asio2::detail
 		/// The pool of io_context. 
 		std::vector<std::unique_ptr<asio::io_context>>               ios_;
 
+		/// The load counters of the io_contexts
+		std::vector<std::shared_ptr<io_load>>                        loads_;
+
+		/// The cpus which the threads are pinned to
+		std::vector<std::size_t>                                     cpus_;
+
+		/// Whether measure the busy time of the threads
+		bool                                                         measure_busy_time_ = false;
+
 		/// 
 		std::mutex                                                   mutex_;
 
@@ -374,6 +664,9 @@ namespace asio2::detail
 		virtual asio::io_context& get(std::size_t index)                             = 0;
 		virtual void              for_each(std::function<void(asio::io_context&)> f) = 0;
 		virtual std::size_t       size() const                                       = 0;
+		virtual std::shared_ptr<io_load> load(std::size_t index) const               = 0;
+		virtual void              cpu_affinity(std::vector<std::size_t> cpus)        = 0;
+		virtual void              measure_busy_time(bool enable)                     = 0;
 	};
 
 	class default_iopool : public iopool_base
@@ -439,6 +732,30 @@ namespace asio2::detail
 			return this->impl_.size();
 		}
 
+		/**
+		 * @function : get the load counters of the io_context by index
+		 */
+		virtual std::shared_ptr<io_load> load(std::size_t index) const override
+		{
+			return this->impl_.load(index);
+		}
+
+		/**
+		 * @function : pin the pool threads to the cpus, see iopool::cpu_affinity
+		 */
+		virtual void cpu_affinity(std::vector<std::size_t> cpus) override
+		{
+			this->impl_.cpu_affinity(std::move(cpus));
+		}
+
+		/**
+		 * @function : whether measure the busy time of the pool threads
+		 */
+		virtual void measure_busy_time(bool enable) override
+		{
+			this->impl_.measure_busy_time(enable);
+		}
+
 	protected:
 		iopool impl_;
 	};
@@ -464,6 +781,7 @@ namespace asio2::detail
 			for (auto& ioc : ios)
 			{
 				this->ios_.emplace_back(ioc);
+				this->loads_.emplace_back(std::make_shared<io_load>());
 			}
 		}
 
@@ -546,11 +864,41 @@ namespace asio2::detail
 			return this->ios_.size();
 		}
 
+		/**
+		 * @function : get the load counters of the io_context by index, only the sessions are
+		 * counted, because the io_contexts are run by the user.
+		 */
+		virtual std::shared_ptr<io_load> load(std::size_t index) const override
+		{
+			ASIO2_ASSERT(index < this->loads_.size());
+
+			return this->loads_[index];
+		}
+
+		/**
+		 * @function : the io_contexts are run by the user, so the threads can't be pinned here.
+		 */
+		virtual void cpu_affinity(std::vector<std::size_t> cpus) override
+		{
+			std::ignore = cpus;
+		}
+
+		/**
+		 * @function : the io_contexts are run by the user, so the busy time can't be measured.
+		 */
+		virtual void measure_busy_time(bool enable) override
+		{
+			std::ignore = enable;
+		}
+
 	protected:
 		/// The io_context pointer container
 		/// the io_context pointer maybe "io_context* , std::shared_ptr<io_context> , ..."
 		container                      ios_;
 
+		/// The load counters of the io_contexts
+		std::vector<std::shared_ptr<io_load>> loads_;
+
 		/// 
 		std::mutex                     mutex_;
 
@@ -564,15 +912,84 @@ namespace asio2::detail
 	class io_t
 	{
 	public:
-		io_t(asio::io_context* ioc) : context_(ioc), strand_(*context_) {}
+		io_t(asio::io_context* ioc, std::shared_ptr<io_load> load = std::make_shared<io_load>())
+			: context_(ioc), strand_(make_io_strand(*context_)), load_(std::move(load))
+			, metrics_(std::make_shared<io_metrics>())
+		{
+		#if defined(ASIO2_THREAD_PER_CORE)
+			// the strand is elided, so the io_context must be run by only one thread.
+			ASIO2_ASSERT(asio::use_service<asio::detail::io_context_impl>(*context_).concurrency_hint() == 1 &&
+				"The io_context must be created with concurrency hint 1 in the thread per core mode.");
+		#endif
+		}
 		~io_t() = default;
 
 		inline asio::io_context         & context() { return (*(this->context_)); }
-		inline asio::io_context::strand & strand () { return    this->strand_   ; }
+		inline io_strand_t              & strand () { return    this->strand_   ; }
+
+		/**
+		 * @function : get the load counters of this io
+		 */
+		inline io_load                  & load    () { return (*(this->load_)); }
+		inline std::shared_ptr<io_load> & load_ptr() { return    this->load_   ; }
+
+		/**
+		 * @function : get the metrics of this io, see iopool_cp::metrics
+		 */
+		inline io_metrics                  & metrics    () { return (*(this->metrics_)); }
+		inline std::shared_ptr<io_metrics> & metrics_ptr() { return    this->metrics_   ; }
+
+		/**
+		 * @function : get the timer wheel of this io with the tick precision, the wheel is
+		 * created when it is used at the first time, and all the objects of this io which use
+		 * the same tick precision share the same wheel.
+		 * must be called in the io_context thread.
+		 */
+		inline timer_wheel & wheel(std::chrono::milliseconds tick = std::chrono::milliseconds(1))
+		{
+			// the wheels_ is only modified in the io_context thread, otherwise the wheels_ maybe
+			// searched and appended at the same time.
+			ASIO2_ASSERT(this->strand_.running_in_this_thread());
+
+			for (std::shared_ptr<timer_wheel>& wheel : this->wheels_)
+			{
+				if (wheel->tick() == tick)
+					return (*wheel);
+			}
+
+			return (*(this->wheels_.emplace_back(std::make_shared<timer_wheel>(this->strand_, tick))));
+		}
+
+		/**
+		 * @function : get the granularity of the coarse timer wheel, zero means the coarse timer
+		 * wheel is disabled, see coarse_timer.
+		 */
+		inline std::chrono::milliseconds timer_granularity() const { return this->granularity_; }
+
+		/**
+		 * @function : set the granularity of the coarse timer wheel, zero means disable it.
+		 */
+		inline io_t& timer_granularity(std::chrono::milliseconds granularity)
+		{
+			this->granularity_ = granularity;
+			return (*this);
+		}
 
 	protected:
 		asio::io_context       * context_ = nullptr;
-		asio::io_context::strand strand_;
+		io_strand_t              strand_;
+
+		/// the timer wheels of this io, the element is shared_ptr, because the io_t must be copyable
+		std::vector<std::shared_ptr<timer_wheel>> wheels_;
+
+		/// the granularity of the coarse timer wheel
+		std::chrono::milliseconds granularity_{ 0 };
+
+		/// the load counters of this io, it's shared with the iopool which measures the busy time
+		std::shared_ptr<io_load>  load_;
+
+		/// the metrics of this io, the element is shared_ptr, because the io_t must be copyable
+		std::shared_ptr<io_metrics> metrics_;
 	};
 
 	class iopool_cp
@@ -585,10 +1002,7 @@ namespace asio2::detail
 		{
 			this->iopool_ = std::make_unique<default_iopool>(concurrency);
 
-			this->iopool_->for_each([this](asio::io_context& ioc) mutable
-			{
-				this->iots_.emplace_back(&ioc);
-			});
+			this->_init_iots();
 		}
 
 		template<class IoContextPointerContainer, std::enable_if_t<
@@ -603,10 +1017,7 @@ namespace asio2::detail
 			this->iopool_ = std::make_unique<user_iopool<IoContextPointerContainer>>(
 				std::forward<IoContextPointerContainer>(ios));
 
-			this->iopool_->for_each([this](asio::io_context& ioc) mutable
-			{
-				this->iots_.emplace_back(&ioc);
-			});
+			this->_init_iots();
 		}
 
 		template<class IoContextPointer, std::enable_if_t<
@@ -622,10 +1033,7 @@ namespace asio2::detail
 
 			this->iopool_ = std::make_unique<user_iopool<container>>(std::move(ios));
 
-			this->iopool_->for_each([this](asio::io_context& ioc) mutable
-			{
-				this->iots_.emplace_back(&ioc);
-			});
+			this->_init_iots();
 		}
 
 		template<class IoContextRefrence, std::enable_if_t<
@@ -639,10 +1047,7 @@ namespace asio2::detail
 
 			this->iopool_ = std::make_unique<user_iopool<container>>(std::move(ios));
 
-			this->iopool_->for_each([this](asio::io_context& ioc) mutable
-			{
-				this->iots_.emplace_back(&ioc);
-			});
+			this->_init_iots();
 		}
 
 		//template<class UserCustomExecutors>
@@ -655,11 +1060,159 @@ namespace asio2::detail
 
 		inline iopool_base& iopool() { return (*(this->iopool_)); }
 
+		/**
+		 * @function : get the load counters of the io_context by index, the count of the
+		 * io_contexts is iopool().size(), it can be used to see the load skew of the threads.
+		 */
+		inline const io_load& load(std::size_t index)
+		{
+			ASIO2_ASSERT(index < this->iots_.size());
+
+			return this->iots_[index].load();
+		}
+
+		/**
+		 * @function : get the metrics of all the io_contexts, the metrics of each io_context
+		 * are merged into one snapshot, it can be called in any thread.
+		 * eg : printf("%s", server.metrics().to_prometheus().data());
+		 */
+		inline metrics_snapshot metrics()
+		{
+			metrics_snapshot s;
+
+			for (io_t& io : this->iots_)
+			{
+				io.metrics().collect(s);
+			}
+
+			return s;
+		}
+
 	protected:
+		inline void _init_iots()
+		{
+			std::size_t index = 0;
+
+			this->iopool_->for_each([this, &index](asio::io_context& ioc) mutable
+			{
+				this->iots_.emplace_back(&ioc, this->iopool_->load(index++));
+			});
+		}
+
+		/**
+		 * @function : set the policy to choose the io_context for a new session, the busy time
+		 * of the threads is measured if the policy is least_busy.
+		 */
+		inline void _io_placement(io_placement policy)
+		{
+			this->placement_ = policy;
+
+			if (policy == io_placement::least_busy)
+				this->iopool_->measure_busy_time(true);
+		}
+
+		/**
+		 * @function : set the user custom policy to choose the io_context for a new session,
+		 * the function is like this : std::size_t(std::vector<io_t>& iots), returns the index.
+		 */
+		inline void _io_placement(std::function<std::size_t(std::vector<io_t>&)> policy)
+		{
+			this->custom_placement_ = std::move(policy);
+		}
+
+		inline void _timer_granularity(std::chrono::milliseconds granularity)
+		{
+			for (io_t& io : this->iots_)
+			{
+				io.timer_granularity(granularity);
+			}
+		}
+
+
 		inline io_t& _get_io(std::size_t index = static_cast<std::size_t>(-1))
 		{
+			if (index < this->iots_.size())
+				return this->iots_[index];
+
+			if (this->custom_placement_)
+			{
+				index = this->custom_placement_(this->iots_);
+
+				if (index < this->iots_.size())
+					return this->iots_[index];
+			}
+
 			// Use a round-robin scheme to choose the next io_context to use. 
-			return this->iots_[index < this->iots_.size() ? index : ((++(this->next_)) % this->iots_.size())];
+			index = (++(this->next_)) % this->iots_.size();
+
+			if (this->placement_ == io_placement::round_robin)
+				return this->iots_[index];
+
+			std::uint64_t per_session = 0;
+
+			if (this->placement_ == io_placement::least_busy)
+				per_session = this->_busy_time_per_session();
+
+			// begin at the next io_context of the round-robin, so the io_contexts which have
+			// the same load are used in turn.
+			std::size_t best = index;
+
+			for (std::size_t n = 1; n < this->iots_.size(); ++n)
+			{
+				std::size_t i = (index + n) % this->iots_.size();
+
+				if (this->_io_less(this->iots_[i].load(), this->iots_[best].load(), per_session))
+					best = i;
+			}
+
+			return this->iots_[best];
+		}
+
+		/**
+		 * the average busy time of a session in the last second, at least 1 nanosecond, so the
+		 * sessions which are placed in the same second are still spread even if all are idle.
+		 */
+		inline std::uint64_t _busy_time_per_session() noexcept
+		{
+			std::uint64_t busy = 0, sessions = 0;
+
+			for (io_t& io : this->iots_)
+			{
+				busy     += io.load().recent_busy_time.load(std::memory_order_relaxed);
+				sessions += io.load().recent_sessions .load(std::memory_order_relaxed);
+			}
+
+			return (std::max)(busy / (std::max)(sessions, std::uint64_t(1)), std::uint64_t(1));
+		}
+
+		/**
+		 * the busy time of the last second, and the sessions which are placed or closed after
+		 * it are added or subtracted by the average busy time of a session, otherwise all the
+		 * sessions which are accepted in the same second are placed in the same io_context.
+		 */
+		static inline std::uint64_t _estimated_busy_time(io_load& load, std::uint64_t per_session) noexcept
+		{
+			std::int64_t busy = static_cast<std::int64_t>(load.recent_busy_time.load(std::memory_order_relaxed));
+			std::int64_t diff =
+				static_cast<std::int64_t>(load.sessions       .load(std::memory_order_relaxed)) -
+				static_cast<std::int64_t>(load.recent_sessions.load(std::memory_order_relaxed));
+
+			return static_cast<std::uint64_t>((std::max)(
+				busy + diff * static_cast<std::int64_t>(per_session), std::int64_t(0)));
+		}
+
+		inline bool _io_less(io_load& a, io_load& b, std::uint64_t per_session) const noexcept
+		{
+			if (this->placement_ == io_placement::least_busy)
+			{
+				std::uint64_t x = _estimated_busy_time(a, per_session);
+				std::uint64_t y = _estimated_busy_time(b, per_session);
+
+				if (x != y)
+					return (x < y);
+			}
+
+			return (a.sessions.load(std::memory_order_relaxed) < b.sessions.load(std::memory_order_relaxed));
 		}
 
 	protected:
@@ -671,12 +1224,21 @@ namespace asio2::detail
 
 		/// The next io_context to use for a connection. 
 		std::size_t                  next_ = 0;
+
+		/// the policy to choose the io_context for a new session
+		io_placement                 placement_ = io_placement::round_robin;
+
+		/// the user custom policy to choose the io_context for a new session
+		std::function<std::size_t(std::vector<io_t>&)> custom_placement_;
 	};
 }
 
 namespace asio2
 {
 	using iopool = detail::iopool;
+
+	using io_load      = detail::io_load;
+	using io_placement = detail::io_placement;
 }
 
 #endif // !__ASIO2_IOPOOL_HPP__
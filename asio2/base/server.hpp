@@ -85,7 +85,7 @@ namespace asio2::detail
 			, wallocator_()
 			, listener_  ()
 			, io_        (iopool_cp::_get_io(0))
-			, sessions_  (io_, this->state_)
+			, sessions_  (io_, this->state_, this->iots_)
 		{
 		}
 
@@ -212,6 +212,59 @@ namespace asio2::detail
 			return this->derived();
 		}
 
+		/**
+		 * @function : Asynchronous send the same data to each session, the data is copied only
+		 * once into a reference counted immutable buffer, then all sessions share the buffer
+		 * until their sends are completed, so the memory and copy cost is not grow with the
+		 * session count. It's more efficient than async_send(...) when there are many sessions.
+		 * You can call this function on the communication thread and anywhere,it's multi thread safed.
+		 * std::string m; broadcast(std::move(m)); // no copy at all
+		 * asio2::shared_buffer m(...); broadcast(m);
+		 */
+		template<class DataT>
+		inline derived_t & broadcast(DataT&& data)
+		{
+			if constexpr (detail::is_shared_buffer_v<DataT>)
+			{
+				// if the sessions are stored in multi shards, send the data in the shards' threads
+				// at the same time.
+				if (this->sessions_.shards() > 1)
+				{
+					this->sessions_.parallel_for_each([data](std::shared_ptr<session_t>& session_ptr) mutable
+					{
+						session_ptr->async_send(data);
+					});
+				}
+				else
+				{
+					this->sessions_.for_each([&data](std::shared_ptr<session_t>& session_ptr) mutable
+					{
+						session_ptr->async_send(data);
+					});
+				}
+				return this->derived();
+			}
+			else
+			{
+				return this->broadcast(shared_buffer(std::forward<DataT>(data)));
+			}
+		}
+
+		/**
+		 * @function : Asynchronous send the same data to each session, see broadcast(DataT&& data)
+		 * PodType (&data)[N] : double m[10]; broadcast(m,5);
+		 */
+		template<class CharT, class SizeT>
+		inline typename std::enable_if_t<std::is_integral_v<detail::remove_cvref_t<SizeT>>, derived_t&>
+			broadcast(CharT* s, SizeT count)
+		{
+			if (s)
+			{
+				this->broadcast(shared_buffer(static_cast<const void*>(s), count * sizeof(CharT)));
+			}
+			return this->derived();
+		}
+
 	public:
 		/**
 		 * @function : get the acceptor refrence,derived classes must override this function
@@ -290,6 +343,53 @@ namespace asio2::detail
 		 */
 		inline io_t & io() { return this->io_; }
 
+		/**
+		 * @function : set the granularity of the coarse timer wheel of the io_contexts, then the
+		 * silence timer, the connect timeout timer and the rpc call timeout timer are registered
+		 * to the timer wheel of the io_context instead of owning an asio::steady_timer each. It's
+		 * useful when there are a large number of mostly idle sessions, the cost is that these
+		 * timers maybe expired one granularity later. zero means disabled, the default is disabled.
+		 * must be called before start.
+		 * eg : timer_granularity(std::chrono::milliseconds(100));
+		 */
+		template<class Rep, class Period>
+		inline derived_t & timer_granularity(std::chrono::duration<Rep, Period> granularity)
+		{
+			this->_timer_granularity(std::chrono::duration_cast<std::chrono::milliseconds>(granularity));
+			return this->derived();
+		}
+
+		/**
+		 * @function : get the granularity of the coarse timer wheel
+		 */
+		inline std::chrono::milliseconds timer_granularity() { return this->io_.timer_granularity(); }
+
+		/**
+		 * @function : set the policy to choose the io_context for a new session, see io_placement,
+		 * the default is round_robin. must be called before start. it's not used for the tcp
+		 * server which is started with asio2::reuse_port.
+		 * eg : session_placement(asio2::io_placement::least_sessions);
+		 */
+		inline derived_t & session_placement(io_placement policy)
+		{
+			this->_io_placement(policy);
+			return this->derived();
+		}
+
+		/**
+		 * @function : set the user custom policy to choose the io_context for a new session,
+		 * the load counters of each io_context can be got by iots[i].load(). must be called
+		 * before start.
+		 * Function signature : std::size_t(std::vector<asio2::detail::io_t>& iots)
+		 * @return   : the index of the io_context, if the index is invalid, the placement policy
+		 * which is set by session_placement(io_placement) is used.
+		 */
+		inline derived_t & session_placement(std::function<std::size_t(std::vector<io_t>&)> policy)
+		{
+			this->_io_placement(std::move(policy));
+			return this->derived();
+		}
+
 	protected:
 		/**
 		 * @function : get the recv/read allocator object refrence
@@ -129,7 +129,11 @@ namespace asio2::detail
 			, listener_(listener)
 			, io_      (rwio)
 			, buffer_  (init_buf_size, max_buf_size)
+			, load_    (rwio.load_ptr())
 		{
+			// count the session in the io_context, it's used by the session placement policy.
+			this->load_->sessions.fetch_add(1, std::memory_order_relaxed);
+			this->load_->placed  .fetch_add(1, std::memory_order_relaxed);
 		}
 
 		/**
@@ -151,6 +155,8 @@ namespace asio2::detail
 			// rpc_invoker call "caller->io().strand()", it will be crashed.
 			// destroy the counter
 			this->counter_ptr_.reset();
+
+			this->load_->sessions.fetch_sub(1, std::memory_order_relaxed);
 		}
 
 	protected:
@@ -207,6 +213,10 @@ namespace asio2::detail
 			// close all async_events
 			this->notify_all_events();
 
+			// execute the events which are pushed from the other threads, they hold the self
+			// shared_ptr, if they are left in the lock free queue, will cause loop refrence.
+			this->_drain_mpsc_events();
+
 			// destroy user data, maybe the user data is self shared_ptr, 
 			// if don't destroy it, will cause loop refrence.
 			this->user_data_.reset();
@@ -301,6 +311,9 @@ namespace asio2::detail
 
 		/// Remote call (rpc/rdc) response timeout.
 		std::chrono::steady_clock::duration  rc_timeout_   = std::chrono::milliseconds(http_execute_timeout);
+
+		/// the load counters of the io, the session may be destroyed after the server, so hold it.
+		std::shared_ptr<io_load>             load_;
 	};
 }
 
@@ -15,10 +15,13 @@
 #pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include <cstdint>
 #include <algorithm>
 #include <memory>
 #include <functional>
 #include <unordered_map>
+#include <vector>
+#include <atomic>
 #include <type_traits>
 
 #include <asio2/3rd/asio.hpp>
@@ -40,6 +43,11 @@ namespace asio2::detail
 
 	/**
 	 * the session manager interface
+	 * The sessions are stored in N shards, the shard of a session is selected by the hash of the
+	 * session's key, each shard has its own map and lock, and is owned by its own io_context of
+	 * the iopool, the emplace and erase operations of a shard are executed in the shard's io_context
+	 * thread, and the accept/connect/disconnect notifications of a session are fired in that thread
+	 * too. The default shard count is 1, then all the sessions are managed in the thread 0.
 	 */
 	template<class session_t>
 	class session_mgr_t
@@ -54,15 +62,37 @@ namespace asio2::detail
 	public:
 		using self     = session_mgr_t<session_t>;
 		using key_type = typename session_t::key_type;
+		using map_type = std::unordered_map<key_type, std::shared_ptr<session_t>>;
+
+		struct shard
+		{
+			explicit shard(io_t& io_ref) : io(io_ref)
+			{
+				this->sessions.reserve(64);
+			}
+
+			/// session unorder map,these session is already connected session 
+			map_type                                  sessions;
+
+			/// use rwlock to make this session map thread safe
+			asio2_shared_mutex                        mutex;
+
+			/// the io_context which this shard is owned by
+			io_t                                    & io;
+
+			/// The memory to use for handler-based custom memory allocation.
+			handler_memory<size_op<>, std::true_type> allocator;
+		};
 
 		/**
 		 * @constructor
 		 */
-		explicit session_mgr_t(io_t& acceptor_io, std::atomic<state_t>& server_state)
+		explicit session_mgr_t(io_t& acceptor_io, std::atomic<state_t>& server_state, std::vector<io_t>& iots)
 			: io_   (acceptor_io )
 			, state_(server_state)
+			, iots_ (iots        )
 		{
-			this->sessions_.reserve(64);
+			this->shards_.emplace_back(std::make_unique<shard>(this->io_));
 		}
 
 		/**
@@ -70,6 +100,46 @@ namespace asio2::detail
 		 */
 		~session_mgr_t() = default;
 
+		/**
+		 * @function : set the shard count, it can only be called when the server is stopped.
+		 * if the count is 0, the shard count will be equal to the iopool's size. the shard i
+		 * is owned by the io_context i % iopool's size.
+		 */
+		inline self& shards(std::size_t count)
+		{
+			ASIO2_ASSERT(this->state_ == state_t::stopped && this->empty());
+
+			if (this->state_ != state_t::stopped || !this->empty())
+			{
+				set_last_error(asio::error::in_progress);
+				return (*this);
+			}
+
+			if (count == 0)
+				count = this->iots_.size();
+
+			if (count == 0)
+				count = 1;
+
+			this->shards_.clear();
+
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				this->shards_.emplace_back(std::make_unique<shard>(
+					i == 0 ? this->io_ : this->iots_[i % this->iots_.size()]));
+			}
+
+			return (*this);
+		}
+
+		/**
+		 * @function : get the shard count
+		 */
+		inline std::size_t shards() const noexcept
+		{
+			return this->shards_.size();
+		}
+
 		/**
 		 * @function : emplace the session
 		 * @callback : void(bool inserted);
@@ -80,9 +150,11 @@ namespace asio2::detail
 			if (!session_ptr)
 				return;
 
-			if (!this->io_.strand().running_in_this_thread())
+			shard& s = this->_get_shard(session_ptr->hash_key());
+
+			if (!s.io.strand().running_in_this_thread())
 			{
-				asio::post(this->io_.strand(), make_allocator(this->allocator_,
+				asio::post(s.io.strand(), make_allocator(s.allocator,
 				[this, session_ptr = std::move(session_ptr), callback = std::forward<Fun>(callback)]
 				() mutable
 				{
@@ -93,49 +165,36 @@ namespace asio2::detail
 
 			bool inserted = false;
 
-			// when run to here, the server state maybe started or stopping or stopped, 
-			// if server state is not started, must can't push the session to the map
-			// again, and we need disconnect the session directly, otherwise the server
-			// maybe stopping, and the iopool's wait_iothreas is running in the "sleep"
-			// this will cause the server.stop() never return;
-			if (this->state_ == state_t::started)
 			{
-				// when code run to here, user maybe call server.stop() at other thread,
-				// if user do this, at this time, the state_ is not started already( it
-				// will be stopping ), but beacuase the server's sessions_.for_each -> 
-				// session_ptr->stop(); is execute in the thread 0, and this code is 
-				// executed in thread 0 too, so when code run to here, beacuse we have
-				// " if (this->state_ == state_t::started) " judgment statement, so the
-				// server's sessions_.for_each -> session_ptr->stop(); must not be
-				// executed yet, so even if we put the session in the map here, it will
-				// not have a problem, beacuse the server's sessions_.for_each -> 
-				// session_ptr->stop(); will be called a later, and this session will be 
-				// stopped at there.
-
-				// we use a assert to check the server's sessions_.for_each -> 
-				// session_ptr->stop(); must not be executed yet.
-			#if defined(ASIO2_ENABLE_LOG)
-				if (is_all_session_stop_called_)
+				// the server state must be checked in the lock.
+				// when run to here, the server state maybe started or stopping or stopped, 
+				// if server state is not started, must can't push the session to the map
+				// again, and we need disconnect the session directly, otherwise the server
+				// maybe stopping, and the iopool's wait_iothreas is running in the "sleep"
+				// this will cause the server.stop() never return;
+				// when user call server.stop() at other thread, the state_ is changed to
+				// stopping first, then the server's sessions_.for_each -> session_ptr->stop()
+				// is called in the thread 0, it must acquire the shard lock too, so if the
+				// state is started here, the server's for_each of this shard must not be 
+				// executed yet, and this session will be stopped at there later.
+				asio2_unique_lock guard(s.mutex);
+
+				if (this->state_ == state_t::started)
 				{
-					ASIO2_LOG(spdlog::level::critical, "server's sessions stop is called already. 1");
+				#if defined(ASIO2_ENABLE_LOG)
+					if (is_all_session_stop_called_)
+					{
+						ASIO2_LOG(spdlog::level::critical, "server's sessions stop is called already. 1");
+					}
+					ASIO2_ASSERT(is_all_session_stop_called_ == false);
+				#endif
+
+					inserted = s.sessions.try_emplace(session_ptr->hash_key(), session_ptr).second;
+					session_ptr->in_sessions_ = inserted;
+
+					if (inserted)
+						this->size_.fetch_add(1);
 				}
-				ASIO2_ASSERT(is_all_session_stop_called_ == false);
-			#endif
-
-				// this thread is same as the server's io thread, when code run to here,
-				// the server's _post_stop must not be executed, so the server's sessions_.for_each
-				// -> session_ptr->stop() must not be executed.
-				asio2_unique_lock guard(this->mutex_);
-				inserted = this->sessions_.try_emplace(session_ptr->hash_key(), session_ptr).second;
-				session_ptr->in_sessions_ = inserted;
-
-			#if defined(ASIO2_ENABLE_LOG)
-				if (is_all_session_stop_called_)
-				{
-					ASIO2_LOG(spdlog::level::critical, "server's sessions stop is called already. 2");
-				}
-				ASIO2_ASSERT(is_all_session_stop_called_ == false);
-			#endif
 			}
 
 			(callback)(inserted);
@@ -151,9 +210,11 @@ namespace asio2::detail
 			if (!session_ptr)
 				return;
 
-			if (!this->io_.strand().running_in_this_thread())
+			shard& s = this->_get_shard(session_ptr->hash_key());
+
+			if (!s.io.strand().running_in_this_thread())
 			{
-				asio::post(this->io_.strand(), make_allocator(this->allocator_,
+				asio::post(s.io.strand(), make_allocator(s.allocator,
 				[this, session_ptr = std::move(session_ptr), callback = std::forward<Fun>(callback)]
 				() mutable
 				{
@@ -165,9 +226,12 @@ namespace asio2::detail
 			bool erased = false;
 
 			{
-				asio2_unique_lock guard(this->mutex_);
+				asio2_unique_lock guard(s.mutex);
 				if (session_ptr->in_sessions_)
-					erased = (this->sessions_.erase(session_ptr->hash_key()) > 0);
+					erased = (s.sessions.erase(session_ptr->hash_key()) > 0);
+
+				if (erased)
+					this->size_.fetch_sub(1);
 			}
 
 			(callback)(erased);
@@ -180,7 +244,8 @@ namespace asio2::detail
 		template<class Fun>
 		inline void post(Fun&& task)
 		{
-			asio::post(this->io_.strand(), make_allocator(this->allocator_, std::forward<Fun>(task)));
+			shard& s = *(this->shards_.front());
+			asio::post(s.io.strand(), make_allocator(s.allocator, std::forward<Fun>(task)));
 		}
 
 		/**
@@ -190,7 +255,32 @@ namespace asio2::detail
 		template<class Fun>
 		inline void dispatch(Fun&& task)
 		{
-			asio::dispatch(this->io_.strand(), make_allocator(this->allocator_, std::forward<Fun>(task)));
+			shard& s = *(this->shards_.front());
+			asio::dispatch(s.io.strand(), make_allocator(s.allocator, std::forward<Fun>(task)));
+		}
+
+		/**
+		 * @function : Submits a completion token or function object for execution in the
+		 *             thread of the shard which the session key belongs to.
+		 * @task : void();
+		 */
+		template<class Fun>
+		inline void post(const key_type & key, Fun&& task)
+		{
+			shard& s = this->_get_shard(key);
+			asio::post(s.io.strand(), make_allocator(s.allocator, std::forward<Fun>(task)));
+		}
+
+		/**
+		 * @function : Submits a completion token or function object for execution in the
+		 *             thread of the shard which the session key belongs to.
+		 * @task : void();
+		 */
+		template<class Fun>
+		inline void dispatch(const key_type & key, Fun&& task)
+		{
+			shard& s = this->_get_shard(key);
+			asio::dispatch(s.io.strand(), make_allocator(s.allocator, std::forward<Fun>(task)));
 		}
 
 		/**
@@ -201,12 +291,42 @@ namespace asio2::detail
 		template<class Fun>
 		inline void for_each(Fun&& fn)
 		{
-			asio2_shared_lock guard(this->mutex_);
-			for (auto &[k, session_ptr] : this->sessions_)
+			for (std::unique_ptr<shard>& s : this->shards_)
 			{
-				std::ignore = k;
+				asio2_shared_lock guard(s->mutex);
+				for (auto &[k, session_ptr] : s->sessions)
+				{
+					std::ignore = k;
 
-				fn(session_ptr);
+					fn(session_ptr);
+				}
+			}
+		}
+
+		/**
+		 * @function : call user custom callback function for every session, the sessions of 
+		 * each shard are iterated in the shard's own thread, so the shards are iterated in
+		 * parallel. this function returns immediately, the callback function is copied for 
+		 * each shard, and may be called in multi threads at the same time.
+		 * the custom callback function is like this :
+		 * void on_callback(std::shared_ptr<tcp_session> & session_ptr)
+		 */
+		template<class Fun>
+		inline void parallel_for_each(Fun&& fn)
+		{
+			for (std::unique_ptr<shard>& sp : this->shards_)
+			{
+				shard& s = *sp;
+				asio::post(s.io.strand(), make_allocator(s.allocator, [&s, fn]() mutable
+				{
+					asio2_shared_lock guard(s.mutex);
+					for (auto &[k, session_ptr] : s.sessions)
+					{
+						std::ignore = k;
+
+						fn(session_ptr);
+					}
+				}));
 			}
 		}
 
@@ -215,9 +335,10 @@ namespace asio2::detail
 		 */
 		inline std::shared_ptr<session_t> find(const key_type & key)
 		{
-			asio2_shared_lock guard(this->mutex_);
-			auto iter = this->sessions_.find(key);
-			return (iter == this->sessions_.end() ? std::shared_ptr<session_t>() : iter->second);
+			shard& s = this->_get_shard(key);
+			asio2_shared_lock guard(s.mutex);
+			auto iter = s.sessions.find(key);
+			return (iter == s.sessions.end() ? std::shared_ptr<session_t>() : iter->second);
 		}
 
 		/**
@@ -227,13 +348,18 @@ namespace asio2::detail
 		template<class Fun>
 		inline std::shared_ptr<session_t> find_if(Fun&& fn)
 		{
-			asio2_shared_lock guard(this->mutex_);
-			auto iter = std::find_if(this->sessions_.begin(), this->sessions_.end(),
-			[this, &fn](auto &pair) mutable
+			for (std::unique_ptr<shard>& s : this->shards_)
 			{
-				return fn(pair.second);
-			});
-			return (iter == this->sessions_.end() ? std::shared_ptr<session_t>() : iter->second);
+				asio2_shared_lock guard(s->mutex);
+				auto iter = std::find_if(s->sessions.begin(), s->sessions.end(),
+				[this, &fn](auto &pair) mutable
+				{
+					return fn(pair.second);
+				});
+				if (iter != s->sessions.end())
+					return iter->second;
+			}
+			return std::shared_ptr<session_t>();
 		}
 
 		/**
@@ -241,7 +367,7 @@ namespace asio2::detail
 		 */
 		inline std::size_t size()
 		{
-			return this->sessions_.size();
+			return this->size_.load();
 		}
 
 		/**
@@ -249,7 +375,7 @@ namespace asio2::detail
 		 */
 		inline bool empty()
 		{
-			return this->sessions_.empty();
+			return (this->size() == 0);
 		}
 
 		/**
@@ -260,22 +386,47 @@ namespace asio2::detail
 			return this->io_;
 		}
 
+		/**
+		 * @function : get the io object refrence of the shard which the session key belongs to,
+		 * the session's accept/connect/disconnect notifications are fired in this io's thread.
+		 */
+		inline io_t & io(const key_type & key)
+		{
+			return this->_get_shard(key).io;
+		}
+
 	protected:
-		/// session unorder map,these session is already connected session 
-		std::unordered_map<key_type, std::shared_ptr<session_t>> sessions_;
+		inline shard& _get_shard(const key_type & key)
+		{
+			if (this->shards_.size() == 1)
+				return *(this->shards_.front());
+
+			// the std::hash of integer is the integer itself in some implementations, and the tcp
+			// session key is the object address which is aligned, so mix the bits before modulo.
+			std::uint64_t h = static_cast<std::uint64_t>(this->hasher_(key)) * 0x9E3779B97F4A7C15ull;
 
-		/// use rwlock to make this session map thread safe
-		asio2_shared_mutex                        mutex_;
+			return *(this->shards_[static_cast<std::size_t>(h >> 32) % this->shards_.size()]);
+		}
+
+	protected:
+		/// the session shards, the shard count can only be changed when the server is stopped.
+		std::vector<std::unique_ptr<shard>>       shards_;
+
+		/// the hasher to select the shard by the session key
+		typename map_type::hasher                 hasher_;
+
+		/// the session count of all shards
+		std::atomic<std::size_t>                  size_{ 0 };
 
 		/// the zero io_context refrence in the iopool
 		io_t                                    & io_;
 
-		/// The memory to use for handler-based custom memory allocation.
-		handler_memory<size_op<>, std::true_type> allocator_;
-
 		/// server state refrence
 		std::atomic<state_t>                    & state_;
 
+		/// all the io_context refrence in the iopool
+		std::vector<io_t>                       & iots_;
+
 	#if defined(ASIO2_ENABLE_LOG)
 		bool                                      is_all_session_stop_called_ = false;
 	#endif
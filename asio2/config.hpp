@@ -43,4 +43,21 @@
 // Whether enable internal logging of asio2
 //#define ASIO2_ENABLE_LOG
 
+// Thread per core mode, each io_context of the iopool is run by only one thread, so the strand
+// of each io_context is elided and the executor of the io_context is used directly, there is no
+// strand queueing and locking for the handlers. If you pass your own io_context to the server or
+// client, it must be created with concurrency hint 1 and must be run by only one thread.
+//#define ASIO2_THREAD_PER_CORE
+
+// The handlers which can't use the handler memory of the session, the event queue nodes and the
+// persisted send data are allocated from a size classed slab cache of each io_context thread, the
+// statistics can be got by asio2::slab_statistics(). Define this macro to allocate them from the
+// global heap directly, eg: for the memory checking tools.
+//#define ASIO2_DISABLE_SLAB_ALLOCATOR
+
+// The servers and the clients count the bytes and the messages, the send queue depth, the accepts,
+// the recv handler latency and so on for each io_context, they can be got by server.metrics(), and
+// the http_server can export them by bind_metrics("/metrics"). Define this macro to disable them.
+//#define ASIO2_DISABLE_METRICS
+
 #endif // !__ASIO2_CONFIG_HPP__
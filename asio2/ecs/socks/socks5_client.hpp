@@ -58,7 +58,7 @@ namespace asio2::detail
 
 	public:
 		asio::io_context        & context_;
-		asio::io_context::strand& strand_;
+		io_strand_t& strand_;
 
 		std::string    host_{}, port_{};
 
@@ -77,7 +77,7 @@ namespace asio2::detail
 
 		template<class SKT, class S5, class H>
 		socks5_client_connect_op(
-			asio::io_context& context, asio::io_context::strand& strand,
+			asio::io_context& context, io_strand_t& strand,
 			std::string host, std::string port,
 			SKT& skt, S5 s5, H&& h
 		)
@@ -568,7 +568,7 @@ namespace asio2::detail
 
 	// C++17 class template argument deduction guides
 	template<class SKT, class S5, class H>
-	socks5_client_connect_op(asio::io_context&, asio::io_context::strand&, std::string, std::string,
+	socks5_client_connect_op(asio::io_context&, io_strand_t&, std::string, std::string,
 		SKT&, S5, H)->socks5_client_connect_op<SKT, S5, H>;
 
 	template<class derived_t, class args_t>
@@ -80,7 +80,7 @@ namespace asio2::detail
 			}
 			else
 			{
-				ASIO2_ASSERT(derive.sessions().io().strand().running_in_this_thread());
+				ASIO2_ASSERT(derive.sessions().io(derive.hash_key()).strand().running_in_this_thread());
 			}
 
 			this->ws_stream_ = std::make_unique<stream_type>(socket);
@@ -404,7 +404,7 @@ namespace asio2::detail
 			{
 				// Use "sessions().dispatch" to ensure that the _fire_accept function and the _fire_upgrade
 				// function are fired in the same thread
-				derive.sessions().dispatch(
+				derive.sessions().dispatch(derive.hash_key(),
 				[&derive, ec, this_ptr = std::move(this_ptr), condition = std::move(condition)]
 				() mutable
 				{
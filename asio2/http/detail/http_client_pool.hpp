@@ -0,0 +1,798 @@
+/*
+ * COPYRIGHT (C) 2017-2021, zhllxt
+ *
+ * author   : zhllxt
+ * email    : 37792738@qq.com
+ *
+ * Distributed under the GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+ * (See accompanying file LICENSE or see <http://www.gnu.org/licenses/>)
+ */
+
+#ifndef __ASIO2_HTTP_CLIENT_POOL_HPP__
+#define __ASIO2_HTTP_CLIENT_POOL_HPP__
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+#pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <asio2/base/iopool.hpp>
+
+#include <asio2/http/detail/http_util.hpp>
+
+namespace asio2::detail
+{
+	/**
+	 * The counters of the http client pool.
+	 */
+	struct http_client_pool_stats
+	{
+		/// the count of the requests which are sent on a reused keep-alive connection
+		std::uint64_t hits       = 0;
+
+		/// the count of the requests which need a new connection
+		std::uint64_t misses     = 0;
+
+		/// the count of the reused connections which has been closed by the server already, the
+		/// request is sent again on a new connection.
+		std::uint64_t retries    = 0;
+
+		/// the count of the host names which are found in the dns cache
+		std::uint64_t dns_hits   = 0;
+
+		/// the count of the host names which are resolved by the resolver
+		std::uint64_t dns_misses = 0;
+
+		/// the count of the keep-alive connections which are idle in the pool now
+		std::uint64_t idle       = 0;
+	};
+
+	/**
+	 * The pool of the blocking http and https execute calls, it is owned by the caller and must be
+	 * started before the first execute and stopped before the objects which are used by the calls
+	 * are destroyed, eg :
+	 *   asio2::http_client_pool pool;
+	 *   pool.start();
+	 *   auto rep = pool.execute("127.0.0.1", "8080", req, std::chrono::seconds(5), ec);
+	 *   pool.stop();
+	 * The execute calls are run on the io_contexts of this pool instead of a new io_context per
+	 * call, the resolved endpoints are cached with a ttl, and the keep-alive connections are
+	 * reused by the key of (host, port, http or https). Only the https connections
+	 * of the default_ssl_context are reused, the connections of a caller supplied ssl context are
+	 * closed after the call, because the pool can't know whether the context is still alive or has
+	 * been changed at the next call.
+	 * The connections which are idle longer than the idle timeout are closed when they are
+	 * acquired. If a reused connection was closed by the server already and nothing of the
+	 * response is recved, the request is sent again on a new connection once, if nothing of the
+	 * request was sent or the method of the request is idempotent.
+	 * This class is thread safed. The execute is blocking, so it fails with operation_not_supported
+	 * if it is called in the threads of this pool, eg : in a handler of another execute.
+	 */
+	class http_client_pool
+	{
+	public:
+		using clock_type     = std::chrono::steady_clock;
+		using resolver_type  = asio::ip::tcp::resolver;
+		using endpoints_type = asio::ip::tcp::resolver::results_type;
+		using socket_type    = asio::ip::tcp::socket;
+
+	#if defined(ASIO2_USE_SSL)
+		using ssl_stream_type = asio::ssl::stream<socket_type&>;
+	#endif
+
+		/**
+		 * The connection which is cached in the pool.
+		 */
+		struct connection
+		{
+			explicit connection(asio::io_context& ioc) : strand(make_io_strand(ioc)), socket(ioc) {}
+
+			io_strand_t                      strand;
+
+			socket_type                      socket;
+
+		#if defined(ASIO2_USE_SSL)
+			std::unique_ptr<ssl_stream_type> ssl_stream;
+		#endif
+
+			clock_type::time_point           idle_since{};
+		};
+
+		/**
+		 * @constructor
+		 */
+		http_client_pool() = default;
+
+		/**
+		 * @destructor
+		 */
+		~http_client_pool()
+		{
+			this->stop();
+		}
+
+		http_client_pool(http_client_pool&&) = delete;
+		http_client_pool(http_client_pool const&) = delete;
+		http_client_pool& operator=(http_client_pool&&) = delete;
+		http_client_pool& operator=(http_client_pool const&) = delete;
+
+		/**
+		 * @function : start the threads of the pool, the execute fails with shut_down if the pool
+		 * is not started.
+		 */
+		inline bool start()
+		{
+			std::unique_lock<std::mutex> lock(this->mtx_);
+
+			if (this->iopool_)
+				return false;
+
+			this->iopool_ = std::make_unique<iopool>(this->thread_count_);
+
+			return this->iopool_->start();
+		}
+
+		/**
+		 * @function : close the idle connections and stop the threads of the pool, the execute
+		 * calls which are running are completed before it returns. It must not be called in the
+		 * threads of this pool.
+		 */
+		inline void stop()
+		{
+			this->clear();
+
+			std::unique_ptr<iopool> iop;
+
+			{
+				std::unique_lock<std::mutex> lock(this->mtx_);
+				iop = std::move(this->iopool_);
+			}
+
+			// the mutex can't be held while waiting for the pending handlers, they may lock it too.
+			if (iop)
+			{
+				ASIO2_ASSERT(!iop->running_in_threads());
+
+				iop->stop();
+			}
+		}
+
+		/**
+		 * @function : check whether the pool is started
+		 */
+		inline bool is_started()
+		{
+			std::unique_lock<std::mutex> lock(this->mtx_);
+			return bool(this->iopool_);
+		}
+
+		/**
+		 * @function : set the thread count of the pool, it must be called before start.
+		 */
+		inline http_client_pool& thread_count(std::size_t count)
+		{
+			std::unique_lock<std::mutex> lock(this->mtx_);
+
+			ASIO2_ASSERT(!this->iopool_);
+
+			this->thread_count_ = (std::max)(count, std::size_t(1));
+
+			return (*this);
+		}
+
+		/**
+		 * @function : get the thread count of the pool
+		 */
+		inline std::size_t thread_count()
+		{
+			std::unique_lock<std::mutex> lock(this->mtx_);
+			return this->thread_count_;
+		}
+
+		/**
+		 * @function : set the max count of the idle connections of each (host, port, http or https),
+		 * 0 means the connections are not reused.
+		 */
+		inline http_client_pool& max_idle(std::size_t count)
+		{
+			std::unique_lock<std::mutex> lock(this->mtx_);
+			this->max_idle_ = count;
+			return (*this);
+		}
+
+		/**
+		 * @function : get the max count of the idle connections of each (host, port, http or https)
+		 */
+		inline std::size_t max_idle()
+		{
+			std::unique_lock<std::mutex> lock(this->mtx_);
+			return this->max_idle_;
+		}
+
+		/**
+		 * @function : set the time that the idle connection can be reused
+		 */
+		template<class Rep, class Period>
+		inline http_client_pool& idle_timeout(std::chrono::duration<Rep, Period> duration)
+		{
+			std::unique_lock<std::mutex> lock(this->mtx_);
+			this->idle_timeout_ = std::chrono::duration_cast<clock_type::duration>(duration);
+			return (*this);
+		}
+
+		/**
+		 * @function : get the time that the idle connection can be reused
+		 */
+		inline clock_type::duration idle_timeout()
+		{
+			std::unique_lock<std::mutex> lock(this->mtx_);
+			return this->idle_timeout_;
+		}
+
+		/**
+		 * @function : set the time that the resolved endpoints are cached, 0 means no cache.
+		 */
+		template<class Rep, class Period>
+		inline http_client_pool& dns_ttl(std::chrono::duration<Rep, Period> duration)
+		{
+			std::unique_lock<std::mutex> lock(this->mtx_);
+			this->dns_ttl_ = std::chrono::duration_cast<clock_type::duration>(duration);
+			return (*this);
+		}
+
+		/**
+		 * @function : get the time that the resolved endpoints are cached
+		 */
+		inline clock_type::duration dns_ttl()
+		{
+			std::unique_lock<std::mutex> lock(this->mtx_);
+			return this->dns_ttl_;
+		}
+
+		/**
+		 * @function : get the counters of the pool
+		 */
+		inline http_client_pool_stats stats()
+		{
+			http_client_pool_stats s;
+
+			{
+				std::unique_lock<std::mutex> lock(this->mtx_);
+				for (auto& [key, conns] : this->idle_)
+				{
+					std::ignore = key;
+					s.idle += conns.size();
+				}
+			}
+
+			s.hits       = this->hits_      .load(std::memory_order_relaxed);
+			s.misses     = this->misses_    .load(std::memory_order_relaxed);
+			s.retries    = this->retries_   .load(std::memory_order_relaxed);
+			s.dns_hits   = this->dns_hits_  .load(std::memory_order_relaxed);
+			s.dns_misses = this->dns_misses_.load(std::memory_order_relaxed);
+
+			return s;
+		}
+
+		/**
+		 * @function : close all the idle connections and clear the dns cache
+		 */
+		inline void clear()
+		{
+			std::unordered_map<std::string, std::vector<std::unique_ptr<connection>>> idle;
+
+			{
+				std::unique_lock<std::mutex> lock(this->mtx_);
+				idle.swap(this->idle_);
+				this->dns_.clear();
+			}
+
+			// the idle connections has no pending operations, so they can be closed in this thread.
+		}
+
+		/**
+		 * @function : blocking execute the http request on the pool
+		 */
+		template<class Rep, class Period, class Body, class Fields, class Buffer = beast::flat_buffer>
+		inline http::response_t<Body, Fields> execute(std::string host, std::string port,
+			http::request_t<Body, Fields>& req, std::chrono::duration<Rep, Period> timeout, error_code& ec)
+		{
+			return this->template _execute<Buffer>(nullptr, std::move(host), std::move(port), req,
+				std::chrono::duration_cast<clock_type::duration>(timeout), ec);
+		}
+
+	#if defined(ASIO2_USE_SSL)
+		/**
+		 * @function : blocking execute the https request on the pool
+		 */
+		template<class Rep, class Period, class Body, class Fields, class Buffer = beast::flat_buffer>
+		inline http::response_t<Body, Fields> execute(const asio::ssl::context& ctx, std::string host,
+			std::string port, http::request_t<Body, Fields>& req, std::chrono::duration<Rep, Period> timeout,
+			error_code& ec)
+		{
+			return this->template _execute<Buffer>(const_cast<asio::ssl::context*>(&ctx),
+				std::move(host), std::move(port), req,
+				std::chrono::duration_cast<clock_type::duration>(timeout), ec);
+		}
+
+		/**
+		 * @function : get the ssl context which is used by the https execute without a ssl context,
+		 * so the connections of these calls can be reused too.
+		 */
+		static inline asio::ssl::context& default_ssl_context()
+		{
+			static asio::ssl::context ctx{ asio::ssl::context::sslv23 };
+			return ctx;
+		}
+	#endif
+
+	protected:
+		template<class Body, class Fields, class Buffer>
+		class execute_op
+		{
+		public:
+			using parser_type = http::parser<false, Body, typename Fields::allocator_type>;
+
+			execute_op(http_client_pool& pool, void* ssl_ctx, std::string& host, std::string& port,
+				http::request_t<Body, Fields>& req, parser_type& parser, std::unique_ptr<connection>& conn,
+				bool reused)
+				: pool_(pool), ssl_ctx_(ssl_ctx), host_(host), port_(port), req_(req)
+				, parser_(parser), conn_(conn), reused_(reused)
+				, timer_(conn->strand.context()), resolver_(conn->strand.context())
+				, done_(std::make_shared<std::promise<void>>())
+			{
+			}
+
+			inline error_code run(clock_type::duration timeout)
+			{
+				std::future<void> future = this->done_->get_future();
+
+				asio::post(this->conn_->strand, [this, timeout]() mutable
+				{
+					this->timer_.expires_after(timeout);
+					this->timer_.async_wait(asio::bind_executor(this->conn_->strand,
+					[this](const error_code& ec) mutable
+					{
+						if (!ec && !this->completed_)
+						{
+							this->timed_out_ = true;
+
+							error_code ec_ignore{};
+
+							this->resolver_.cancel();
+							this->conn_->socket.close(ec_ignore);
+						}
+
+						this->_finish();
+					}));
+
+					if (this->reused_)
+						this->_request();
+					else
+						this->_resolve();
+				});
+
+				future.wait();
+
+				return this->ec_;
+			}
+
+			inline bool reusable() const noexcept
+			{
+				return (!this->ec_ && this->parser_.is_done() && this->parser_.keep_alive() &&
+					this->req_.keep_alive() && this->buffer_.size() == 0);
+			}
+
+		protected:
+			inline void _resolve()
+			{
+				bool cached = false;
+				endpoints_type endpoints = this->pool_._find_endpoints(this->host_, this->port_, cached);
+
+				if (cached)
+				{
+					this->_connect(std::move(endpoints), true);
+					return;
+				}
+
+				this->resolver_.async_resolve(this->host_, this->port_, asio::bind_executor(this->conn_->strand,
+				[this](const error_code& ec, endpoints_type endpoints) mutable
+				{
+					if (ec) { this->_complete(ec); return; }
+
+					this->pool_._save_endpoints(this->host_, this->port_, endpoints);
+
+					this->_connect(std::move(endpoints), false);
+				}));
+			}
+
+			inline void _connect(endpoints_type endpoints, bool cached)
+			{
+				asio::async_connect(this->conn_->socket, endpoints, asio::bind_executor(this->conn_->strand,
+				[this, cached](const error_code& ec, const asio::ip::tcp::endpoint&) mutable
+				{
+					if (ec)
+					{
+						// the address of the host may be changed, so resolve it again at next time.
+						if (cached)
+							this->pool_._erase_endpoints(this->host_, this->port_);
+
+						this->_complete(ec);
+						return;
+					}
+
+				#if defined(ASIO2_USE_SSL)
+					if (this->ssl_ctx_)
+					{
+						this->conn_->ssl_stream = std::make_unique<ssl_stream_type>(
+							this->conn_->socket, *static_cast<asio::ssl::context*>(this->ssl_ctx_));
+
+						this->conn_->ssl_stream->async_handshake(asio::ssl::stream_base::client,
+							asio::bind_executor(this->conn_->strand,
+						[this](const error_code& ec) mutable
+						{
+							if (ec) { this->_complete(ec); return; }
+
+							this->_request();
+						}));
+
+						return;
+					}
+				#endif
+
+					this->_request();
+				}));
+			}
+
+			inline void _request()
+			{
+			#if defined(ASIO2_USE_SSL)
+				if (this->ssl_ctx_)
+				{
+					this->_write_read(*(this->conn_->ssl_stream));
+					return;
+				}
+			#endif
+
+				this->_write_read(this->conn_->socket);
+			}
+
+			template<class Stream>
+			inline void _write_read(Stream& stream)
+			{
+				http::async_write(stream, this->req_, asio::bind_executor(this->conn_->strand,
+				[this, &stream](const error_code& ec, std::size_t bytes_sent) mutable
+				{
+					if (ec) { this->_handle_error(ec, bytes_sent != 0); return; }
+
+					http::async_read(stream, this->buffer_, this->parser_, asio::bind_executor(this->conn_->strand,
+					[this](const error_code& ec, std::size_t) mutable
+					{
+						if (ec) { this->_handle_error(ec, true); return; }
+
+						this->_complete(ec);
+					}));
+				}));
+			}
+
+			inline void _handle_error(const error_code& ec, bool sent)
+			{
+				// the reused connection may has been closed by the server already, if nothing of the
+				// response is recved, send the request again on a new connection. but the server may
+				// have handled the request and closed the connection before the response is sent, so
+				// the request which has been sent is retried only if the method is idempotent.
+				if (this->reused_ && !this->timed_out_ && !this->parser_.got_some() &&
+					(!sent || this->_is_idempotent()))
+				{
+					this->reused_ = false;
+
+					this->pool_.retries_.fetch_add(1, std::memory_order_relaxed);
+
+					error_code ec_ignore{};
+
+				#if defined(ASIO2_USE_SSL)
+					this->conn_->ssl_stream.reset();
+				#endif
+					this->conn_->socket.close(ec_ignore);
+
+					this->buffer_.consume(this->buffer_.size());
+
+					this->_resolve();
+					return;
+				}
+
+				this->_complete(ec);
+			}
+
+			/// see rfc 7231 4.2.2, the request of these methods can be sent again automatically.
+			inline bool _is_idempotent() const noexcept
+			{
+				switch (this->req_.method())
+				{
+				case http::verb::get    :
+				case http::verb::head   :
+				case http::verb::put    :
+				case http::verb::delete_:
+				case http::verb::options:
+				case http::verb::trace  :
+					return true;
+				default:
+					return false;
+				}
+			}
+
+			inline void _complete(const error_code& ec)
+			{
+				this->completed_ = true;
+
+				this->ec_ = this->timed_out_ ? error_code(asio::error::timed_out) : ec;
+
+				error_code ec_ignore{};
+
+				this->timer_.cancel(ec_ignore);
+
+				this->_finish();
+			}
+
+			/// called when the request is completed and the timer is completed, the op is on the
+			/// stack of the execute caller, so it can be destroyed only after both of them are done.
+			inline void _finish()
+			{
+				if (--(this->pending_) > 0)
+					return;
+
+				// the caller may destroy this op as soon as the promise is set, so hold it first.
+				std::shared_ptr<std::promise<void>> done = this->done_;
+
+				done->set_value();
+			}
+
+		protected:
+			http_client_pool                   & pool_;
+
+			void                               * ssl_ctx_;
+
+			std::string                        & host_;
+			std::string                        & port_;
+
+			http::request_t<Body, Fields>      & req_;
+
+			parser_type                        & parser_;
+
+			std::unique_ptr<connection>        & conn_;
+
+			bool                                 reused_;
+
+			asio::steady_timer                   timer_;
+
+			resolver_type                        resolver_;
+
+			Buffer                               buffer_;
+
+			std::shared_ptr<std::promise<void>>  done_;
+
+			error_code                           ec_ = asio::error::timed_out;
+
+			int                                  pending_   = 2;
+
+			bool                                 completed_ = false;
+			bool                                 timed_out_ = false;
+		};
+
+		template<class Buffer, class Body, class Fields>
+		inline http::response_t<Body, Fields> _execute(void* ssl_ctx, std::string host, std::string port,
+			http::request_t<Body, Fields>& req, clock_type::duration timeout, error_code& ec)
+		{
+			http::parser<false, Body, typename Fields::allocator_type> parser;
+
+			try
+			{
+				// set default result to unknown
+				parser.get().result(http::status::unknown);
+				parser.eager(true);
+
+				// the pool owns nothing of a caller supplied ssl context, the context may be destroyed,
+				// or another context may be created at the same address, so only the connections of
+				// the default ssl context are reused.
+				bool poolable = (ssl_ctx == nullptr);
+
+			#if defined(ASIO2_USE_SSL)
+				if (ssl_ctx == static_cast<void*>(std::addressof(default_ssl_context())))
+					poolable = true;
+			#endif
+
+				std::string key;
+				key.reserve(host.size() + port.size() + 8);
+				key += host;
+				key += ':';
+				key += port;
+				key += (ssl_ctx ? "@https" : "@http");
+
+				// check the pool state before a connection is acquired, a reused connection is
+				// bound to an io_context of this pool too.
+				asio::io_context* ioc = this->_next_io(ec);
+
+				if (!ioc)
+					return parser.release();
+
+				std::unique_ptr<connection> conn;
+
+				if (poolable)
+					conn = this->_acquire(key);
+				else
+					this->misses_.fetch_add(1, std::memory_order_relaxed);
+
+				bool reused = bool(conn);
+
+				if (!reused)
+					conn = std::make_unique<connection>(*ioc);
+
+				execute_op<Body, Fields, Buffer> op(*this, ssl_ctx, host, port, req, parser, conn, reused);
+
+				ec = op.run(timeout);
+
+				if (poolable && op.reusable())
+					this->_release(key, std::move(conn));
+			}
+			catch (system_error & e)
+			{
+				ec = e.code();
+			}
+
+			return parser.release();
+		}
+
+		inline asio::io_context* _next_io(error_code& ec)
+		{
+			std::unique_lock<std::mutex> lock(this->mtx_);
+
+			if (!this->iopool_)
+			{
+				ec = asio::error::shut_down;
+				return nullptr;
+			}
+
+			// the execute is blocking, if it is called in the thread of this pool, it will never return.
+			if (this->iopool_->running_in_threads())
+			{
+				ASIO2_ASSERT(false);
+				ec = asio::error::operation_not_supported;
+				return nullptr;
+			}
+
+			return std::addressof(this->iopool_->get((this->next_++) % this->iopool_->size()));
+		}
+
+		inline std::unique_ptr<connection> _acquire(const std::string& key)
+		{
+			std::unique_ptr<connection> conn;
+
+			std::unique_lock<std::mutex> lock(this->mtx_);
+
+			auto iter = this->idle_.find(key);
+
+			if (iter != this->idle_.end())
+			{
+				auto& conns = iter->second;
+				auto  now   = clock_type::now();
+
+				while (!conns.empty())
+				{
+					conn = std::move(conns.back());
+					conns.pop_back();
+
+					if (now - conn->idle_since < this->idle_timeout_)
+						break;
+
+					conn.reset();
+				}
+			}
+
+			if (conn)
+				this->hits_  .fetch_add(1, std::memory_order_relaxed);
+			else
+				this->misses_.fetch_add(1, std::memory_order_relaxed);
+
+			return conn;
+		}
+
+		inline void _release(const std::string& key, std::unique_ptr<connection> conn)
+		{
+			std::unique_lock<std::mutex> lock(this->mtx_);
+
+			auto& conns = this->idle_[key];
+
+			if (conns.size() < this->max_idle_)
+			{
+				conn->idle_since = clock_type::now();
+				conns.emplace_back(std::move(conn));
+			}
+		}
+
+		inline endpoints_type _find_endpoints(const std::string& host, const std::string& port, bool& found)
+		{
+			std::unique_lock<std::mutex> lock(this->mtx_);
+
+			found = false;
+
+			auto iter = this->dns_.find(host + ':' + port);
+
+			if (iter != this->dns_.end())
+			{
+				if (clock_type::now() < iter->second.second)
+				{
+					found = true;
+
+					this->dns_hits_.fetch_add(1, std::memory_order_relaxed);
+
+					return iter->second.first;
+				}
+
+				this->dns_.erase(iter);
+			}
+
+			this->dns_misses_.fetch_add(1, std::memory_order_relaxed);
+
+			return endpoints_type{};
+		}
+
+		inline void _save_endpoints(const std::string& host, const std::string& port, const endpoints_type& endpoints)
+		{
+			std::unique_lock<std::mutex> lock(this->mtx_);
+
+			if (this->dns_ttl_.count() > 0)
+				this->dns_[host + ':' + port] = { endpoints, clock_type::now() + this->dns_ttl_ };
+		}
+
+		inline void _erase_endpoints(const std::string& host, const std::string& port)
+		{
+			std::unique_lock<std::mutex> lock(this->mtx_);
+
+			this->dns_.erase(host + ':' + port);
+		}
+
+	protected:
+		std::mutex                                                                  mtx_;
+
+		std::unique_ptr<iopool>                                                     iopool_;
+
+		std::size_t                                                                 next_ = 0;
+
+		/// the idle connections of each "host:port@http" and "host:port@https"
+		std::unordered_map<std::string, std::vector<std::unique_ptr<connection>>>  idle_;
+
+		/// the resolved endpoints of each "host:port" and the expiry time
+		std::unordered_map<std::string, std::pair<endpoints_type, clock_type::time_point>> dns_;
+
+		std::size_t                thread_count_ = 1;
+		std::size_t                max_idle_     = 32;
+		clock_type::duration       idle_timeout_ = std::chrono::seconds(30);
+		clock_type::duration       dns_ttl_      = std::chrono::seconds(60);
+
+		std::atomic<std::uint64_t> hits_      { 0 };
+		std::atomic<std::uint64_t> misses_    { 0 };
+		std::atomic<std::uint64_t> retries_   { 0 };
+		std::atomic<std::uint64_t> dns_hits_  { 0 };
+		std::atomic<std::uint64_t> dns_misses_{ 0 };
+	};
+}
+
+namespace asio2
+{
+	using http_client_pool       = detail::http_client_pool;
+	using http_client_pool_stats = detail::http_client_pool_stats;
+}
+
+#endif // !__ASIO2_HTTP_CLIENT_POOL_HPP__
@@ -0,0 +1,431 @@
+/*
+ * COPYRIGHT (C) 2017-2021, zhllxt
+ *
+ * author   : zhllxt
+ * email    : 37792738@qq.com
+ *
+ * Distributed under the GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+ * (See accompanying file LICENSE or see <http://www.gnu.org/licenses/>)
+ */
+
+#ifndef __ASIO2_HTTP_RADIX_TREE_HPP__
+#define __ASIO2_HTTP_RADIX_TREE_HPP__
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+#pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <cstddef>
+#include <cstring>
+#include <array>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <asio2/base/error.hpp>
+
+namespace asio2::detail
+{
+	/**
+	 * The path parameters captured by the http router, eg : the route is "/user/:id/" with a
+	 * trailing "*", and the path is "/user/9/avatar/big.png", then the params are :
+	 * { "id", "9" }, { "*", "avatar/big.png" }
+	 * The params are string_view, the names point to the router, and the values point to the
+	 * target of the request, so there is no memory allocation when the params are captured.
+	 */
+	template<std::size_t N>
+	class http_route_params_t
+	{
+	public:
+		using value_type     = std::pair<std::string_view, std::string_view>;
+		using const_iterator = typename std::array<value_type, N>::const_iterator;
+
+		static constexpr std::size_t capacity() noexcept { return N; }
+
+		inline std::size_t    size () const noexcept { return this->count_; }
+		inline bool           empty() const noexcept { return this->count_ == 0; }
+		inline const_iterator begin() const noexcept { return this->params_.begin(); }
+		inline const_iterator end  () const noexcept { return this->params_.begin() + this->count_; }
+
+		inline const value_type& operator[](std::size_t i) const noexcept
+		{
+			ASIO2_ASSERT(i < this->count_);
+			return this->params_[i];
+		}
+
+		/**
+		 * @function : get the param value by name, return empty string_view if not found.
+		 */
+		inline std::string_view get(std::string_view name) const noexcept
+		{
+			for (std::size_t i = 0; i < this->count_; ++i)
+			{
+				if (this->params_[i].first == name)
+					return this->params_[i].second;
+			}
+			return std::string_view{};
+		}
+
+		inline void clear() noexcept { this->count_ = 0; }
+
+		inline void push(std::string_view name, std::string_view value) noexcept
+		{
+			ASIO2_ASSERT(this->count_ < N);
+			this->params_[this->count_++] = value_type{ name, value };
+		}
+
+		inline void pop() noexcept
+		{
+			ASIO2_ASSERT(this->count_ > 0);
+			--(this->count_);
+		}
+
+		/**
+		 * @function : copy the params of another request, the values of these params point to the
+		 * target "from" of that request, they are rebased onto the target "to" of this request by
+		 * the same offset and length.
+		 */
+		inline void assign(const http_route_params_t& o, std::string_view from, std::string_view to) noexcept
+		{
+			this->count_ = 0;
+
+			for (std::size_t i = 0; i < o.count_; ++i)
+			{
+				std::string_view value = o.params_[i].second;
+
+				if (value.empty())
+				{
+					this->params_[this->count_++] = value_type{ o.params_[i].first, std::string_view{} };
+					continue;
+				}
+
+				// the value is not in the target, it can't be rebased, so drop all the params.
+				if (value.data() < from.data() || value.data() + value.size() > from.data() + from.size())
+				{
+					this->count_ = 0;
+					return;
+				}
+
+				std::size_t offset = static_cast<std::size_t>(value.data() - from.data());
+
+				if (offset + value.size() > to.size())
+				{
+					this->count_ = 0;
+					return;
+				}
+
+				this->params_[this->count_++] = value_type{ o.params_[i].first, to.substr(offset, value.size()) };
+			}
+		}
+
+	protected:
+		std::array<value_type, N> params_;
+		std::size_t               count_ = 0;
+	};
+
+	using http_route_params = http_route_params_t<8>;
+
+	/**
+	 * A compressed radix tree of the http routes.
+	 * The segments of the route can be static text, ":name" or a trailing "*".
+	 * ":name" : matches one non-empty path segment, eg : "/user/:id" matches "/user/9".
+	 * "*"     : matches the rest of the path (maybe empty), it must be the last char of the route,
+	 *           if the char before "*" is '/', the path without this '/' is matched too, eg :
+	 *           "/static/" with the trailing "*" matches "/static", "/static/" and
+	 *           "/static/js/main.js".
+	 * When more than one route can match the path, the static text is preferred, then the ":name",
+	 * and then the "*".
+	 * The find operation does not allocate any memory.
+	 */
+	template<class T>
+	class http_radix_tree
+	{
+	protected:
+		struct node
+		{
+			/// the static text of this node, it is empty for the ":name" node
+			std::string                        prefix;
+
+			/// the first char of each static child, used to find the static child fast
+			std::string                        indices;
+
+			std::vector<std::unique_ptr<node>> children;
+
+			/// the ":name" child of this node
+			std::unique_ptr<node>              param;
+
+			/// the name of the ":name" node, without the ':'
+			std::string                        name;
+
+			/// the value of the route which is end at this node
+			T                                  value{};
+
+			/// the value of the route which is end with "*" at this node
+			T                                  wildcard{};
+
+			bool                               has_value    = false;
+			bool                               has_wildcard = false;
+
+			/// the value is set by the "xxx/*" route, not by a route end at this node
+			bool                               implicit     = false;
+		};
+
+	public:
+		/**
+		 * @constructor
+		 */
+		http_radix_tree() : root_(std::make_unique<node>()) {}
+
+		/**
+		 * @destructor
+		 */
+		~http_radix_tree() = default;
+
+		http_radix_tree(http_radix_tree&&) noexcept = default;
+		http_radix_tree& operator=(http_radix_tree&&) noexcept = default;
+
+		/**
+		 * @function : Returns true if the route can be inserted into the tree, the route can't
+		 * contain "*" except the last char.
+		 */
+		static inline bool is_supported(std::string_view route) noexcept
+		{
+			std::size_t pos = route.find('*');
+			return (pos == std::string_view::npos || pos + 1 == route.size());
+		}
+
+		/**
+		 * @function : insert a route, the exists value of the same route will be replaced.
+		 * @return   : false if the route is not supported or has too many params.
+		 */
+		template<class V, std::size_t N = http_route_params::capacity()>
+		inline bool insert(std::string_view route, V&& value)
+		{
+			ASIO2_ASSERT(is_supported(route));
+
+			if (!is_supported(route))
+				return false;
+
+			std::size_t params = (route.back() == '*' ? 1 : 0);
+			for (std::size_t i = 1; i < route.size(); ++i)
+			{
+				if (route[i] == ':' && route[i - 1] == '/')
+					++params;
+			}
+
+			ASIO2_ASSERT(params <= N);
+
+			if (params > N)
+				return false;
+
+			if (route.back() == '*')
+			{
+				std::string_view path = route.substr(0, route.size() - 1);
+
+				if (path.size() > std::size_t(1) && path.back() == '/')
+				{
+					node* n = this->_insert(path.substr(0, path.size() - 1));
+					if (!n->has_value || n->implicit)
+					{
+						n->value     = value;
+						n->has_value = true;
+						n->implicit  = true;
+					}
+				}
+
+				node* n = this->_insert(path);
+				n->wildcard     = std::forward<V>(value);
+				n->has_wildcard = true;
+			}
+			else
+			{
+				node* n = this->_insert(route);
+				n->value     = std::forward<V>(value);
+				n->has_value = true;
+				n->implicit  = false;
+			}
+
+			return true;
+		}
+
+		/**
+		 * @function : find the value of the path, and capture the params.
+		 * @return   : the pointer of the value, or nullptr if not found.
+		 */
+		template<std::size_t N>
+		inline T* find(std::string_view path, http_route_params_t<N>& params) const noexcept
+		{
+			params.clear();
+
+			if (path.empty())
+				return nullptr;
+
+			return this->_find(this->root_.get(), path, params);
+		}
+
+		/**
+		 * @function : Returns true if there is no route in the tree.
+		 */
+		inline bool empty() const noexcept
+		{
+			const node* n = this->root_.get();
+			return (n->children.empty() && !n->param && !n->has_value && !n->has_wildcard);
+		}
+
+	protected:
+		/// insert the route without the trailing "*", return the node where the route is end.
+		inline node* _insert(std::string_view route)
+		{
+			node* n = this->root_.get();
+
+			while (!route.empty())
+			{
+				if (route.front() == ':' && n != this->root_.get() && this->_is_segment_begin(n))
+				{
+					std::size_t pos = (std::min)(route.find('/'), route.size());
+					std::string_view name = route.substr(1, pos - 1);
+
+					if (!n->param)
+					{
+						n->param = std::make_unique<node>();
+						n->param->name = name;
+					}
+
+					// the same position can't have different param names, eg : "/user/:id" and
+					// "/user/:name", the first name is used.
+					ASIO2_ASSERT(n->param->name == name);
+
+					n = n->param.get();
+					route.remove_prefix(pos);
+					continue;
+				}
+
+				std::size_t pos = 0;
+				do
+				{
+					pos = route.find(':', pos + 1);
+				} while (pos != std::string_view::npos && route[pos - 1] != '/');
+
+				pos = (std::min)(pos, route.size());
+
+				n = this->_insert_static(n, route.substr(0, pos));
+				route.remove_prefix(pos);
+			}
+
+			return n;
+		}
+
+		/// whether the last char matched by the node is '/'
+		inline bool _is_segment_begin(node* n) const noexcept
+		{
+			return (!n->prefix.empty() && n->prefix.back() == '/');
+		}
+
+		inline node* _insert_static(node* n, std::string_view text)
+		{
+			while (!text.empty())
+			{
+				std::size_t i = n->indices.find(text.front());
+
+				if (i == std::string::npos)
+				{
+					std::unique_ptr<node> child = std::make_unique<node>();
+					child->prefix = text;
+
+					node* p = child.get();
+					n->indices.push_back(text.front());
+					n->children.emplace_back(std::move(child));
+					return p;
+				}
+
+				node* child = n->children[i].get();
+
+				std::size_t len = 0;
+				std::size_t max = (std::min)(child->prefix.size(), text.size());
+				while (len < max && child->prefix[len] == text[len])
+					++len;
+
+				// split the child into two nodes : the common prefix and the rest.
+				if (len < child->prefix.size())
+				{
+					std::unique_ptr<node> mid = std::make_unique<node>();
+					mid->prefix = child->prefix.substr(0, len);
+
+					std::unique_ptr<node> old = std::move(n->children[i]);
+					old->prefix.erase(0, len);
+					mid->indices.push_back(old->prefix.front());
+					mid->children.emplace_back(std::move(old));
+
+					n->children[i] = std::move(mid);
+					child = n->children[i].get();
+				}
+
+				n = child;
+				text.remove_prefix(len);
+			}
+
+			return n;
+		}
+
+		template<std::size_t N>
+		inline T* _find(const node* n, std::string_view path, http_route_params_t<N>& params) const noexcept
+		{
+			if (path.empty())
+			{
+				if (n->has_value)
+					return const_cast<T*>(std::addressof(n->value));
+
+				if (n->has_wildcard)
+				{
+					params.push(std::string_view{ "*" }, path);
+					return const_cast<T*>(std::addressof(n->wildcard));
+				}
+
+				return nullptr;
+			}
+
+			// static child first
+			if (std::size_t i = n->indices.find(path.front()); i != std::string::npos)
+			{
+				const node* child = n->children[i].get();
+				std::string_view prefix = child->prefix;
+
+				if (path.size() >= prefix.size() &&
+					std::memcmp(path.data(), prefix.data(), prefix.size()) == 0)
+				{
+					if (T* p = this->_find(child, path.substr(prefix.size()), params); p)
+						return p;
+				}
+			}
+
+			// then the ":name" child
+			if (n->param && path.front() != '/')
+			{
+				std::size_t pos = (std::min)(path.find('/'), path.size());
+
+				params.push(n->param->name, path.substr(0, pos));
+
+				if (T* p = this->_find(n->param.get(), path.substr(pos), params); p)
+					return p;
+
+				params.pop();
+			}
+
+			// then the "*"
+			if (n->has_wildcard)
+			{
+				params.push(std::string_view{ "*" }, path);
+				return const_cast<T*>(std::addressof(n->wildcard));
+			}
+
+			return nullptr;
+		}
+
+	protected:
+		std::unique_ptr<node> root_;
+	};
+}
+
+#endif // !__ASIO2_HTTP_RADIX_TREE_HPP__
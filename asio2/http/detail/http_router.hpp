@@ -42,6 +42,8 @@
 #include <asio2/base/detail/util.hpp>
 
 #include <asio2/http/detail/http_util.hpp>
+#include <asio2/http/detail/http_radix_tree.hpp>
+#include <asio2/http/detail/http_static.hpp>
 #include <asio2/http/request.hpp>
 #include <asio2/http/response.hpp>
 
@@ -198,7 +200,13 @@ namespace asio2::detail
 
 		/**
 		 * @function : bind a function for http router
-		 * @param    : name - uri name in string format
+		 * @param    : name - uri name in string format, the segment like ":id" matches one path
+		 * segment and the trailing "*" matches the rest of the path, eg : "/user/:id/" with a
+		 * trailing "*", the captured values can be get by req.route_param("id") and
+		 * req.route_param("*")
+		 * note : the route whose only "*" is the trailing one is matched by the segments now,
+		 * eg : "/user/*" matches "/user" and "/user/1", but not "/users" or "/x/user/1" any more,
+		 * the route which contains "*" in the middle is still matched like before.
 		 * @param    : fun - Function object
 		 * @param    : caop - A pointer or reference to a class object, and aop object list.
 		 * if fun is member function, the first caop param must the class object's pointer or refrence.
@@ -265,6 +273,56 @@ namespace asio2::detail
 			return this->root_directory_;
 		}
 
+		/**
+		 * @function : serve the files of the directory for the uri prefix, the GET and HEAD requests
+		 * whose path is under the prefix are served without the router, the small files are served
+		 * from the hot file cache, and the large files are sent by sendfile on linux, "Range" is
+		 * supported. if the file is not found, the request is passed to the router.
+		 * eg : server.bind_static("/assets", "/var/www/assets");
+		 */
+		inline self& bind_static(std::string prefix, std::filesystem::path directory)
+		{
+			this->static_files_.mount(std::move(prefix), std::move(directory));
+			return (*this);
+		}
+
+		/**
+		 * @function : set the max total bytes of the hot file cache of the static files, and the max
+		 * size of the file which can be cached, 0 means the cache is disabled.
+		 * the default is 32MB and 256KB.
+		 */
+		inline self& static_cache(std::size_t max_bytes, std::size_t max_file_size)
+		{
+			this->static_files_.cache(max_bytes, max_file_size);
+			return (*this);
+		}
+
+		/**
+		 * @function : get the counters of the static files
+		 */
+		inline http_static_stats static_stats()
+		{
+			return this->static_files_.stats();
+		}
+
+		/**
+		 * @function : set the max count of the pipelined requests which are handled together, the
+		 * responses of them are sent by one write, 0 or 1 means the pipelining is disabled, the
+		 * requests are handled one by one. default is 0, eg : pipeline_limit(16) to enable it.
+		 */
+		inline self& pipeline_limit(std::size_t v)
+		{
+			this->pipeline_limit_ = v;
+			return (*this);
+		}
+		/**
+		 * @function : get the max count of the pipelined requests which are handled together.
+		 */
+		inline std::size_t pipeline_limit()
+		{
+			return this->pipeline_limit_;
+		}
+
 		/**
 		 * @function : set whether websocket is supported, default is true
 		 */
@@ -284,6 +342,8 @@ namespace asio2::detail
 	protected:
 		inline self& _router() { return (*this); }
 
+		inline http_static_files& _static_files() { return this->static_files_; }
+
 		template<http::verb... M>
 		inline decltype(auto) _make_uris(std::string name)
 		{
@@ -356,6 +416,25 @@ namespace asio2::detail
 				if (uri.empty())
 					continue;
 
+				// the route which contains "*" in the middle can't be inserted into the radix tree,
+				// it is matched by the http::url_match like before.
+				if (http_radix_tree<std::shared_ptr<optype>>::is_supported(name))
+				{
+					std::size_t index = this->_to_index(uri.front());
+
+					ASIO2_ASSERT(index < this->routers_.size());
+
+					std::string_view route = std::string_view(uri).substr(1);
+
+					while (route.size() > static_cast<std::string_view::size_type>(1) && route.back() == '/')
+					{
+						route.remove_suffix(1);
+					}
+
+					if (this->routers_[index].insert(route, op))
+						continue;
+				}
+
 				if (name.back() == '*')
 					this->wildcard_routers_[std::move(uri)] = op;
 				else
@@ -589,6 +668,36 @@ namespace asio2::detail
 		{
 			asio2::detail::ignore_unused(rep);
 
+			std::string_view path = req.path();
+
+			while (path.size() > static_cast<std::string_view::size_type>(1) && path.back() == '/')
+			{
+				path.remove_suffix(1);
+			}
+
+			std::size_t index;
+
+			if constexpr (IsHttp)
+			{
+				index = detail::to_underlying(req.method());
+			}
+			else
+			{
+				index = this->_to_index('Z');
+			}
+
+			if (index < this->routers_.size())
+			{
+				std::shared_ptr<optype>* p = this->routers_[index].find(path, req.route_params_);
+				if (p)
+				{
+					return (*p);
+				}
+			}
+
+			if (this->strictly_routers_.empty() && this->wildcard_routers_.empty())
+				return this->dummy_router_;
+
 			std::string uri;
 
 			if constexpr (IsHttp)
@@ -655,17 +764,32 @@ namespace asio2::detail
 			return chars.substr(detail::to_underlying(method), 1);
 		}
 
+		inline constexpr std::size_t _to_index(char c)
+		{
+			using namespace std::literals;
+			constexpr std::string_view chars = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ"sv;
+			return chars.find(c);
+		}
+
 	protected:
 		std::filesystem::path     root_directory_     = std::filesystem::current_path();
 
 		bool                      support_websocket_  = true;
 
+		std::size_t               pipeline_limit_     = 0;
+
+		/// the radix tree of the routes for each http method, the last one is for websocket
+		std::array<http_radix_tree<std::shared_ptr<optype>>, 62>  routers_;
+
+		/// the routes which contains "*" in the middle, they can't be inserted into the radix tree
 		std::unordered_map<std::string, std::shared_ptr<optype>> strictly_routers_;
 
 		std::          map<std::string, std::shared_ptr<optype>> wildcard_routers_;
 
 		std::shared_ptr<optype>                                  not_found_router_;
 
+		http_static_files                                        static_files_;
+
 		std::shared_ptr<optype>                                  dummy_router_;
 	};
 }
@@ -0,0 +1,1001 @@
+/*
+ * COPYRIGHT (C) 2017-2021, zhllxt
+ *
+ * author   : zhllxt
+ * email    : 37792738@qq.com
+ *
+ * Distributed under the GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+ * (See accompanying file LICENSE or see <http://www.gnu.org/licenses/>)
+ */
+
+#ifndef __ASIO2_HTTP_STATIC_HPP__
+#define __ASIO2_HTTP_STATIC_HPP__
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+#pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <asio2/base/detail/push_options.hpp>
+
+#include <asio2/http/detail/http_util.hpp>
+#include <asio2/http/detail/mime_types.hpp>
+#include <asio2/http/request.hpp>
+
+namespace asio2::detail
+{
+	/**
+	 * The counters of the static files.
+	 */
+	struct http_static_stats
+	{
+		/// the count of the requests which are served from the hot file cache
+		std::uint64_t hits      = 0;
+
+		/// the count of the requests which are not found in the hot file cache
+		std::uint64_t misses    = 0;
+
+		/// the count of the requests which are served by sendfile
+		std::uint64_t sendfiles = 0;
+
+		/// the count and the total bytes of the files in the hot file cache now
+		std::uint64_t files     = 0;
+		std::uint64_t bytes     = 0;
+	};
+
+	/**
+	 * The file which is cached in the hot file cache, the header fields are precomputed.
+	 */
+	struct http_static_entry
+	{
+		std::filesystem::path       path;
+
+		std::uint64_t               size  = 0;
+		std::int64_t                mtime = 0;
+
+		/// "Content-Type", "Last-Modified", "Accept-Ranges" and "Vary" lines
+		std::string                 fields;
+
+		std::string                 etag;
+		std::string                 body;
+
+		/// the content of the pre-gzipped "path.gz" file, empty if there is no this file
+		std::string                 gzip_etag;
+		std::string                 gzip;
+
+		/// the size and the mtime of the "path.gz" file, the mtime is -1 if there is no this file
+		std::uint64_t               gzip_size  = 0;
+		std::int64_t                gzip_mtime = -1;
+
+		/// the steady clock time of the last time that the file is checked whether it is modified
+		std::atomic<std::int64_t>   checked{ 0 };
+	};
+
+	/**
+	 * The response of the static file, the header is serialized already, the body is the cached
+	 * content or a range of the opened file.
+	 */
+	struct http_static_reply
+	{
+		std::string                               header;
+
+		/// hold the cached file, so the body is valid until the sending is completed
+		std::shared_ptr<const http_static_entry>  entry;
+		std::string_view                          body;
+
+		std::shared_ptr<beast::file>              file;
+		std::uint64_t                             offset = 0;
+		std::uint64_t                             length = 0;
+
+		inline void clear()
+		{
+			this->header.clear();
+			this->entry.reset();
+			this->body = {};
+			this->file.reset();
+			this->offset = 0;
+			this->length = 0;
+		}
+	};
+
+	/**
+	 * A bounded lru cache of the small hot files, it is thread safed.
+	 */
+	class http_static_cache
+	{
+	public:
+		/**
+		 * @constructor
+		 */
+		http_static_cache() = default;
+
+		/**
+		 * @destructor
+		 */
+		~http_static_cache() = default;
+
+		inline void config(std::size_t max_bytes, std::size_t max_file_size)
+		{
+			std::unique_lock<std::mutex> lock(this->mtx_);
+
+			this->max_bytes_     = max_bytes;
+			this->max_file_size_ = max_file_size;
+
+			this->_evict();
+		}
+
+		inline bool cacheable(std::uint64_t size)
+		{
+			std::unique_lock<std::mutex> lock(this->mtx_);
+
+			// the cache is disabled by cache(0, 0), don't cache the empty files either.
+			if (this->max_bytes_ == 0 || this->max_file_size_ == 0)
+				return false;
+
+			return (size <= this->max_file_size_ && size <= this->max_bytes_);
+		}
+
+		inline std::shared_ptr<http_static_entry> find(const std::string& key)
+		{
+			std::unique_lock<std::mutex> lock(this->mtx_);
+
+			auto iter = this->map_.find(key);
+			if (iter == this->map_.end())
+				return nullptr;
+
+			// move to the front, the last one is the least recently used.
+			this->list_.splice(this->list_.begin(), this->list_, iter->second);
+
+			return iter->second->second;
+		}
+
+		inline void insert(const std::string& key, std::shared_ptr<http_static_entry> entry)
+		{
+			std::unique_lock<std::mutex> lock(this->mtx_);
+
+			this->_erase(key);
+
+			this->list_.emplace_front(key, std::move(entry));
+			this->map_.emplace(this->list_.front().first, this->list_.begin());
+
+			this->bytes_ += _bytes(*(this->list_.front().second));
+
+			this->_evict();
+		}
+
+		inline void erase(const std::string& key)
+		{
+			std::unique_lock<std::mutex> lock(this->mtx_);
+
+			this->_erase(key);
+		}
+
+		inline void stats(http_static_stats& s)
+		{
+			std::unique_lock<std::mutex> lock(this->mtx_);
+
+			s.files = this->map_.size();
+			s.bytes = this->bytes_;
+		}
+
+	protected:
+		static inline std::size_t _bytes(const http_static_entry& e) noexcept
+		{
+			return e.body.size() + e.gzip.size();
+		}
+
+		inline void _erase(const std::string& key)
+		{
+			auto iter = this->map_.find(key);
+			if (iter == this->map_.end())
+				return;
+
+			this->bytes_ -= _bytes(*(iter->second->second));
+
+			this->list_.erase(iter->second);
+			this->map_.erase(iter);
+		}
+
+		inline void _evict()
+		{
+			while (!this->list_.empty() && this->bytes_ > this->max_bytes_)
+			{
+				this->_erase(this->list_.back().first);
+			}
+		}
+
+	protected:
+		using list_type = std::list<std::pair<std::string, std::shared_ptr<http_static_entry>>>;
+
+		std::mutex                                                   mtx_;
+
+		list_type                                                    list_;
+
+		std::unordered_map<std::string_view, list_type::iterator>   map_;
+
+		std::size_t                                                  bytes_         = 0;
+
+		std::size_t                                                  max_bytes_     = 32 * 1024 * 1024;
+		std::size_t                                                  max_file_size_ = 256 * 1024;
+	};
+
+	/**
+	 * The static file directories of the http server. The request of GET and HEAD whose path is
+	 * under a mounted prefix is served from the directory without the router, the small files
+	 * are served from the hot file cache, and the other files are sent by sendfile on linux (for
+	 * plain http) or read and sent by chunks. The "Range", "If-Range" and "If-None-Match" are
+	 * supported, and if the client accepts gzip and the "xxx.gz" file exists, the "xxx.gz" is
+	 * sent with "Content-Encoding: gzip".
+	 * If the file is not found, the request is passed to the router.
+	 */
+	class http_static_files
+	{
+	public:
+		using clock_type = std::chrono::steady_clock;
+
+		/**
+		 * @constructor
+		 */
+		http_static_files() = default;
+
+		/**
+		 * @destructor
+		 */
+		~http_static_files() = default;
+
+		inline bool empty() const noexcept { return this->mounts_.empty(); }
+
+		/**
+		 * @function : mount the directory to the uri prefix, eg : mount("/assets", "/var/www/assets")
+		 */
+		inline void mount(std::string prefix, std::filesystem::path directory)
+		{
+			while (!prefix.empty() && prefix.back() == '/')
+				prefix.pop_back();
+
+			if (prefix.empty() || prefix.front() != '/')
+				prefix.insert(prefix.begin(), '/');
+
+			this->mounts_.emplace_back(std::move(prefix), std::move(directory));
+
+			// the longer prefix is matched first.
+			std::stable_sort(this->mounts_.begin(), this->mounts_.end(), [](auto& a, auto& b)
+			{
+				return a.first.size() > b.first.size();
+			});
+		}
+
+		/**
+		 * @function : set the max total bytes of the hot file cache, and the max size of the file
+		 * which can be cached, 0 means the cache is disabled.
+		 */
+		inline void cache(std::size_t max_bytes, std::size_t max_file_size)
+		{
+			this->cache_.config(max_bytes, max_file_size);
+		}
+
+		inline http_static_stats stats()
+		{
+			http_static_stats s;
+
+			s.hits      = this->hits_     .load(std::memory_order_relaxed);
+			s.misses    = this->misses_   .load(std::memory_order_relaxed);
+			s.sendfiles = this->sendfiles_.load(std::memory_order_relaxed);
+
+			this->cache_.stats(s);
+
+			return s;
+		}
+
+		inline void count_sendfile() noexcept
+		{
+			this->sendfiles_.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		/**
+		 * @function : make the response of the request.
+		 * @return   : false if the request is not a static file request, or the file is not found.
+		 */
+		inline bool make_reply(http::request& req, http_static_reply& reply)
+		{
+			reply.clear();
+
+			if (this->mounts_.empty())
+				return false;
+
+			if (req.method() != http::verb::get && req.method() != http::verb::head)
+				return false;
+
+			std::filesystem::path filepath;
+
+			if (!this->_resolve(req.path(), filepath))
+				return false;
+
+			std::string key = filepath.string();
+
+			bool accept_gzip = _accept_gzip(req[http::field::accept_encoding]);
+
+			std::shared_ptr<http_static_entry> entry = this->_find(key);
+
+			if (!entry)
+			{
+				std::error_code ec;
+
+				if (std::filesystem::is_directory(filepath, ec))
+					filepath /= "index.html";
+
+				if (!std::filesystem::is_regular_file(filepath, ec))
+					return false;
+
+				std::uint64_t size = std::filesystem::file_size(filepath, ec);
+				if (ec)
+					return false;
+
+				this->misses_.fetch_add(1, std::memory_order_relaxed);
+
+				// the small file is loaded into the hot file cache.
+				if (this->cache_.cacheable(size))
+				{
+					entry = this->_load(filepath);
+
+					if (entry)
+						this->cache_.insert(key, entry);
+				}
+
+				if (!entry)
+					return this->_make_file_reply(req, reply, filepath, accept_gzip);
+			}
+			else
+			{
+				this->hits_.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			return this->_make_entry_reply(req, reply, std::move(entry), accept_gzip);
+		}
+
+	protected:
+		inline bool _resolve(std::string_view path, std::filesystem::path& filepath)
+		{
+			for (auto& [prefix, directory] : this->mounts_)
+			{
+				if (prefix.size() > 1)
+				{
+					if (path.substr(0, prefix.size()) != prefix)
+						continue;
+
+					if (path.size() > prefix.size() && path[prefix.size()] != '/')
+						continue;
+				}
+
+				std::string rel;
+
+				try
+				{
+					rel = http::url_decode(path.substr(prefix.size() > 1 ? prefix.size() : 0));
+				}
+				catch (system_error const&)
+				{
+					return false;
+				}
+
+				filepath = directory;
+
+				std::string_view segs = rel;
+
+				while (!segs.empty())
+				{
+					std::size_t pos = segs.find('/');
+
+					std::string_view seg = segs.substr(0, pos);
+
+					segs = (pos == std::string_view::npos ? std::string_view{} : segs.substr(pos + 1));
+
+					if (seg.empty() || seg == ".")
+						continue;
+
+					// don't allow to access the file which is outside of the directory
+					if (seg == ".." || seg.find('\\') != std::string_view::npos ||
+						seg.find(':') != std::string_view::npos || seg.find('\0') != std::string_view::npos)
+						return false;
+
+					filepath /= seg;
+				}
+
+				return true;
+			}
+
+			return false;
+		}
+
+		inline std::shared_ptr<http_static_entry> _find(const std::string& key)
+		{
+			std::shared_ptr<http_static_entry> entry = this->cache_.find(key);
+
+			if (!entry)
+				return nullptr;
+
+			std::int64_t now = clock_type::now().time_since_epoch().count();
+			std::int64_t checked = entry->checked.load(std::memory_order_relaxed);
+
+			if (now - checked < std::chrono::duration_cast<clock_type::duration>(this->revalidate_).count())
+				return entry;
+
+			// only one thread check the file, the others use the cached file still.
+			if (!entry->checked.compare_exchange_strong(checked, now, std::memory_order_relaxed))
+				return entry;
+
+			std::error_code ec;
+
+			std::uint64_t size  = std::filesystem::file_size(entry->path, ec);
+
+			if (!ec)
+			{
+				std::int64_t mtime = std::filesystem::last_write_time(entry->path, ec).time_since_epoch().count();
+
+				// the "path.gz" file is served from the cache too, so it must not be changed,
+				// created or deleted either.
+				if (!ec && size == entry->size && mtime == entry->mtime)
+				{
+					std::uint64_t gzip_size = 0;
+					std::int64_t gzip_mtime = _gzip_stat(entry->path, gzip_size);
+
+					if (gzip_size == entry->gzip_size && gzip_mtime == entry->gzip_mtime)
+						return entry;
+				}
+			}
+
+			this->cache_.erase(key);
+
+			return nullptr;
+		}
+
+		inline std::shared_ptr<http_static_entry> _load(const std::filesystem::path& filepath)
+		{
+			auto entry = std::make_shared<http_static_entry>();
+
+			std::error_code ec;
+
+			auto ftime = std::filesystem::last_write_time(filepath, ec);
+			if (ec)
+				return nullptr;
+
+			entry->path  = filepath;
+			entry->mtime = ftime.time_since_epoch().count();
+
+			if (!_read_file(filepath, entry->body))
+				return nullptr;
+
+			entry->size = entry->body.size();
+			entry->etag = _make_etag(entry->size, entry->mtime, {});
+
+			std::filesystem::path gzpath = filepath;
+			gzpath += ".gz";
+
+			entry->gzip_mtime = _gzip_stat(filepath, entry->gzip_size);
+
+			bool has_gzip = (entry->gzip_mtime != -1);
+
+			// the size of the read content is checked, the file maybe changed after the stat, then
+			// the entry will be reloaded at the next revalidation.
+			if (has_gzip && this->cache_.cacheable(entry->gzip_size) && _read_file(gzpath, entry->gzip) &&
+				entry->gzip.size() == entry->gzip_size)
+			{
+				entry->gzip_etag = _make_etag(entry->gzip_size, entry->gzip_mtime, "-gz");
+			}
+			else
+			{
+				entry->gzip.clear();
+			}
+
+			entry->fields = _make_fields(filepath, ftime, has_gzip);
+
+			entry->checked = clock_type::now().time_since_epoch().count();
+
+			return entry;
+		}
+
+		inline bool _make_entry_reply(http::request& req, http_static_reply& reply,
+			std::shared_ptr<http_static_entry> entry, bool accept_gzip)
+		{
+			std::uint64_t first = 0, last = 0;
+
+			int range = this->_parse_range(req, entry->etag, entry->size, first, last);
+
+			// the range is applied to the identity content only.
+			if (range == 0 && accept_gzip && !entry->gzip.empty())
+			{
+				if (!this->_make_header(req, reply, entry->fields, entry->gzip_etag, true,
+					range, 0, 0, entry->gzip.size()))
+				{
+					reply.body = std::string_view(entry->gzip);
+				}
+			}
+			else
+			{
+				if (!this->_make_header(req, reply, entry->fields, entry->etag, false,
+					range, first, last, entry->size))
+				{
+					reply.body = std::string_view(entry->body);
+
+					if (range > 0)
+						reply.body = reply.body.substr(std::size_t(first), std::size_t(last - first + 1));
+				}
+			}
+
+			reply.entry = std::move(entry);
+
+			return true;
+		}
+
+		inline bool _make_file_reply(http::request& req, http_static_reply& reply,
+			std::filesystem::path& filepath, bool accept_gzip)
+		{
+			std::error_code ec;
+
+			// each call clears the ec when it succeeds, so the ec must be checked after each call.
+			auto ftime = std::filesystem::last_write_time(filepath, ec);
+			if (ec)
+				return false;
+
+			std::uint64_t size = std::filesystem::file_size(filepath, ec);
+			if (ec)
+				return false;
+
+			std::filesystem::path gzpath = filepath;
+			gzpath += ".gz";
+
+			bool has_gzip = std::filesystem::is_regular_file(gzpath, ec);
+
+			std::string fields = _make_fields(filepath, ftime, has_gzip);
+			std::string etag = _make_etag(size, ftime.time_since_epoch().count(), {});
+
+			std::uint64_t first = 0, last = size ? size - 1 : 0;
+
+			int range = this->_parse_range(req, etag, size, first, last);
+
+			bool gzip = (range == 0 && accept_gzip && has_gzip);
+
+			if (gzip)
+			{
+				auto gztime = std::filesystem::last_write_time(gzpath, ec);
+				if (ec)
+					return false;
+
+				size  = std::filesystem::file_size(gzpath, ec);
+				if (ec)
+					return false;
+
+				etag  = _make_etag(size, gztime.time_since_epoch().count(), "-gz");
+				last  = size ? size - 1 : 0;
+			}
+
+			if (this->_make_header(req, reply, fields, etag, gzip, range, first, last, size))
+				return true;
+
+			auto file = std::make_shared<beast::file>();
+
+			beast::error_code bec;
+
+			file->open((gzip ? gzpath : filepath).string().c_str(), beast::file_mode::scan, bec);
+			if (bec)
+			{
+				reply.clear();
+				return false;
+			}
+
+			reply.file   = std::move(file);
+			reply.offset = first;
+			reply.length = size ? last - first + 1 : 0;
+
+			return true;
+		}
+
+		/**
+		 * @return : true if the response has no body.
+		 */
+		inline bool _make_header(http::request& req, http_static_reply& reply, std::string_view fields,
+			std::string_view etag, bool gzip, int range, std::uint64_t first, std::uint64_t last,
+			std::uint64_t size)
+		{
+			http::status result = http::status::ok;
+
+			std::string_view inm = req[http::field::if_none_match];
+			std::string_view ims = req[http::field::if_modified_since];
+
+			// the If-Modified-Since is ignored when the If-None-Match is present, see rfc 7232 6.
+			if (!inm.empty())
+			{
+				if (inm == "*" || inm.find(etag) != std::string_view::npos)
+					result = http::status::not_modified;
+			}
+			else if (!ims.empty() && _not_modified_since(fields, ims))
+			{
+				result = http::status::not_modified;
+			}
+
+			if (result != http::status::not_modified)
+			{
+				if (range < 0)
+					result = http::status::range_not_satisfiable;
+				else if (range > 0)
+					result = http::status::partial_content;
+			}
+
+			std::string& h = reply.header;
+
+			h += (req.version() == 10 ? "HTTP/1.0 " : "HTTP/1.1 ");
+			h += std::to_string(detail::to_underlying(result));
+			h += ' ';
+			h += http::obsolete_reason(result);
+			h += "\r\nServer: " BEAST_VERSION_STRING "\r\n";
+			h += fields;
+			h += "ETag: ";
+			h += etag;
+			h += "\r\n";
+
+			if (gzip)
+				h += "Content-Encoding: gzip\r\n";
+
+			bool no_body = (req.method() == http::verb::head);
+
+			switch (result)
+			{
+			case http::status::not_modified:
+				no_body = true;
+				break;
+			case http::status::range_not_satisfiable:
+				no_body = true;
+				h += "Content-Range: bytes */";
+				h += std::to_string(size);
+				h += "\r\nContent-Length: 0\r\n";
+				break;
+			case http::status::partial_content:
+				h += "Content-Range: bytes ";
+				h += std::to_string(first);
+				h += '-';
+				h += std::to_string(last);
+				h += '/';
+				h += std::to_string(size);
+				h += "\r\nContent-Length: ";
+				h += std::to_string(last - first + 1);
+				h += "\r\n";
+				break;
+			default:
+				h += "Content-Length: ";
+				h += std::to_string(size);
+				h += "\r\n";
+				break;
+			}
+
+			if (!req.keep_alive())
+				h += "Connection: close\r\n";
+			else if (req.version() == 10)
+				h += "Connection: keep-alive\r\n";
+
+			h += "\r\n";
+
+			return no_body;
+		}
+
+		/**
+		 * @function : get the size and the mtime of the "path.gz" file.
+		 * @return   : the mtime, or -1 if there is no this file.
+		 */
+		static inline std::int64_t _gzip_stat(const std::filesystem::path& filepath, std::uint64_t& size)
+		{
+			std::filesystem::path gzpath = filepath;
+			gzpath += ".gz";
+
+			std::error_code ec;
+
+			size = 0;
+
+			if (!std::filesystem::is_regular_file(gzpath, ec))
+				return -1;
+
+			std::uint64_t n = std::filesystem::file_size(gzpath, ec);
+			if (ec)
+				return -1;
+
+			std::int64_t mtime = std::filesystem::last_write_time(gzpath, ec).time_since_epoch().count();
+			if (ec)
+				return -1;
+
+			size = n;
+
+			return mtime;
+		}
+
+		/**
+		 * @return : true if the Accept-Encoding accepts the gzip, eg : "gzip;q=0" refuses it, and
+		 * "*" accepts it unless the gzip is listed explicitly, see rfc 7231 5.3.4.
+		 */
+		static inline bool _accept_gzip(std::string_view v)
+		{
+			int gzip = -1, any = -1;
+
+			for (auto const& ext : http::ext_list{ v })
+			{
+				// the q-value is 0 to 1 with at most 3 digits, it is 0 if there is no nonzero digit.
+				int accepted = 1;
+
+				for (auto const& param : ext.second)
+				{
+					if (beast::iequals(param.first, "q"))
+						accepted = (param.second.find_first_of("123456789") != std::string_view::npos);
+				}
+
+				if (beast::iequals(ext.first, "gzip") || beast::iequals(ext.first, "x-gzip"))
+					gzip = accepted;
+				else if (ext.first == "*")
+					any = accepted;
+			}
+
+			return (gzip != -1 ? gzip == 1 : any == 1);
+		}
+
+		/**
+		 * @return : true if the Last-Modified in the fields is not later than the If-Modified-Since,
+		 * the date which is invalid or later than the current time is ignored, see rfc 7232 3.3.
+		 */
+		static inline bool _not_modified_since(std::string_view fields, std::string_view ims)
+		{
+			constexpr std::string_view name = "Last-Modified: ";
+
+			std::size_t pos = fields.find(name);
+			if (pos == std::string_view::npos)
+				return false;
+
+			fields.remove_prefix(pos + name.size());
+			fields = fields.substr(0, fields.find('\r'));
+
+			std::int64_t last_modified = 0, since = 0;
+
+			if (!_parse_http_date(fields, last_modified) || !_parse_http_date(ims, since))
+				return false;
+
+			if (since > static_cast<std::int64_t>(std::time(nullptr)))
+				return false;
+
+			return (last_modified <= since);
+		}
+
+		/**
+		 * parse the IMF-fixdate, eg : "Sun, 06 Nov 1994 08:49:37 GMT", into the seconds since the
+		 * epoch, the obsolete rfc 850 and asctime formats are not supported.
+		 */
+		static inline bool _parse_http_date(std::string_view v, std::int64_t& t)
+		{
+			if (v.size() != 29 || v[3] != ',' || v[4] != ' ' || v[7] != ' ' || v[11] != ' ' ||
+				v[16] != ' ' || v[19] != ':' || v[22] != ':' || v.substr(25) != " GMT")
+				return false;
+
+			auto to_int = [v](std::size_t pos, std::size_t len, std::int64_t& n) -> bool
+			{
+				n = 0;
+				for (char c : v.substr(pos, len))
+				{
+					if (c < '0' || c > '9')
+						return false;
+					n = n * 10 + std::int64_t(c - '0');
+				}
+				return true;
+			};
+
+			constexpr std::string_view months = "JanFebMarAprMayJunJulAugSepOctNovDec";
+
+			std::size_t mon = months.find(v.substr(8, 3));
+			if (mon == std::string_view::npos || mon % 3 != 0)
+				return false;
+
+			std::int64_t y = 0, m = std::int64_t(mon / 3 + 1), d = 0, hh = 0, mm = 0, ss = 0;
+
+			if (!to_int(5, 2, d) || !to_int(12, 4, y) || !to_int(17, 2, hh) || !to_int(20, 2, mm) ||
+				!to_int(23, 2, ss))
+				return false;
+
+			if (d < 1 || d > 31 || hh > 23 || mm > 59 || ss > 60)
+				return false;
+
+			// the days from 1970-01-01, see http://howardhinnant.github.io/date_algorithms.html
+			y -= (m <= 2);
+			std::int64_t era = (y >= 0 ? y : y - 399) / 400;
+			std::int64_t yoe = y - era * 400;
+			std::int64_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+			std::int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+			std::int64_t days = era * 146097 + doe - 719468;
+
+			t = days * 86400 + hh * 3600 + mm * 60 + ss;
+
+			return true;
+		}
+
+		/**
+		 * @return : 0 - no range or the range is ignored, 1 - the range [first, last] is valid,
+		 *          -1 - the range is not satisfiable.
+		 */
+		inline int _parse_range(http::request& req, std::string_view etag, std::uint64_t size,
+			std::uint64_t& first, std::uint64_t& last)
+		{
+			std::string_view v = req[http::field::range];
+
+			if (v.empty() || v.substr(0, 6) != "bytes=")
+				return 0;
+
+			// the range is ignored if the file is changed.
+			std::string_view if_range = req[http::field::if_range];
+			if (!if_range.empty() && if_range != etag)
+				return 0;
+
+			v.remove_prefix(6);
+
+			// multiple ranges are not supported, send the whole file.
+			if (v.find(',') != std::string_view::npos)
+				return 0;
+
+			std::size_t dash = v.find('-');
+			if (dash == std::string_view::npos)
+				return 0;
+
+			std::string_view a = v.substr(0, dash), b = v.substr(dash + 1);
+
+			auto to_uint = [](std::string_view s, std::uint64_t& n) -> bool
+			{
+				if (s.empty() || s.size() > 19)
+					return false;
+
+				n = 0;
+				for (char c : s)
+				{
+					if (c < '0' || c > '9')
+						return false;
+					n = n * 10 + std::uint64_t(c - '0');
+				}
+				return true;
+			};
+
+			std::uint64_t x = 0, y = 0;
+
+			if (a.empty())
+			{
+				// the last y bytes
+				if (!to_uint(b, y))
+					return 0;
+
+				if (y == 0 || size == 0)
+					return -1;
+
+				first = (y >= size ? 0 : size - y);
+				last  = size - 1;
+
+				return 1;
+			}
+
+			if (!to_uint(a, x))
+				return 0;
+
+			if (!b.empty() && (!to_uint(b, y) || y < x))
+				return 0;
+
+			if (x >= size)
+				return -1;
+
+			first = x;
+			last  = (b.empty() || y >= size) ? size - 1 : y;
+
+			return 1;
+		}
+
+		static inline bool _read_file(const std::filesystem::path& filepath, std::string& content)
+		{
+			beast::file file;
+			beast::error_code ec;
+
+			file.open(filepath.string().c_str(), beast::file_mode::scan, ec);
+			if (ec)
+				return false;
+
+			std::uint64_t size = file.size(ec);
+			if (ec)
+				return false;
+
+			content.resize(std::size_t(size));
+
+			std::size_t n = 0;
+			while (n < content.size())
+			{
+				std::size_t bytes = file.read(content.data() + n, content.size() - n, ec);
+				if (ec || bytes == 0)
+					return false;
+				n += bytes;
+			}
+
+			return true;
+		}
+
+		static inline std::string _make_etag(std::uint64_t size, std::int64_t mtime, std::string_view suffix)
+		{
+			char buf[64];
+
+			int n = std::snprintf(buf, sizeof(buf), "\"%llx-%llx", static_cast<unsigned long long>(size),
+				static_cast<unsigned long long>(mtime));
+
+			std::string etag(buf, std::size_t(n));
+			etag += suffix;
+			etag += '"';
+
+			return etag;
+		}
+
+		static inline std::string _make_fields(const std::filesystem::path& filepath,
+			std::filesystem::file_time_type ftime, bool has_gzip)
+		{
+			using namespace std::chrono;
+
+			// the file clock of c++17 can't be converted to the system clock directly.
+			std::time_t t = system_clock::to_time_t(time_point_cast<system_clock::duration>(
+				ftime - std::filesystem::file_time_type::clock::now() + system_clock::now()));
+
+			std::tm tm{};
+
+		#if defined(_WIN32) || defined(_WIN64)
+			::gmtime_s(&tm, &t);
+		#else
+			::gmtime_r(&t, &tm);
+		#endif
+
+			char date[64];
+			std::size_t n = std::strftime(date, sizeof(date), "%a, %d %b %Y %H:%M:%S GMT", &tm);
+
+			std::string fields;
+
+			fields += "Content-Type: ";
+			fields += http::extension_to_mimetype(filepath.extension().string());
+			fields += "\r\nLast-Modified: ";
+			fields += std::string_view(date, n);
+			fields += "\r\nAccept-Ranges: bytes\r\n";
+
+			if (has_gzip)
+				fields += "Vary: Accept-Encoding\r\n";
+
+			return fields;
+		}
+
+	protected:
+		/// the uri prefix and the directory
+		std::vector<std::pair<std::string, std::filesystem::path>> mounts_;
+
+		http_static_cache                                          cache_;
+
+		/// the cached file is checked whether it is modified at most once in this duration
+		std::chrono::milliseconds                                  revalidate_{ 1000 };
+
+		std::atomic<std::uint64_t>                                 hits_     { 0 };
+		std::atomic<std::uint64_t>                                 misses_   { 0 };
+		std::atomic<std::uint64_t>                                 sendfiles_{ 0 };
+	};
+}
+
+namespace asio2
+{
+	using http_static_stats = detail::http_static_stats;
+}
+
+#include <asio2/base/detail/pop_options.hpp>
+
+#endif // !__ASIO2_HTTP_STATIC_HPP__
@@ -20,6 +20,7 @@
 #include <asio2/tcp/tcp_client.hpp>
 
 #include <asio2/http/detail/http_util.hpp>
+#include <asio2/http/detail/http_client_pool.hpp>
 #include <asio2/http/impl/http_send_op.hpp>
 #include <asio2/http/impl/http_recv_op.hpp>
 
@@ -139,7 +140,7 @@ namespace asio2::detail
 
 				// The io_context is required for all I/O
 				asio::io_context ioc;
-				asio::io_context::strand strand(ioc);
+				io_strand_t strand = make_io_strand(ioc);
 
 				// These objects perform our I/O
 				asio::ip::tcp::resolver resolver{ ioc };
@@ -626,6 +627,9 @@ namespace asio2::detail
 		template<typename MatchCondition>
 		inline void _fire_recv(std::shared_ptr<derived_t>& this_ptr, condition_wrap<MatchCondition>& condition)
 		{
+			// the bytes are counted in _http_handle_recv, the pipelined requests are recved together.
+			detail::metrics_recv_scope ms(this->derived().io().metrics(), 0);
+
 			this->listener_.notify(event_type::recv, this->req_, this->rep_);
 
 			this->derived()._rdc_handle_recv(this_ptr, this->rep_, condition);
@@ -113,11 +113,25 @@ namespace asio2::detail
 			return (this->derived());
 		}
 
+		/**
+		 * @function : bind a GET route which responds the metrics of this server in the
+		 * prometheus text format, see iopool_cp::metrics.
+		 * eg : server.bind_metrics("/metrics");
+		 */
+		inline derived_t & bind_metrics(std::string path = "/metrics")
+		{
+			this->template bind<http::verb::get>(std::move(path), [this](http::request&, http::response& rep)
+			{
+				rep.fill_text(this->metrics().to_prometheus(), http::status::ok, "text/plain; version=0.0.4");
+			});
+			return (this->derived());
+		}
+
 	protected:
 		template<typename... Args>
-		inline std::shared_ptr<session_t> _make_session(Args&&... args)
+		inline std::shared_ptr<session_t> _make_session(io_t& io, Args&&... args)
 		{
-			return super::_make_session(std::forward<Args>(args)..., *this,
+			return super::_make_session(io, std::forward<Args>(args)..., *this,
 				this->root_directory_, this->is_arg0_session_, this->support_websocket_);
 		}
 
@@ -21,6 +21,8 @@
 #include <asio2/http/component/ws_stream_cp.hpp>
 #include <asio2/http/impl/http_send_op.hpp>
 #include <asio2/http/impl/http_recv_op.hpp>
+#include <asio2/http/impl/http_static_op.hpp>
+#include <asio2/http/impl/http_pipeline_op.hpp>
 #include <asio2/http/impl/ws_send_op.hpp>
 #include <asio2/http/detail/http_router.hpp>
 
@@ -45,6 +47,8 @@ namespace asio2::detail
 		: public tcp_session_impl_t<derived_t, args_t>
 		, public http_send_op      <derived_t, args_t>
 		, public http_recv_op      <derived_t, args_t>
+		, public http_static_op    <derived_t, args_t>
+		, public http_pipeline_op  <derived_t, args_t>
 		, public ws_stream_cp      <derived_t, args_t>
 		, public ws_send_op        <derived_t, args_t>
 	{
@@ -84,9 +88,11 @@ namespace asio2::detail
 			std::size_t                max_buf_size
 		)
 			: super(sessions, listener, rwio, init_buf_size, max_buf_size)
-			, http_send_op<derived_t, args_t>()
-			, ws_stream_cp<derived_t, args_t>()
-			, ws_send_op  <derived_t, args_t>()
+			, http_send_op  <derived_t, args_t>()
+			, http_static_op<derived_t, args_t>()
+			, http_pipeline_op<derived_t, args_t>()
+			, ws_stream_cp  <derived_t, args_t>()
+			, ws_send_op    <derived_t, args_t>()
 			, req_()
 			, rep_()
 			, router_(router)
@@ -270,7 +276,7 @@ namespace asio2::detail
 		inline void _handle_upgrade(const error_code & ec, std::shared_ptr<derived_t> self_ptr,
 			condition_wrap<MatchCondition> condition)
 		{
-			this->derived().sessions().post(
+			this->derived().sessions().post(this->derived().hash_key(),
 			[this, ec, this_ptr = std::move(self_ptr), condition = std::move(condition)]
 			() mutable
 			{
@@ -379,7 +385,7 @@ namespace asio2::detail
 		inline void _fire_upgrade(std::shared_ptr<derived_t>& this_ptr, error_code ec)
 		{
 			// the _fire_upgrade must be executed in the thread 0.
-			ASIO2_ASSERT(this->sessions().io().strand().running_in_this_thread());
+			ASIO2_ASSERT(this->sessions().io(this->derived().hash_key()).strand().running_in_this_thread());
 
 			this->listener_.notify(event_type::upgrade, this_ptr, ec);
 		}
@@ -387,11 +393,22 @@ namespace asio2::detail
 		template<typename MatchCondition>
 		inline void _fire_recv(std::shared_ptr<derived_t>& this_ptr, condition_wrap<MatchCondition>& condition)
 		{
+			// the bytes are counted in _http_handle_recv, the pipelined requests are recved together.
+			detail::metrics_recv_scope ms(this->derived().io().metrics(), 0);
+
 			if (this->is_arg0_session_)
 				this->listener_.notify(event_type::recv, this_ptr, this->req_, this->rep_);
 			else
 				this->listener_.notify(event_type::recv, this->req_, this->rep_);
 
+			// the static file is sent without the router and the response object.
+			if (this->is_http() && this->router_._static_files().make_reply(this->req_, this->static_reply_))
+			{
+				this->derived()._http_pipeline_flush(this_ptr, condition, false);
+				this->derived()._http_send_static(this_ptr, condition);
+				return;
+			}
+
 			this->router_._route(this_ptr, this->req_, this->rep_);
 
 			if (this->is_websocket())
@@ -399,11 +416,16 @@ namespace asio2::detail
 
 			if (this->rep_.defer_guard_)
 			{
+				// flush the batch before the guard is released, the deferred response may be sent
+				// by the guard destructor, and it must be queued after the batched responses.
+				if (this->is_http())
+					this->derived()._http_pipeline_flush(this_ptr, condition, false);
+
 				this->rep_.defer_guard_.reset();
 			}
 			else
 			{
-				if (this->is_http())
+				if (this->is_http() && !this->derived()._http_pipeline_append(this_ptr, condition))
 					this->derived()._send_response(this_ptr, condition);
 			}
 		}
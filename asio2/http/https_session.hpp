@@ -157,7 +157,7 @@ namespace asio2::detail
 		inline void _fire_handshake(std::shared_ptr<derived_t>& this_ptr, error_code ec)
 		{
 			// the _fire_handshake must be executed in the thread 0.
-			ASIO2_ASSERT(this->sessions().io().strand().running_in_this_thread());
+			ASIO2_ASSERT(this->sessions().io(this->derived().hash_key()).strand().running_in_this_thread());
 
 			this->listener_.notify(event_type::handshake, this_ptr, ec);
 		}
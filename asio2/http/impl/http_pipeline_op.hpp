@@ -0,0 +1,261 @@
+/*
+ * COPYRIGHT (C) 2017-2021, zhllxt
+ *
+ * author   : zhllxt
+ * email    : 37792738@qq.com
+ *
+ * Distributed under the GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+ * (See accompanying file LICENSE or see <http://www.gnu.org/licenses/>)
+ */
+
+#ifndef __ASIO2_HTTP_PIPELINE_OP_HPP__
+#define __ASIO2_HTTP_PIPELINE_OP_HPP__
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+#pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include <asio2/3rd/asio.hpp>
+#include <asio2/3rd/beast.hpp>
+#include <asio2/base/error.hpp>
+
+#include <asio2/http/detail/http_util.hpp>
+
+namespace asio2::detail
+{
+	/**
+	 * HTTP/1.1 pipelining for the http session.
+	 * When a request is handled and the next complete request is already in the recv buffer, the
+	 * response is serialized into the pipeline buffer instead of being sent, and the next request
+	 * is handled at once without reading. When there is no more complete request in the buffer,
+	 * or the batch is full, all the serialized responses are sent by one write.
+	 * Only the keep-alive responses with the text body are batched, the file responses, the static
+	 * files, the deferred responses and the websocket upgrade flush the batch first and then are
+	 * sent in the normal way, so the responses are always sent in the order of the requests.
+	 */
+	template<class derived_t, class args_t>
+	class http_pipeline_op
+	{
+	public:
+		using body_type   = typename args_t::body_t;
+		using buffer_type = typename args_t::buffer_t;
+
+		/**
+		 * @constructor
+		 */
+		http_pipeline_op() {}
+
+		/**
+		 * @destructor
+		 */
+		~http_pipeline_op() = default;
+
+	protected:
+		/**
+		 * @function : serialize the response of the current request into the pipeline buffer.
+		 * @return   : false if the response can't be batched, the caller should send it in the
+		 * normal way, and the batch has been flushed already.
+		 */
+		template<typename MatchCondition>
+		inline bool _http_pipeline_append(std::shared_ptr<derived_t>& this_ptr,
+			condition_wrap<MatchCondition>& condition)
+		{
+			derived_t& derive = static_cast<derived_t&>(*this);
+
+			bool batchable = derive._router().pipeline_limit() > std::size_t(1) &&
+				derive.rep_.body().is_text() && derive.req_.keep_alive() && !derive.req_.need_eof();
+
+			// if the batch is empty and there is no more request in the buffer, send the response
+			// in the normal way, so the non pipelined requests have no extra copy.
+			if (batchable && (this->pipeline_count_ > 0 || derive._http_pipeline_parse()))
+			{
+				std::size_t size = this->pipeline_buffer_.size();
+
+				error_code ec;
+
+				http::response_serializer<typename std::remove_reference_t<
+					decltype(derive.rep_.base())>::body_type> sr(derive.rep_.base());
+
+				do
+				{
+					sr.next(ec, [this, &sr](error_code& ec, auto const& buffers)
+					{
+						ec = {};
+
+						std::size_t bytes = 0;
+
+						for (auto b : beast::buffers_range_ref(buffers))
+						{
+							this->pipeline_buffer_.append(static_cast<const char*>(b.data()), b.size());
+							bytes += b.size();
+						}
+
+						sr.consume(bytes);
+					});
+				} while (!ec && !sr.is_done());
+
+				if (!ec)
+				{
+					++(this->pipeline_count_);
+
+					// the response is moved out in the normal way, so make it empty for the next request.
+					derive.rep_.reset();
+
+					return true;
+				}
+
+				this->pipeline_buffer_.resize(size);
+			}
+
+			derive._http_pipeline_flush(this_ptr, condition, false);
+
+			return false;
+		}
+
+		/**
+		 * @function : handle the next request in the buffer if the response of the current request is
+		 * batched, otherwise send the batched responses and read again.
+		 */
+		template<typename MatchCondition>
+		inline void _http_pipeline_next(std::shared_ptr<derived_t> this_ptr, condition_wrap<MatchCondition> condition)
+		{
+			derived_t& derive = static_cast<derived_t&>(*this);
+
+			// the response was sent in the normal way, and it will read again after sent.
+			if (this->pipeline_count_ == 0)
+				return;
+
+			if (this->pipeline_count_ < derive._router().pipeline_limit() &&
+				(this->pipeline_parser_ || derive._http_pipeline_parse()) &&
+				!websocket::is_upgrade(this->pipeline_parser_->get()))
+			{
+				std::size_t bytes = this->pipeline_bytes_;
+
+				derive.req_.base() = this->pipeline_parser_->release();
+
+				derive.buffer().consume(bytes);
+
+				this->pipeline_parser_.reset();
+
+				derive._handle_recv(error_code{}, bytes, std::move(this_ptr), std::move(condition));
+
+				return;
+			}
+
+			// the parsed request is discarded, it is still in the buffer and will be read again.
+			this->pipeline_parser_.reset();
+
+			derive._http_pipeline_flush(this_ptr, condition, true);
+		}
+
+		/**
+		 * @function : parse the next complete request in the buffer without consuming the buffer.
+		 * @return   : false if there is no complete request in the buffer.
+		 */
+		inline bool _http_pipeline_parse()
+		{
+			derived_t& derive = static_cast<derived_t&>(*this);
+
+			this->pipeline_parser_.reset();
+
+			if (derive.buffer().size() == 0)
+				return false;
+
+			this->pipeline_parser_.emplace();
+
+			http::request_parser<body_type>& parser = *(this->pipeline_parser_);
+
+			parser.eager(true);
+
+			asio::const_buffer data = derive.buffer().base().data();
+
+			std::size_t used = 0;
+
+			error_code ec;
+
+			while (!parser.is_done())
+			{
+				std::size_t bytes = parser.put(data + used, ec);
+
+				used += bytes;
+
+				// the request is not complete, or it is invalid, leave it for the http::async_read.
+				if (ec || bytes == 0)
+				{
+					this->pipeline_parser_.reset();
+					return false;
+				}
+			}
+
+			this->pipeline_bytes_ = used;
+
+			return true;
+		}
+
+		/**
+		 * @function : send the batched responses by one write.
+		 * @param    : post_recv - whether read again after sent
+		 */
+		template<typename MatchCondition>
+		inline void _http_pipeline_flush(std::shared_ptr<derived_t>& this_ptr,
+			condition_wrap<MatchCondition>& condition, bool post_recv)
+		{
+			derived_t& derive = static_cast<derived_t&>(*this);
+
+			if (this->pipeline_count_ == 0)
+				return;
+
+			std::size_t count = this->pipeline_count_;
+
+			this->pipeline_count_ = 0;
+
+			derive.push_event([&derive, this_ptr, condition, post_recv, count]
+			(event_queue_guard<derived_t>&& g) mutable
+			{
+				asio::async_write(derive.stream(), asio::buffer(derive.pipeline_buffer_),
+					asio::bind_executor(derive.io().strand(), make_allocator(derive.wallocator(),
+				[&derive, this_ptr = std::move(this_ptr), condition = std::move(condition), post_recv, count,
+					g = std::move(g)](const error_code& ec, std::size_t bytes_sent) mutable
+				{
+					detail::ignore_unused(g);
+
+					set_last_error(ec);
+
+					derive.pipeline_buffer_.clear();
+
+					if (ec)
+					{
+						// must stop, otherwise re-sending will cause body confusion
+						derive._do_disconnect(ec);
+						return;
+					}
+
+					derive.io().metrics().messages_out.add(count);
+					derive.io().metrics().bytes_out   .add(bytes_sent);
+
+					if (post_recv)
+						derive._post_recv(std::move(this_ptr), std::move(condition));
+				})));
+			});
+		}
+
+	protected:
+		/// the serialized responses which are not sent yet
+		std::string                                      pipeline_buffer_;
+
+		/// the count of the responses in the pipeline buffer
+		std::size_t                                      pipeline_count_ = 0;
+
+		/// the next request which is parsed from the buffer, and the bytes of it
+		std::optional<http::request_parser<body_type>>   pipeline_parser_;
+
+		std::size_t                                      pipeline_bytes_ = 0;
+	};
+}
+
+#endif // !__ASIO2_HTTP_PIPELINE_OP_HPP__
@@ -117,10 +117,10 @@ namespace asio2::detail
 
 			set_last_error(ec);
 
-			std::ignore = bytes_recvd;
-
 			if (!ec)
 			{
+				derive.io().metrics().bytes_in.add(bytes_recvd);
+
 				// every times recv data,we update the last alive time.
 				derive.update_alive_time();
 
@@ -153,6 +153,9 @@ namespace asio2::detail
 							derive._do_disconnect(asio::error::operation_aborted);
 							return;
 						}
+
+						// if the response is batched, handle the next request in the buffer directly.
+						derive._http_pipeline_next(std::move(this_ptr), std::move(condition));
 					}
 					else
 					{
@@ -0,0 +1,298 @@
+/*
+ * COPYRIGHT (C) 2017-2021, zhllxt
+ *
+ * author   : zhllxt
+ * email    : 37792738@qq.com
+ *
+ * Distributed under the GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+ * (See accompanying file LICENSE or see <http://www.gnu.org/licenses/>)
+ */
+
+#ifndef __ASIO2_HTTP_STATIC_OP_HPP__
+#define __ASIO2_HTTP_STATIC_OP_HPP__
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+#pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <array>
+#include <memory>
+#include <tuple>
+#include <utility>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <cstdio>
+#include <sys/sendfile.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#endif
+
+#include <asio2/3rd/asio.hpp>
+#include <asio2/3rd/beast.hpp>
+#include <asio2/base/error.hpp>
+
+#include <asio2/http/detail/http_static.hpp>
+
+namespace asio2::detail
+{
+	template<class derived_t, class args_t>
+	class http_static_op
+	{
+	public:
+		/**
+		 * @constructor
+		 */
+		http_static_op() {}
+
+		/**
+		 * @destructor
+		 */
+		~http_static_op() = default;
+
+	protected:
+		/**
+		 * @function : send the static file response which is made by http_static_files::make_reply
+		 * the header and the cached body are sent by one write, the file body is sent by sendfile
+		 * for plain http on linux, otherwise it is read and sent by chunks.
+		 */
+		template<typename MatchCondition>
+		inline void _http_send_static(std::shared_ptr<derived_t> this_ptr, condition_wrap<MatchCondition> condition)
+		{
+			derived_t& derive = static_cast<derived_t&>(*this);
+
+			derive.push_event([&derive, this_ptr = std::move(this_ptr), condition = std::move(condition)]
+			(event_queue_guard<derived_t>&& g) mutable
+			{
+				http_static_reply& reply = derive.static_reply_;
+
+				// hold the header in the socket buffer until the file body follows, otherwise the
+				// header and the body are sent as two small segments and the nagle algorithm delays
+				// the body until the header is acked.
+				if (reply.file && reply.length > 0)
+					derive._http_static_cork(true);
+
+				std::array<asio::const_buffer, 2> buffers
+				{
+					asio::buffer(reply.header),
+					asio::buffer(reply.body.data(), reply.body.size())
+				};
+
+				asio::async_write(derive.stream(), buffers, asio::bind_executor(derive.io().strand(),
+					make_allocator(derive.wallocator(),
+				[&derive, this_ptr = std::move(this_ptr), condition = std::move(condition), g = std::move(g)]
+				(const error_code& ec, std::size_t bytes_sent) mutable
+				{
+					if (!ec)
+						derive.io().metrics().bytes_out.add(bytes_sent);
+
+					if (ec || !derive.static_reply_.file || derive.static_reply_.length == 0)
+					{
+						derive._handle_static_sent(ec, std::move(this_ptr), std::move(condition), std::move(g));
+						return;
+					}
+
+					derive._http_send_static_file(std::move(this_ptr), std::move(condition), std::move(g));
+				})));
+			});
+		}
+
+		template<typename MatchCondition>
+		inline void _http_send_static_file(std::shared_ptr<derived_t> this_ptr,
+			condition_wrap<MatchCondition> condition, event_queue_guard<derived_t> g)
+		{
+			derived_t& derive = static_cast<derived_t&>(*this);
+
+		#if defined(__linux__)
+			// the sendfile can only be used for the plain socket, the data of the ssl stream must be
+			// encrypted in the user space.
+			if constexpr (std::is_same_v<std::remove_reference_t<decltype(derive.stream())>, asio::ip::tcp::socket>)
+			{
+				derive._router()._static_files().count_sendfile();
+
+				derive._http_sendfile(std::move(this_ptr), std::move(condition), std::move(g));
+				return;
+			}
+		#endif
+
+			derive._http_send_static_chunk(std::move(this_ptr), std::move(condition), std::move(g));
+		}
+
+		inline void _http_static_cork(bool on)
+		{
+		#if defined(__linux__)
+			derived_t& derive = static_cast<derived_t&>(*this);
+
+			if constexpr (std::is_same_v<std::remove_reference_t<decltype(derive.stream())>, asio::ip::tcp::socket>)
+			{
+				if (this->static_corked_ == on)
+					return;
+
+				this->static_corked_ = on;
+
+				int value = on ? 1 : 0;
+				::setsockopt(derive.stream().native_handle(), IPPROTO_TCP, TCP_CORK, &value, sizeof(value));
+			}
+		#else
+			std::ignore = on;
+		#endif
+		}
+
+	#if defined(__linux__)
+		template<typename MatchCondition>
+		inline void _http_sendfile(std::shared_ptr<derived_t> this_ptr,
+			condition_wrap<MatchCondition> condition, event_queue_guard<derived_t> g)
+		{
+			derived_t& derive = static_cast<derived_t&>(*this);
+
+			http_static_reply& reply = this->static_reply_;
+
+			asio::ip::tcp::socket& socket = derive.stream();
+
+			error_code ec;
+
+			// the sendfile returns EAGAIN when the socket buffer is full, then wait for the socket
+			// to be writable.
+			if (!socket.native_non_blocking())
+				socket.native_non_blocking(true, ec);
+
+			int fd = ::fileno(reply.file->native_handle());
+
+			while (!ec && reply.length > 0)
+			{
+				off_t offset = static_cast<off_t>(reply.offset);
+
+				ssize_t n = ::sendfile(socket.native_handle(), fd, &offset,
+					static_cast<std::size_t>((std::min)(reply.length, std::uint64_t(0x40000000))));
+
+				if (n > 0)
+				{
+					reply.offset += static_cast<std::uint64_t>(n);
+					reply.length -= static_cast<std::uint64_t>(n);
+
+					derive.io().metrics().bytes_out.add(static_cast<std::size_t>(n));
+				}
+				else if (n == 0)
+				{
+					// the file is truncated
+					ec = asio::error::eof;
+				}
+				else if (errno == EAGAIN || errno == EWOULDBLOCK)
+				{
+					socket.async_wait(asio::socket_base::wait_write, asio::bind_executor(derive.io().strand(),
+					[&derive, this_ptr = std::move(this_ptr), condition = std::move(condition), g = std::move(g)]
+					(const error_code& ec) mutable
+					{
+						if (ec)
+						{
+							derive._handle_static_sent(ec, std::move(this_ptr), std::move(condition), std::move(g));
+							return;
+						}
+
+						derive._http_sendfile(std::move(this_ptr), std::move(condition), std::move(g));
+					}));
+					return;
+				}
+				else if (errno != EINTR)
+				{
+					ec = error_code(errno, asio::error::get_system_category());
+				}
+			}
+
+			derive._handle_static_sent(ec, std::move(this_ptr), std::move(condition), std::move(g));
+		}
+	#endif
+
+		template<typename MatchCondition>
+		inline void _http_send_static_chunk(std::shared_ptr<derived_t> this_ptr,
+			condition_wrap<MatchCondition> condition, event_queue_guard<derived_t> g)
+		{
+			derived_t& derive = static_cast<derived_t&>(*this);
+
+			http_static_reply& reply = this->static_reply_;
+
+			if (!this->static_chunk_)
+				this->static_chunk_ = std::make_unique<char[]>(static_chunk_size);
+
+			beast::error_code ec;
+
+			reply.file->seek(reply.offset, ec);
+
+			std::size_t n = 0;
+
+			if (!ec)
+				n = reply.file->read(this->static_chunk_.get(), static_cast<std::size_t>(
+					(std::min)(reply.length, std::uint64_t(static_chunk_size))), ec);
+
+			if (!ec && n == 0)
+				ec = asio::error::eof;
+
+			if (ec)
+			{
+				derive._handle_static_sent(ec, std::move(this_ptr), std::move(condition), std::move(g));
+				return;
+			}
+
+			reply.offset += n;
+			reply.length -= n;
+
+			asio::async_write(derive.stream(), asio::buffer(this->static_chunk_.get(), n),
+				asio::bind_executor(derive.io().strand(),
+			[&derive, this_ptr = std::move(this_ptr), condition = std::move(condition), g = std::move(g)]
+			(const error_code& ec, std::size_t bytes_sent) mutable
+			{
+				if (!ec)
+					derive.io().metrics().bytes_out.add(bytes_sent);
+
+				if (ec || derive.static_reply_.length == 0)
+				{
+					derive._handle_static_sent(ec, std::move(this_ptr), std::move(condition), std::move(g));
+					return;
+				}
+
+				derive._http_send_static_chunk(std::move(this_ptr), std::move(condition), std::move(g));
+			}));
+		}
+
+		template<typename MatchCondition>
+		inline void _handle_static_sent(const error_code& ec, std::shared_ptr<derived_t> this_ptr,
+			condition_wrap<MatchCondition> condition, event_queue_guard<derived_t> g)
+		{
+			derived_t& derive = static_cast<derived_t&>(*this);
+
+			detail::ignore_unused(g);
+
+			set_last_error(ec);
+
+			this->static_reply_.clear();
+
+			// flush the tail of the file body
+			derive._http_static_cork(false);
+
+			if (ec)
+			{
+				// must stop, otherwise re-sending will cause body confusion
+				derive._do_disconnect(ec);
+				return;
+			}
+
+			derive.io().metrics().messages_out.add(1);
+
+			derive._post_recv(std::move(this_ptr), std::move(condition));
+		}
+
+	protected:
+		static constexpr std::size_t   static_chunk_size = 64 * 1024;
+
+		/// the static file response of the current request
+		http_static_reply              static_reply_;
+
+		/// the buffer which is used to read the file when sendfile can't be used
+		std::unique_ptr<char[]>        static_chunk_;
+
+		/// whether the TCP_CORK is set on the socket
+		bool                           static_corked_ = false;
+	};
+}
+
+#endif // !__ASIO2_HTTP_STATIC_OP_HPP__
@@ -20,6 +20,7 @@
 #include <asio2/base/component/user_data_cp.hpp>
 
 #include <asio2/http/detail/http_util.hpp>
+#include <asio2/http/detail/http_radix_tree.hpp>
 
 #ifdef BEAST_HEADER_ONLY
 namespace beast::websocket
@@ -32,6 +33,8 @@ namespace boost::beast::websocket
 
 namespace asio2::detail
 {
+	template<class> class http_router_t;
+
 	ASIO2_CLASS_FORWARD_DECLARE_BASE;
 	ASIO2_CLASS_FORWARD_DECLARE_TCP_BASE;
 	ASIO2_CLASS_FORWARD_DECLARE_TCP_CLIENT;
@@ -45,6 +48,7 @@ namespace asio2::detail
 #endif
 	{
 		template <class>                             friend class beast::websocket::listener;
+		template <class>                             friend class asio2::detail::http_router_t;
 
 		ASIO2_CLASS_FRIEND_DECLARE_BASE;
 		ASIO2_CLASS_FRIEND_DECLARE_TCP_BASE;
@@ -73,28 +77,44 @@ namespace asio2::detail
 			this->base() = o.base();
 			this->ws_frame_type_ = o.ws_frame_type_;
 			this->ws_frame_data_ = o.ws_frame_data_;
+			this->url_parser_    = o.url_parser_;
+			this->route_params_.assign(o.route_params_, o.target(), this->target());
 		}
 
 		http_request_impl_t(http_request_impl_t&& o) : super()
 		{
+			// the route params point to the target of "o", get it before it is moved.
+			std::string_view target = o.target();
 			this->base() = std::move(o.base());
 			this->ws_frame_type_ = o.ws_frame_type_;
 			this->ws_frame_data_ = o.ws_frame_data_;
+			this->url_parser_    = o.url_parser_;
+			this->route_params_.assign(o.route_params_, target, this->target());
 		}
 
 		self& operator=(const http_request_impl_t& o)
 		{
+			if (this == std::addressof(o))
+				return *this;
 			this->base() = o.base();
 			this->ws_frame_type_ = o.ws_frame_type_;
 			this->ws_frame_data_ = o.ws_frame_data_;
+			this->url_parser_    = o.url_parser_;
+			this->route_params_.assign(o.route_params_, o.target(), this->target());
 			return *this;
 		}
 
 		self& operator=(http_request_impl_t&& o)
 		{
+			if (this == std::addressof(o))
+				return *this;
+			// the route params point to the target of "o", get it before it is moved.
+			std::string_view target = o.target();
 			this->base() = std::move(o.base());
 			this->ws_frame_type_ = o.ws_frame_type_;
 			this->ws_frame_data_ = o.ws_frame_data_;
+			this->url_parser_    = o.url_parser_;
+			this->route_params_.assign(o.route_params_, target, this->target());
 			return *this;
 		}
 
@@ -111,12 +131,14 @@ namespace asio2::detail
 		self& operator=(const http::message<true, Body, Fields>& req)
 		{
 			this->base() = req;
+			this->route_params_.clear();
 			return *this;
 		}
 
 		self& operator=(http::message<true, Body, Fields>&& req)
 		{
 			this->base() = std::move(req);
+			this->route_params_.clear();
 			return *this;
 		}
 
@@ -180,6 +202,25 @@ namespace asio2::detail
 				url_parser_.field_data[(int)http::http_parser_ns::url_fields::UF_QUERY].len };
 		}
 
+		/**
+		 * @function : Gets the path params which are captured by the http router, eg : the route
+		 * is "/user/:id/" with a trailing "*", and the path is "/user/9/avatar/big.png", then the
+		 * params are : { "id", "9" }, { "*", "avatar/big.png" }
+		 */
+		inline const http_route_params& route_params() const
+		{
+			return this->route_params_;
+		}
+
+		/**
+		 * @function : Gets the path param which is captured by the http router by name, return
+		 * empty string_view if not found. eg : req.route_param("id");
+		 */
+		inline std::string_view route_param(std::string_view name) const
+		{
+			return this->route_params_.get(name);
+		}
+
 		/**
 		 * @function : Returns `true` if this HTTP request's Content-Type is "multipart/form-data";
 		 */
@@ -200,6 +241,7 @@ namespace asio2::detail
 		http::http_parser_ns::http_parser_url url_parser_;
 		websocket::frame                      ws_frame_type_ = websocket::frame::unknown;
 		std::string_view                      ws_frame_data_;
+		http_route_params                     route_params_;
 	};
 }
 
@@ -120,7 +120,7 @@ namespace asio2::detail
 		{
 			detail::ignore_unused(ec);
 
-			ASIO2_ASSERT(this->derived().sessions().io().strand().running_in_this_thread());
+			ASIO2_ASSERT(this->derived().sessions().io(this->derived().hash_key()).strand().running_in_this_thread());
 
 			asio::dispatch(this->io_.strand(), make_allocator(this->wallocator_,
 			[this, self_ptr = std::move(this_ptr), condition = std::move(condition)]() mutable
@@ -156,7 +156,7 @@ namespace asio2::detail
 		inline void _fire_upgrade(std::shared_ptr<derived_t>& this_ptr, error_code ec)
 		{
 			// the _fire_upgrade must be executed in the thread 0.
-			ASIO2_ASSERT(this->sessions().io().strand().running_in_this_thread());
+			ASIO2_ASSERT(this->sessions().io(this->derived().hash_key()).strand().running_in_this_thread());
 
 			this->listener_.notify(event_type::upgrade, this_ptr, ec);
 		}
@@ -119,7 +119,7 @@ namespace asio2::detail
 		{
 			detail::ignore_unused(ec);
 
-			ASIO2_ASSERT(this->derived().sessions().io().strand().running_in_this_thread());
+			ASIO2_ASSERT(this->derived().sessions().io(this->derived().hash_key()).strand().running_in_this_thread());
 
 			asio::dispatch(this->derived().io().strand(), make_allocator(this->derived().wallocator(),
 			[this, this_ptr = std::move(this_ptr), condition = std::move(condition)]() mutable
@@ -140,10 +140,10 @@ namespace asio2::detail
 
 			// Use "sessions().dispatch" to ensure that the _fire_accept function and the _fire_handshake
 			// function are fired in the same thread
-			this->sessions().dispatch(
+			this->sessions().dispatch(this->derived().hash_key(),
 			[this, ec, this_ptr = std::move(this_ptr), condition = std::move(condition)]() mutable
 			{
-				ASIO2_ASSERT(this->derived().sessions().io().strand().running_in_this_thread());
+				ASIO2_ASSERT(this->derived().sessions().io(this->derived().hash_key()).strand().running_in_this_thread());
 
 				try
 				{
@@ -194,7 +194,7 @@ namespace asio2::detail
 		inline void _fire_upgrade(std::shared_ptr<derived_t>& this_ptr, error_code ec)
 		{
 			// the _fire_upgrade must be executed in the thread 0.
-			ASIO2_ASSERT(this->sessions().io().strand().running_in_this_thread());
+			ASIO2_ASSERT(this->sessions().io(this->derived().hash_key()).strand().running_in_this_thread());
 
 			this->listener_.notify(event_type::upgrade, this_ptr, ec);
 		}
@@ -533,21 +533,30 @@ namespace asio2::detail
 		}
 
 		template<class Message>
-		inline void _multicast_publish(std::shared_ptr<caller_t>& caller_ptr, caller_t* caller, Message&& msg, std::string topic_name)
+		inline void _multicast_publish(std::shared_ptr<caller_t>& caller_ptr, caller_t* caller, Message&& message, std::string topic_name)
 		{
-			detail::ignore_unused(caller_ptr, caller, msg);
+			detail::ignore_unused(caller_ptr, caller, message);
 
 			using message_type  = typename detail::remove_cvref_t<Message>;
 
+			// the message is shared by all the subscribers, only the header is made for each subscriber,
+			// and the payload is sent from the shared message directly, so the payload is never copied.
+			std::shared_ptr<message_type> shared_msg = std::make_shared<message_type>(std::forward<Message>(message));
+
+			message_type& msg = *shared_msg;
+
 			//                  share_name   topic_filter
 			std::set<std::tuple<std::string_view, std::string_view>> sent;
 
+			// the count of the subscribers which the message is sent to
+			std::size_t fanout = 0;
+
 			if (topic_name.empty())
 				topic_name = msg.topic_name();
 
 			ASIO2_ASSERT(!topic_name.empty());
 
-			caller->subs_map_.modify(topic_name, [this, caller, &msg, &sent]
+			caller->subs_map_.modify(topic_name, [this, caller, &shared_msg, &sent, &fanout]
 			(std::string_view key, mqtt::subscription_entry<caller_t>& entry) mutable
 			{
 				detail::ignore_unused(key);
@@ -567,7 +576,9 @@ namespace asio2::detail
 						return;
 
 					// send message
-					_send_publish_to_subscriber(entry.session, entry.sub, entry.props, msg);
+					_send_publish_to_subscriber(entry.session, entry.sub, entry.props, shared_msg);
+
+					++fanout;
 				}
 				else
 				{
@@ -578,12 +589,16 @@ namespace asio2::detail
 					{
 						if (auto session = caller->shared_targets_.get_target(share_name, topic_filter))
 						{
-							_send_publish_to_subscriber(session, entry.sub, entry.props, msg);
+							_send_publish_to_subscriber(session, entry.sub, entry.props, shared_msg);
+
+							++fanout;
 						}
 					}
 				}
 			});
 
+			caller->io().metrics().mqtt_fanout.record(fanout);
+
 			/*
 			 * If the message is marked as being retained, then we
 			 * keep it in case a new subscription is added that matches
@@ -649,7 +664,7 @@ namespace asio2::detail
 		}
 
 		template<class session_t, class Message>
-		inline void _send_publish_to_subscriber(session_t* session, mqtt::subscription& sub, mqtt::v5::properties_set& props, Message& msg)
+		inline void _send_publish_to_subscriber(session_t* session, mqtt::subscription& sub, mqtt::v5::properties_set& props, std::shared_ptr<Message>& msg)
 		{
 			mqtt::version ver = session->version();
 
@@ -668,8 +683,10 @@ namespace asio2::detail
 		}
 
 		template<class session_t, class Message, class Response>
-		inline void _prepare_send_publish(session_t* session, mqtt::subscription& sub, mqtt::v5::properties_set& props, Message& msg, Response&& response)
+		inline void _prepare_send_publish(session_t* session, mqtt::subscription& sub, mqtt::v5::properties_set& props, std::shared_ptr<Message>& shared_msg, Response&& response)
 		{
+			Message& msg = *shared_msg;
+
 			using message_type  = typename detail::remove_cvref_t<Message>;
 			using response_type = typename detail::remove_cvref_t<Response>;
 
@@ -697,9 +714,9 @@ namespace asio2::detail
 				response.retain(false);
 			}
 
-			// topic, payload
+			// topic, the payload is sent from the shared message, it is only copied into the response
+			// when the response is saved as a offline message.
 			response.topic_name(msg.topic_name());
-			response.payload(msg.payload());
 
 			// properties
 			if constexpr (std::is_same_v<response_type, mqtt::v5::publish>)
@@ -741,13 +758,15 @@ namespace asio2::detail
 							//       used with some hypothetical "async_server" in the future.
 							response.packet_id(pid);
 
-							_do_send_publish(session, std::forward<Response>(response));
+							_do_send_publish(session, std::forward<Response>(response), shared_msg);
 						}
 						else
 						{
 							// no packet id available
 							ASIO2_ASSERT(false);
 
+							response.payload(msg.payload());
+
 							// offline_messages_ is not empty or packet_id_exhausted
 							session->offline_messages_.push_back(session->io().context(),
 								std::forward<Response>(response));
@@ -758,7 +777,7 @@ namespace asio2::detail
 						// A PUBLISH Packet MUST NOT contain a Packet Identifier if its QoS value is set to 0
 						ASIO2_ASSERT(response.has_packet_id() == false);
 
-						_do_send_publish(session, std::forward<Response>(response));
+						_do_send_publish(session, std::forward<Response>(response), shared_msg);
 					}
 				}
 				else
@@ -766,11 +785,13 @@ namespace asio2::detail
 					// send all offline messages first
 					_send_all_offline_message(session);
 
-					_do_send_publish(session, std::forward<Response>(response));
+					_do_send_publish(session, std::forward<Response>(response), shared_msg);
 				}
 			}
 			else
 			{
+				response.payload(msg.payload());
+
 				session->offline_messages_.push_back(session->io().context(), std::forward<Response>(response));
 			}
 		}
@@ -785,8 +806,11 @@ namespace asio2::detail
 				detail::ignore_unused(sptr);
 
 				session->_do_send(rep, [session, &rep, g = std::move(g)]
-				(const error_code& ec, std::size_t) mutable
+				(const error_code& ec, std::size_t bytes_sent) mutable
 				{
+					if (!ec)
+						session->io().metrics().sent(bytes_sent);
+
 					// send failed, add it to offline messages
 					if (ec)
 					{
@@ -796,6 +820,33 @@ namespace asio2::detail
 			});
 		}
 
+		template<class session_t, class Response, class Message>
+		inline void _do_send_publish(session_t* session, Response&& response, std::shared_ptr<Message> msg)
+		{
+			session->push_event(
+			[session, sptr = session->selfptr(), rep = std::forward<Response>(response), msg = std::move(msg)]
+			(event_queue_guard<caller_t>&& g) mutable
+			{
+				detail::ignore_unused(sptr);
+
+				// the msg is captured by this event, so the payload is valid until the guard is destroyed.
+				session->_mqtt_send_publish(rep, msg->payload(), [session, &rep, &msg, g = std::move(g)]
+				(const error_code& ec, std::size_t bytes_sent) mutable
+				{
+					if (!ec)
+						session->io().metrics().sent(bytes_sent);
+
+					// send failed, add it to offline messages
+					if (ec)
+					{
+						rep.payload(msg->payload());
+
+						session->offline_messages_.push_back(session->io().context(), std::move(rep));
+					}
+				});
+			});
+		}
+
 		template<class session_t>
 		inline void _send_all_offline_message(session_t* session)
 		{
@@ -1098,7 +1149,10 @@ namespace asio2::detail
 				{
 					std::visit([this, caller, &sub, &props](auto& pub) mutable
 					{
-						this->_send_publish_to_subscriber(caller, sub, props, pub);
+						// the retained message may be replaced before it is sent, so send a copy of it.
+						auto msg = std::make_shared<detail::remove_cvref_t<decltype(pub)>>(pub);
+
+						this->_send_publish_to_subscriber(caller, sub, props, msg);
 					}, entry.message);
 				});
 			});
@@ -304,6 +304,27 @@ namespace asio2::detail
 			return (*this);
 		}
 
+		/**
+		 * @function : set whether the strings and the payload of the recved message borrow the
+		 * bytes of the recv buffer instead of copying them, default is false. when it is true, the
+		 * message passed to the callback is only valid in the callback, and it must be copied or
+		 * moved if it is used after the callback. it must be called before start.
+		 */
+		inline self& borrow_recv_data(bool enable) noexcept
+		{
+			this->borrow_recv_data_ = enable;
+			return (*this);
+		}
+
+		/**
+		 * @function : get whether the strings and the payload of the recved message borrow the
+		 * bytes of the recv buffer.
+		 */
+		inline bool borrow_recv_data() const noexcept
+		{
+			return this->borrow_recv_data_;
+		}
+
 	protected:
 		template<class F>
 		inline void _bind(mqtt::control_packet_type type, F f)
@@ -435,10 +456,12 @@ namespace asio2::detail
 
 			try
 			{
+				mqtt::borrow_scope borrow(this->borrow_recv_data_);
+
 				mqtt::data_to_message<V>(data, [this, &f, &c, &ec, &caller_ptr, caller]
-				(auto message) mutable
+				(auto& message) mutable
 				{
-					if constexpr (std::is_same_v<message_type, decltype(message)>)
+					if constexpr (std::is_same_v<message_type, std::remove_reference_t<decltype(message)>>)
 					{
 						ec.clear();
 
@@ -492,10 +515,12 @@ namespace asio2::detail
 
 				try
 				{
+					mqtt::borrow_scope borrow(this->borrow_recv_data_);
+
 					mqtt::data_to_message<V>(data, [this, &f, &c, &ec, &caller_ptr, caller]
-					(auto message) mutable
+					(auto& message) mutable
 					{
-						if constexpr (std::is_same_v<message_type, decltype(message)>)
+						if constexpr (std::is_same_v<message_type, std::remove_reference_t<decltype(message)>>)
 						{
 							ec.clear();
 
@@ -537,10 +562,12 @@ namespace asio2::detail
 
 				try
 				{
+					mqtt::borrow_scope borrow(this->borrow_recv_data_);
+
 					mqtt::data_to_message<V>(data, [this, &f, &c, &ec, &caller_ptr, caller]
-					(auto message) mutable
+					(auto& message) mutable
 					{
-						if constexpr (std::is_same_v<message_type, decltype(message)>)
+						if constexpr (std::is_same_v<message_type, std::remove_reference_t<decltype(message)>>)
 						{
 							ec.clear();
 
@@ -633,10 +660,12 @@ namespace asio2::detail
 
 			try
 			{
+				mqtt::borrow_scope borrow(this->borrow_recv_data_);
+
 				mqtt::data_to_message<V>(data, [this, &f, &c, &ec, &caller_ptr, caller]
-				(auto message) mutable
+				(auto& message) mutable
 				{
-					if constexpr (std::is_same_v<message_type, decltype(message)>)
+					if constexpr (std::is_same_v<message_type, std::remove_reference_t<decltype(message)>>)
 					{
 						ec.clear();
 
@@ -802,7 +831,12 @@ namespace asio2::detail
 
 					std::visit([caller, g = std::move(g)](auto& rep) mutable
 					{
-						caller->_do_send(rep, [g = std::move(g)](const error_code&, std::size_t) mutable {});
+						caller->_do_send(rep, [caller, g = std::move(g)]
+						(const error_code& ec, std::size_t bytes_sent) mutable
+						{
+							if (!ec)
+								caller->io().metrics().sent(bytes_sent);
+						});
 					}, response);
 				});
 			}
@@ -818,7 +852,12 @@ namespace asio2::detail
 				{
 					detail::ignore_unused(caller_ptr);
 
-					caller->_do_send(response, [g = std::move(g)](const error_code&, std::size_t) mutable {});
+					caller->_do_send(response, [caller, g = std::move(g)]
+					(const error_code& ec, std::size_t bytes_sent) mutable
+					{
+						if (!ec)
+							caller->io().metrics().sent(bytes_sent);
+					});
 				});
 			}
 		}
@@ -910,6 +949,9 @@ namespace asio2::detail
 		std::array<handler_type, magic_enum::enum_count<mqtt::qos_type>()> v3_publish_handlers_;
 		std::array<handler_type, magic_enum::enum_count<mqtt::qos_type>()> v4_publish_handlers_;
 		std::array<handler_type, magic_enum::enum_count<mqtt::qos_type>()> v5_publish_handlers_;
+
+		/// the recved message borrows the bytes of the recv buffer or not
+		bool borrow_recv_data_ = false;
 	};
 }
 
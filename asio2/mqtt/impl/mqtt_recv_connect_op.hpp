@@ -37,7 +37,7 @@ namespace asio2::detail
 
 	public:
 		asio::io_context        & context_;
-		asio::io_context::strand& strand_;
+		io_strand_t& strand_;
 
 		SocketT&       socket_;
 		HandlerT       handler_;
@@ -46,7 +46,7 @@ namespace asio2::detail
 
 		template<class SKT, class H>
 		mqtt_recv_connect_op(
-			asio::io_context& context, asio::io_context::strand& strand,
+			asio::io_context& context, io_strand_t& strand,
 			SKT& skt, H&& h
 		)
 			: context_(context)
@@ -85,7 +85,7 @@ namespace asio2::detail
 
 	// C++17 class template argument deduction guides
 	template<class SKT, class H>
-	mqtt_recv_connect_op(asio::io_context&, asio::io_context::strand&,
+	mqtt_recv_connect_op(asio::io_context&, io_strand_t&,
 		SKT&, H)->mqtt_recv_connect_op<SKT, H>;
 }
 
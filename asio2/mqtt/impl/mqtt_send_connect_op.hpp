@@ -37,7 +37,7 @@ namespace asio2::detail
 
 	public:
 		asio::io_context        & context_;
-		asio::io_context::strand& strand_;
+		io_strand_t& strand_;
 
 		SocketT&       socket_;
 		HandlerT       handler_;
@@ -48,7 +48,7 @@ namespace asio2::detail
 
 		template<class SKT, class H>
 		mqtt_send_connect_op(
-			asio::io_context& context, asio::io_context::strand& strand,
+			asio::io_context& context, io_strand_t& strand,
 			std::variant<mqtt::v3::connect, mqtt::v4::connect, mqtt::v5::connect>& connect_msg,
 			SKT& skt, H&& h
 		)
@@ -104,7 +104,7 @@ namespace asio2::detail
 
 	// C++17 class template argument deduction guides
 	template<class SKT, class H>
-	mqtt_send_connect_op(asio::io_context&, asio::io_context::strand&,
+	mqtt_send_connect_op(asio::io_context&, io_strand_t&,
 		std::variant<mqtt::v3::connect, mqtt::v4::connect, mqtt::v5::connect>&,
 		SKT&, H)->mqtt_send_connect_op<SKT, H>;
 }
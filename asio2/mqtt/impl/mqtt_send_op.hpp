@@ -15,6 +15,7 @@
 #pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include <array>
 #include <memory>
 #include <future>
 #include <utility>
@@ -115,6 +116,47 @@ namespace asio2::detail
 
 			return true;
 		}
+
+		/**
+		 * @function : send the publish message and the payload which is not in the message, only the
+		 * header of the message is serialized, and then it is sent with the payload by one gathered
+		 * write, so the payload of a publish can be shared by all the subscribers without copy.
+		 * the payload must be valid until the callback is called.
+		 */
+		template<class Message, class Callback>
+		inline bool _mqtt_send_publish(Message& msg, std::string_view payload, Callback&& callback)
+		{
+			derived_t& derive = static_cast<derived_t&>(*this);
+
+			std::vector<char> header;
+
+			header.reserve(msg.required_size());
+			msg.serialize_header(header, payload.size());
+
+			std::array<asio::const_buffer, 2> buffers
+			{
+				asio::buffer(header),
+				asio::buffer(payload)
+			};
+
+			asio::async_write(derive.stream(), buffers, asio::bind_executor(derive.io().strand(),
+				make_allocator(derive.wallocator(), [&derive, p = derive.selfptr(),
+					header = std::move(header), callback = std::forward<Callback>(callback)]
+			(const error_code& ec, std::size_t bytes_sent) mutable
+			{
+				set_last_error(ec);
+
+				callback(ec, bytes_sent);
+
+				if (ec)
+				{
+					// must stop, otherwise re-sending will cause body confusion
+					derive._do_disconnect(ec);
+				}
+			})));
+
+			return true;
+		}
 	};
 }
 
@@ -589,6 +589,8 @@ namespace asio2::detail
 		inline void _fire_recv(std::shared_ptr<derived_t>& this_ptr, std::string_view data,
 			condition_wrap<MatchCondition>& condition)
 		{
+			detail::metrics_recv_scope ms(this->derived().io().metrics(), data.size());
+
 			this->listener_.notify(event_type::recv, data);
 
 			this->derived()._rdc_handle_recv(this_ptr, data, condition);
@@ -658,6 +658,38 @@ namespace asio2::mqtt
 		std::array<std::uint8_t, 4> value_{};
 	};
 
+	/**
+	 * Opt in to the borrowed decoding in the current thread. While a borrow_scope object is alive,
+	 * the utf8_string, binary_data and application_message which are deserialized in this thread
+	 * borrow the bytes of the data instead of copying them, so the decoded message is only valid
+	 * while the data is valid. Copying or moving the object, or calling own(), takes the ownership.
+	 * Without a borrow_scope, the deserialized object always owns its bytes.
+	 */
+	class borrow_scope
+	{
+	public:
+		explicit borrow_scope(bool enable = true) noexcept : prev_(borrowing())
+		{
+			borrowing() = (prev_ || enable);
+		}
+		~borrow_scope() noexcept
+		{
+			borrowing() = prev_;
+		}
+
+		borrow_scope(borrow_scope const&) = delete;
+		borrow_scope& operator=(borrow_scope const&) = delete;
+
+		static inline bool& borrowing() noexcept
+		{
+			thread_local bool enabled = false;
+			return enabled;
+		}
+
+	protected:
+		bool prev_;
+	};
+
 	/**
 	 * UTF-8 Encoded String
 	 * https://docs.oasis-open.org/mqtt/mqtt/v5.0/os/mqtt-v5.0-os.html#_Toc3901010
@@ -670,20 +702,42 @@ namespace asio2::mqtt
 
 		utf8_string() = default;
 
-		utf8_string(utf8_string const& o) : length_(o.length_), data_(o.data_)
+		utf8_string(utf8_string const& o) : length_(o.length_), data_(o.data_view())
 		{
 			//asio2::detail::disable_sso(data_);
 		}
 		utf8_string& operator=(utf8_string const& o)
 		{
-			length_ = o.length_;
-			data_   = o.data_;
+			if (this != std::addressof(o))
+			{
+				length_ = o.length_;
+				data_   = o.data_view();
+				view_   = {};
+			}
 
 			//asio2::detail::disable_sso(data_);
 
 			return (*this);
 		}
 
+		/*
+		 * the moved to object may outlive the recv buffer, so the borrowed bytes are copied.
+		 */
+		utf8_string(utf8_string&& o) : length_(o.length_), data_(o.view_.data() ? std::string(o.view_) : std::move(o.data_))
+		{
+		}
+		utf8_string& operator=(utf8_string&& o)
+		{
+			if (this != std::addressof(o))
+			{
+				length_ = o.length_;
+				data_   = o.view_.data() ? std::string(o.view_) : std::move(o.data_);
+				view_   = {};
+			}
+
+			return (*this);
+		}
+
 		explicit utf8_string(const char* const s)
 		{
 			*this = std::string{ s };
@@ -705,6 +759,7 @@ namespace asio2::mqtt
 			check_utf8(s);
 
 			data_   = std::move(s);
+			view_   = {};
 			length_ = static_cast<std::uint16_t>(data_.size());
 
 			//asio2::detail::disable_sso(data_);
@@ -726,16 +781,18 @@ namespace asio2::mqtt
 			return (*this);
 		}
 
-		inline bool         operator==(const std::string      & s) noexcept { return (data_ == s); }
-		inline bool         operator==(const std::string_view & s) noexcept { return (data_ == s); }
-		inline bool         operator!=(const std::string      & s) noexcept { return (data_ != s); }
-		inline bool         operator!=(const std::string_view & s) noexcept { return (data_ != s); }
+		inline bool         operator==(const std::string      & s) noexcept { return (this->data_view() == s); }
+		inline bool         operator==(const std::string_view & s) noexcept { return (this->data_view() == s); }
+		inline bool         operator!=(const std::string      & s) noexcept { return (this->data_view() != s); }
+		inline bool         operator!=(const std::string_view & s) noexcept { return (this->data_view() != s); }
 
 		inline utf8_string& operator+=(const std::string      & s)
 		{
-			check_size(data_.size() + s.size());
+			check_size(this->size() + s.size());
 			check_utf8(s);
 
+			this->own();
+
 			data_  += s;
 			length_ = static_cast<std::uint16_t>(data_.size());
 
@@ -745,9 +802,11 @@ namespace asio2::mqtt
 		}
 		inline utf8_string& operator+=(const std::string_view & s)
 		{
-			check_size(data_.size() + s.size());
+			check_size(this->size() + s.size());
 			check_utf8(s);
 
+			this->own();
+
 			data_  += s;
 			length_ = static_cast<std::uint16_t>(data_.size());
 
@@ -800,10 +859,10 @@ namespace asio2::mqtt
 			return (*this);
 		}
 
-		inline bool         operator==(const std::u8string      & s) noexcept { return (data_ == std::string{s.begin(), s.end()}); }
-		inline bool         operator==(const std::u8string_view & s) noexcept { return (data_ == std::string{s.begin(), s.end()}); }
-		inline bool         operator!=(const std::u8string      & s) noexcept { return (data_ != std::string{s.begin(), s.end()}); }
-		inline bool         operator!=(const std::u8string_view & s) noexcept { return (data_ != std::string{s.begin(), s.end()}); }
+		inline bool         operator==(const std::u8string      & s) noexcept { return (this->data_view() == std::string{s.begin(), s.end()}); }
+		inline bool         operator==(const std::u8string_view & s) noexcept { return (this->data_view() == std::string{s.begin(), s.end()}); }
+		inline bool         operator!=(const std::u8string      & s) noexcept { return (this->data_view() != std::string{s.begin(), s.end()}); }
+		inline bool         operator!=(const std::u8string_view & s) noexcept { return (this->data_view() != std::string{s.begin(), s.end()}); }
 
 		inline utf8_string& operator+=(const std::u8string      & s)
 		{
@@ -827,27 +886,46 @@ namespace asio2::mqtt
 
 		inline std::size_t  required_size() const noexcept
 		{
-			return (length_.required_size() + data_.size());
+			return (length_.required_size() + this->data_view().size());
 		}
 
 		inline std::size_t  size() const noexcept
 		{
-			return (data_.size());
+			return (this->data_view().size());
 		}
 
-		inline bool empty() const noexcept  { return data_.empty(); }
+		inline bool empty() const noexcept  { return this->data_view().empty(); }
 
-		inline std::string      data     () { return data_; }
-		inline std::string_view data_view() { return data_; }
+		inline std::string      data     () { return std::string(this->data_view()); }
+		inline std::string_view data_view() const noexcept { return (view_.data() ? view_ : std::string_view(data_)); }
 
-		inline operator std::string      () { return data_; }
-		inline operator std::string_view () { return data_; }
+		/*
+		 * whether the data is borrowed from the recv buffer, see mqtt::borrow_scope.
+		 */
+		inline bool is_view() const noexcept { return (view_.data() != nullptr); }
+
+		/*
+		 * copy the borrowed data into the owned storage, so the object can outlive the recv buffer.
+		 */
+		inline utf8_string& own()
+		{
+			if (view_.data())
+			{
+				data_ = view_;
+				view_ = {};
+			}
+
+			return (*this);
+		}
+
+		inline operator std::string      () { return std::string(this->data_view()); }
+		inline operator std::string_view () { return this->data_view(); }
 
 		inline utf8_string& serialize(std::vector<asio::const_buffer>& buffers)
 		{
 			length_.serialize(buffers);
 
-			buffers.emplace_back(asio::buffer(data_));
+			buffers.emplace_back(asio::buffer(this->data_view()));
 
 			return (*this);
 		}
@@ -860,7 +938,9 @@ namespace asio2::mqtt
 		{
 			length_.serialize(buffer);
 
-			buffer.insert(buffer.end(), data_.begin(), data_.end());
+			std::string_view v = this->data_view();
+
+			buffer.insert(buffer.end(), v.begin(), v.end());
 
 			return (*this);
 		}
@@ -872,11 +952,20 @@ namespace asio2::mqtt
 			if (data.size() < length_.value())
 				asio::detail::throw_error(mqtt::make_error_code(mqtt::error::malformed_packet));
 
-			data_ = data.substr(0, length_.value());
-
-			data.remove_prefix(data_.size());
+			// borrow the bytes of the recv buffer only when it is opted in by the borrow_scope,
+			// the borrowed bytes are copied when the object is copied or moved.
+			if (borrow_scope::borrowing())
+			{
+				view_ = data.substr(0, length_.value());
+				data_.clear();
+			}
+			else
+			{
+				data_ = data.substr(0, length_.value());
+				view_ = {};
+			}
 
-			//asio2::detail::disable_sso(data_);
+			data.remove_prefix(length_.value());
 
 			return (*this);
 		}
@@ -889,6 +978,9 @@ namespace asio2::mqtt
 
 		// UTF-8 encoded character data, if length > 0.
 		std::string      data_  {};
+
+		// the bytes in the recv buffer, if it is deserialized from the recv buffer.
+		std::string_view view_  {};
 	};
 
 	/**
@@ -903,20 +995,42 @@ namespace asio2::mqtt
 
 		binary_data() = default;
 
-		binary_data(binary_data const& o) : length_(o.length_), data_(o.data_)
+		binary_data(binary_data const& o) : length_(o.length_), data_(o.data_view())
 		{
 			//asio2::detail::disable_sso(data_);
 		}
 		binary_data& operator=(binary_data const& o)
 		{
-			length_ = o.length_;
-			data_   = o.data_;
+			if (this != std::addressof(o))
+			{
+				length_ = o.length_;
+				data_   = o.data_view();
+				view_   = {};
+			}
 
 			//asio2::detail::disable_sso(data_);
 
 			return (*this);
 		}
 
+		/*
+		 * the moved to object may outlive the recv buffer, so the borrowed bytes are copied.
+		 */
+		binary_data(binary_data&& o) : length_(o.length_), data_(o.view_.data() ? std::string(o.view_) : std::move(o.data_))
+		{
+		}
+		binary_data& operator=(binary_data&& o)
+		{
+			if (this != std::addressof(o))
+			{
+				length_ = o.length_;
+				data_   = o.view_.data() ? std::string(o.view_) : std::move(o.data_);
+				view_   = {};
+			}
+
+			return (*this);
+		}
+
 		explicit binary_data(const char* const s)
 		{
 			*this = std::string{ s };
@@ -937,6 +1051,7 @@ namespace asio2::mqtt
 			check_size(s.size());
 
 			data_   = std::move(s);
+			view_   = {};
 			length_ = static_cast<std::uint16_t>(data_.size());
 
 			//asio2::detail::disable_sso(data_);
@@ -958,14 +1073,16 @@ namespace asio2::mqtt
 			return (*this);
 		}
 
-		inline bool         operator==(const std::string      & s) noexcept { return (data_ == s); }
-		inline bool         operator==(const std::string_view & s) noexcept { return (data_ == s); }
-		inline bool         operator!=(const std::string      & s) noexcept { return (data_ != s); }
-		inline bool         operator!=(const std::string_view & s) noexcept { return (data_ != s); }
+		inline bool         operator==(const std::string      & s) noexcept { return (this->data_view() == s); }
+		inline bool         operator==(const std::string_view & s) noexcept { return (this->data_view() == s); }
+		inline bool         operator!=(const std::string      & s) noexcept { return (this->data_view() != s); }
+		inline bool         operator!=(const std::string_view & s) noexcept { return (this->data_view() != s); }
 
 		inline binary_data& operator+=(const std::string      & s)
 		{
-			check_size(data_.size() + s.size());
+			check_size(this->size() + s.size());
+
+			this->own();
 
 			data_  += s;
 			length_ = static_cast<std::uint16_t>(data_.size());
@@ -976,7 +1093,9 @@ namespace asio2::mqtt
 		}
 		inline binary_data& operator+=(const std::string_view & s)
 		{
-			check_size(data_.size() + s.size());
+			check_size(this->size() + s.size());
+
+			this->own();
 
 			data_  += s;
 			length_ = static_cast<std::uint16_t>(data_.size());
@@ -1029,10 +1148,10 @@ namespace asio2::mqtt
 			return (*this);
 		}
 
-		inline bool         operator==(const std::u8string      & s) noexcept { return (data_ == std::string(s.begin(), s.end())); }
-		inline bool         operator==(const std::u8string_view & s) noexcept { return (data_ == std::string(s.begin(), s.end())); }
-		inline bool         operator!=(const std::u8string      & s) noexcept { return (data_ != std::string(s.begin(), s.end())); }
-		inline bool         operator!=(const std::u8string_view & s) noexcept { return (data_ != std::string(s.begin(), s.end())); }
+		inline bool         operator==(const std::u8string      & s) noexcept { return (this->data_view() == std::string(s.begin(), s.end())); }
+		inline bool         operator==(const std::u8string_view & s) noexcept { return (this->data_view() == std::string(s.begin(), s.end())); }
+		inline bool         operator!=(const std::u8string      & s) noexcept { return (this->data_view() != std::string(s.begin(), s.end())); }
+		inline bool         operator!=(const std::u8string_view & s) noexcept { return (this->data_view() != std::string(s.begin(), s.end())); }
 
 		inline binary_data& operator+=(const std::u8string      & s)
 		{
@@ -1056,27 +1175,46 @@ namespace asio2::mqtt
 
 		inline std::size_t  required_size() const noexcept
 		{
-			return (length_.required_size() + data_.size());
+			return (length_.required_size() + this->data_view().size());
 		}
 
 		inline std::size_t  size() const noexcept
 		{
-			return (data_.size());
+			return (this->data_view().size());
 		}
 
-		inline bool empty() const noexcept  { return data_.empty(); }
+		inline bool empty() const noexcept  { return this->data_view().empty(); }
+
+		inline std::string      data     () { return std::string(this->data_view()); }
+		inline std::string_view data_view() const noexcept { return (view_.data() ? view_ : std::string_view(data_)); }
+
+		/*
+		 * whether the data is borrowed from the recv buffer, see mqtt::borrow_scope.
+		 */
+		inline bool is_view() const noexcept { return (view_.data() != nullptr); }
+
+		/*
+		 * copy the borrowed data into the owned storage, so the object can outlive the recv buffer.
+		 */
+		inline binary_data& own()
+		{
+			if (view_.data())
+			{
+				data_ = view_;
+				view_ = {};
+			}
 
-		inline std::string      data     () { return data_; }
-		inline std::string_view data_view() { return data_; }
+			return (*this);
+		}
 
-		inline operator std::string      () { return data_; }
-		inline operator std::string_view () { return data_; }
+		inline operator std::string      () { return std::string(this->data_view()); }
+		inline operator std::string_view () { return this->data_view(); }
 
 		inline binary_data& serialize(std::vector<asio::const_buffer>& buffers)
 		{
 			length_.serialize(buffers);
 
-			buffers.emplace_back(asio::buffer(data_));
+			buffers.emplace_back(asio::buffer(this->data_view()));
 
 			return (*this);
 		}
@@ -1089,7 +1227,9 @@ namespace asio2::mqtt
 		{
 			length_.serialize(buffer);
 
-			buffer.insert(buffer.end(), data_.begin(), data_.end());
+			std::string_view v = this->data_view();
+
+			buffer.insert(buffer.end(), v.begin(), v.end());
 
 			return (*this);
 		}
@@ -1101,11 +1241,20 @@ namespace asio2::mqtt
 			if (data.size() < length_.value())
 				asio::detail::throw_error(mqtt::make_error_code(mqtt::error::malformed_packet));
 
-			data_ = data.substr(0, length_.value());
+			// borrow the bytes of the recv buffer only when it is opted in by the borrow_scope,
+			// the borrowed bytes are copied when the object is copied or moved.
+			if (borrow_scope::borrowing())
+			{
+				view_ = data.substr(0, length_.value());
+				data_.clear();
+			}
+			else
+			{
+				data_ = data.substr(0, length_.value());
+				view_ = {};
+			}
 
-			data.remove_prefix(data_.size());
-
-			//asio2::detail::disable_sso(data_);
+			data.remove_prefix(length_.value());
 
 			return (*this);
 		}
@@ -1118,6 +1267,9 @@ namespace asio2::mqtt
 
 		// number of bytes
 		std::string      data_  {};
+
+		// the bytes in the recv buffer, if it is deserialized from the recv buffer.
+		std::string_view view_  {};
 	};
 
 	/**
@@ -1289,19 +1441,40 @@ namespace asio2::mqtt
 
 		application_message() = default;
 
-		application_message(application_message const& o) : data_(o.data_)
+		application_message(application_message const& o) : data_(o.data_view())
 		{
 			//asio2::detail::disable_sso(data_);
 		}
 		application_message& operator=(application_message const& o)
 		{
-			data_   = o.data_;
+			if (this != std::addressof(o))
+			{
+				data_   = o.data_view();
+				view_   = {};
+			}
 
 			//asio2::detail::disable_sso(data_);
 
 			return (*this);
 		}
 
+		/*
+		 * the moved to object may outlive the recv buffer, so the borrowed bytes are copied.
+		 */
+		application_message(application_message&& o) : data_(o.view_.data() ? std::string(o.view_) : std::move(o.data_))
+		{
+		}
+		application_message& operator=(application_message&& o)
+		{
+			if (this != std::addressof(o))
+			{
+				data_   = o.view_.data() ? std::string(o.view_) : std::move(o.data_);
+				view_   = {};
+			}
+
+			return (*this);
+		}
+
 		explicit application_message(const char* const s)
 		{
 			*this = std::string{ s };
@@ -1323,6 +1496,7 @@ namespace asio2::mqtt
 				asio::detail::throw_error(asio::error::invalid_argument);
 
 			data_   = std::move(s);
+			view_   = {};
 
 			//asio2::detail::disable_sso(data_);
 
@@ -1343,16 +1517,18 @@ namespace asio2::mqtt
 			return (*this);
 		}
 
-		inline bool         operator==(const std::string      & s) noexcept { return (data_ == s); }
-		inline bool         operator==(const std::string_view & s) noexcept { return (data_ == s); }
-		inline bool         operator!=(const std::string      & s) noexcept { return (data_ != s); }
-		inline bool         operator!=(const std::string_view & s) noexcept { return (data_ != s); }
+		inline bool         operator==(const std::string      & s) noexcept { return (this->data_view() == s); }
+		inline bool         operator==(const std::string_view & s) noexcept { return (this->data_view() == s); }
+		inline bool         operator!=(const std::string      & s) noexcept { return (this->data_view() != s); }
+		inline bool         operator!=(const std::string_view & s) noexcept { return (this->data_view() != s); }
 
 		inline application_message& operator+=(const std::string      & s)
 		{
-			if (data_.size() + s.size() > std::size_t(max_payload))
+			if (this->size() + s.size() > std::size_t(max_payload))
 				asio::detail::throw_error(asio::error::invalid_argument);
 
+			this->own();
+
 			data_  += s;
 
 			//asio2::detail::disable_sso(data_);
@@ -1361,9 +1537,11 @@ namespace asio2::mqtt
 		}
 		inline application_message& operator+=(const std::string_view & s)
 		{
-			if (data_.size() + s.size() > std::size_t(max_payload))
+			if (this->size() + s.size() > std::size_t(max_payload))
 				asio::detail::throw_error(asio::error::invalid_argument);
 
+			this->own();
+
 			data_  += s;
 
 			//asio2::detail::disable_sso(data_);
@@ -1414,10 +1592,10 @@ namespace asio2::mqtt
 			return (*this);
 		}
 
-		inline bool         operator==(const std::u8string      & s) noexcept { return (data_ == std::string(s.begin(), s.end())); }
-		inline bool         operator==(const std::u8string_view & s) noexcept { return (data_ == std::string(s.begin(), s.end())); }
-		inline bool         operator!=(const std::u8string      & s) noexcept { return (data_ != std::string(s.begin(), s.end())); }
-		inline bool         operator!=(const std::u8string_view & s) noexcept { return (data_ != std::string(s.begin(), s.end())); }
+		inline bool         operator==(const std::u8string      & s) noexcept { return (this->data_view() == std::string(s.begin(), s.end())); }
+		inline bool         operator==(const std::u8string_view & s) noexcept { return (this->data_view() == std::string(s.begin(), s.end())); }
+		inline bool         operator!=(const std::u8string      & s) noexcept { return (this->data_view() != std::string(s.begin(), s.end())); }
+		inline bool         operator!=(const std::u8string_view & s) noexcept { return (this->data_view() != std::string(s.begin(), s.end())); }
 
 		inline application_message& operator+=(const std::u8string      & s)
 		{
@@ -1441,25 +1619,44 @@ namespace asio2::mqtt
 
 		inline std::size_t  required_size() const noexcept
 		{
-			return (data_.size());
+			return (this->data_view().size());
 		}
 
 		inline std::size_t  size() const noexcept
 		{
-			return (data_.size());
+			return (this->data_view().size());
 		}
 
-		inline bool empty() const noexcept  { return data_.empty(); }
+		inline bool empty() const noexcept  { return this->data_view().empty(); }
+
+		inline std::string      data     () { return std::string(this->data_view()); }
+		inline std::string_view data_view() const noexcept { return (view_.data() ? view_ : std::string_view(data_)); }
+
+		/*
+		 * whether the data is borrowed from the recv buffer, see mqtt::borrow_scope.
+		 */
+		inline bool is_view() const noexcept { return (view_.data() != nullptr); }
+
+		/*
+		 * copy the borrowed data into the owned storage, so the object can outlive the recv buffer.
+		 */
+		inline application_message& own()
+		{
+			if (view_.data())
+			{
+				data_ = view_;
+				view_ = {};
+			}
 
-		inline std::string      data     () { return data_; }
-		inline std::string_view data_view() { return data_; }
+			return (*this);
+		}
 
-		inline operator std::string      () { return data_; }
-		inline operator std::string_view () { return data_; }
+		inline operator std::string      () { return std::string(this->data_view()); }
+		inline operator std::string_view () { return this->data_view(); }
 
 		inline application_message& serialize(std::vector<asio::const_buffer>& buffers)
 		{
-			buffers.emplace_back(asio::buffer(data_));
+			buffers.emplace_back(asio::buffer(this->data_view()));
 
 			return (*this);
 		}
@@ -1470,24 +1667,38 @@ namespace asio2::mqtt
 		template<class Container>
 		inline application_message& serialize(Container& buffer)
 		{
-			buffer.insert(buffer.end(), data_.begin(), data_.end());
+			std::string_view v = this->data_view();
+
+			buffer.insert(buffer.end(), v.begin(), v.end());
 
 			return (*this);
 		}
 
 		inline application_message& deserialize(std::string_view& data)
 		{
-			data_ = data;
-
-			data.remove_prefix(data_.size());
+			// borrow the bytes of the recv buffer only when it is opted in by the borrow_scope,
+			// the borrowed bytes are copied when the object is copied or moved.
+			if (borrow_scope::borrowing())
+			{
+				view_ = data;
+				data_.clear();
+			}
+			else
+			{
+				data_ = data;
+				view_ = {};
+			}
 
-			//asio2::detail::disable_sso(data_);
+			data.remove_prefix(data.size());
 
 			return (*this);
 		}
 
 	protected:
 		std::string      data_{};
+
+		// the bytes in the recv buffer, if it is deserialized from the recv buffer.
+		std::string_view view_{};
 	};
 
 	/**
@@ -38,6 +38,11 @@ namespace asio2::mqtt
 		return packet_type_from_byte(byte);
 	}
 
+	/**
+	 * the message which is passed to the callback owns its strings and payload, unless a
+	 * mqtt::borrow_scope is alive in this thread, then they are borrowed from the data, and the
+	 * message must be copied or moved if it is used after the callback.
+	 */
 	template<mqtt::version V, class Fun>
 	inline void data_to_packet(std::string_view& data, Fun&& f)
 	{
@@ -47,20 +52,20 @@ namespace asio2::mqtt
 		{
 			switch (type)
 			{
-			case mqtt::control_packet_type::connect     : { mqtt::v3::connect     v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::connack     : { mqtt::v3::connack     v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::publish     : { mqtt::v3::publish     v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::puback      : { mqtt::v3::puback      v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::pubrec      : { mqtt::v3::pubrec      v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::pubrel      : { mqtt::v3::pubrel      v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::pubcomp     : { mqtt::v3::pubcomp     v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::subscribe   : { mqtt::v3::subscribe   v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::suback      : { mqtt::v3::suback      v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::unsubscribe : { mqtt::v3::unsubscribe v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::unsuback    : { mqtt::v3::unsuback    v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::pingreq     : { mqtt::v3::pingreq     v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::pingresp    : { mqtt::v3::pingresp    v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::disconnect  : { mqtt::v3::disconnect  v{}; v.deserialize(data); f(std::move(v)); } break;
+			case mqtt::control_packet_type::connect     : { mqtt::v3::connect     v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::connack     : { mqtt::v3::connack     v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::publish     : { mqtt::v3::publish     v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::puback      : { mqtt::v3::puback      v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::pubrec      : { mqtt::v3::pubrec      v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::pubrel      : { mqtt::v3::pubrel      v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::pubcomp     : { mqtt::v3::pubcomp     v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::subscribe   : { mqtt::v3::subscribe   v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::suback      : { mqtt::v3::suback      v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::unsubscribe : { mqtt::v3::unsubscribe v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::unsuback    : { mqtt::v3::unsuback    v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::pingreq     : { mqtt::v3::pingreq     v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::pingresp    : { mqtt::v3::pingresp    v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::disconnect  : { mqtt::v3::disconnect  v{}; v.deserialize(data); f(v); } break;
 			default:
 				ASIO2_ASSERT(false);
 				asio::detail::throw_error(mqtt::make_error_code(mqtt::error::malformed_packet));
@@ -71,20 +76,20 @@ namespace asio2::mqtt
 		{
 			switch (type)
 			{
-			case mqtt::control_packet_type::connect     : { mqtt::v4::connect     v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::connack     : { mqtt::v4::connack     v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::publish     : { mqtt::v4::publish     v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::puback      : { mqtt::v4::puback      v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::pubrec      : { mqtt::v4::pubrec      v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::pubrel      : { mqtt::v4::pubrel      v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::pubcomp     : { mqtt::v4::pubcomp     v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::subscribe   : { mqtt::v4::subscribe   v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::suback      : { mqtt::v4::suback      v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::unsubscribe : { mqtt::v4::unsubscribe v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::unsuback    : { mqtt::v4::unsuback    v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::pingreq     : { mqtt::v4::pingreq     v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::pingresp    : { mqtt::v4::pingresp    v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::disconnect  : { mqtt::v4::disconnect  v{}; v.deserialize(data); f(std::move(v)); } break;
+			case mqtt::control_packet_type::connect     : { mqtt::v4::connect     v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::connack     : { mqtt::v4::connack     v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::publish     : { mqtt::v4::publish     v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::puback      : { mqtt::v4::puback      v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::pubrec      : { mqtt::v4::pubrec      v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::pubrel      : { mqtt::v4::pubrel      v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::pubcomp     : { mqtt::v4::pubcomp     v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::subscribe   : { mqtt::v4::subscribe   v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::suback      : { mqtt::v4::suback      v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::unsubscribe : { mqtt::v4::unsubscribe v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::unsuback    : { mqtt::v4::unsuback    v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::pingreq     : { mqtt::v4::pingreq     v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::pingresp    : { mqtt::v4::pingresp    v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::disconnect  : { mqtt::v4::disconnect  v{}; v.deserialize(data); f(v); } break;
 			default:
 				ASIO2_ASSERT(false);
 				asio::detail::throw_error(mqtt::make_error_code(mqtt::error::malformed_packet));
@@ -95,21 +100,21 @@ namespace asio2::mqtt
 		{
 			switch (type)
 			{
-			case mqtt::control_packet_type::connect     : { mqtt::v5::connect     v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::connack     : { mqtt::v5::connack     v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::publish     : { mqtt::v5::publish     v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::puback      : { mqtt::v5::puback      v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::pubrec      : { mqtt::v5::pubrec      v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::pubrel      : { mqtt::v5::pubrel      v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::pubcomp     : { mqtt::v5::pubcomp     v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::subscribe   : { mqtt::v5::subscribe   v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::suback      : { mqtt::v5::suback      v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::unsubscribe : { mqtt::v5::unsubscribe v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::unsuback    : { mqtt::v5::unsuback    v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::pingreq     : { mqtt::v5::pingreq     v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::pingresp    : { mqtt::v5::pingresp    v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::disconnect  : { mqtt::v5::disconnect  v{}; v.deserialize(data); f(std::move(v)); } break;
-			case mqtt::control_packet_type::auth        : { mqtt::v5::auth        v{}; v.deserialize(data); f(std::move(v)); } break;
+			case mqtt::control_packet_type::connect     : { mqtt::v5::connect     v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::connack     : { mqtt::v5::connack     v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::publish     : { mqtt::v5::publish     v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::puback      : { mqtt::v5::puback      v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::pubrec      : { mqtt::v5::pubrec      v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::pubrel      : { mqtt::v5::pubrel      v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::pubcomp     : { mqtt::v5::pubcomp     v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::subscribe   : { mqtt::v5::subscribe   v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::suback      : { mqtt::v5::suback      v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::unsubscribe : { mqtt::v5::unsubscribe v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::unsuback    : { mqtt::v5::unsuback    v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::pingreq     : { mqtt::v5::pingreq     v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::pingresp    : { mqtt::v5::pingresp    v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::disconnect  : { mqtt::v5::disconnect  v{}; v.deserialize(data); f(v); } break;
+			case mqtt::control_packet_type::auth        : { mqtt::v5::auth        v{}; v.deserialize(data); f(v); } break;
 			default:
 				ASIO2_ASSERT(false);
 				asio::detail::throw_error(mqtt::make_error_code(mqtt::error::malformed_packet));
@@ -1577,6 +1577,32 @@ namespace asio2::mqtt::v5
 			return (*this);
 		}
 
+		/*
+		 * Serialize the packet except the payload, but the remaining length includes the payload,
+		 * then the payload can be sent after the header by a gathered write, so one payload can be
+		 * shared by many packets without copy.
+		 */
+		template<class Container>
+		inline publish& serialize_header(Container& buffer, std::size_t payload_size)
+		{
+			update_remain_length();
+
+			remain_length_ = static_cast<std::int32_t>(
+				remain_length_.value() - payload_.required_size() + payload_size);
+
+			fixed_header::serialize(buffer);
+
+			ASIO2_ASSERT((type_and_flags_.bits.qos == std::uint8_t(0)) != packet_id_.has_value());
+
+			                  topic_name_.serialize(buffer);
+			if (packet_id_) { packet_id_->serialize(buffer); }
+			                  properties_.serialize(buffer);
+
+			update_remain_length();
+
+			return (*this);
+		}
+
 		inline publish& deserialize(std::string_view& data)
 		{
 			fixed_header::deserialize(data);
@@ -205,9 +205,9 @@ namespace asio2::detail
 		}
 
 		template<typename... Args>
-		inline std::shared_ptr<session_t> _make_session(Args&&... args)
+		inline std::shared_ptr<session_t> _make_session(io_t& io, Args&&... args)
 		{
-			std::shared_ptr<session_t> p = super::_make_session(std::forward<Args>(args)..., *this,
+			std::shared_ptr<session_t> p = super::_make_session(io, std::forward<Args>(args)..., *this,
 				this->mqttid_sessions_mtx_, this->mqttid_sessions_,
 				this->subs_map_, this->shared_targets_, this->retained_messages_);
 			// Copy the parameter configuration of user calls for the "server" to each "session"
@@ -181,7 +181,7 @@ namespace asio2::detail
 		inline void _handle_connect(const error_code& ec, std::shared_ptr<derived_t> this_ptr,
 			condition_wrap<MatchCondition> condition)
 		{
-			ASIO2_ASSERT(this->derived().sessions().io().strand().running_in_this_thread());
+			ASIO2_ASSERT(this->derived().sessions().io(this->derived().hash_key()).strand().running_in_this_thread());
 
 			asio::dispatch(this->derived().io().strand(), make_allocator(this->derived().wallocator(),
 			[this, ec, this_ptr = std::move(this_ptr), condition = std::move(condition)]
@@ -285,6 +285,8 @@ namespace asio2::detail
 		inline void _fire_recv(std::shared_ptr<derived_t>& this_ptr, std::string_view data,
 			condition_wrap<MatchCondition>& condition)
 		{
+			detail::metrics_recv_scope ms(this->derived().io().metrics(), data.size());
+
 			this->listener_.notify(event_type::recv, this_ptr, data);
 
 			this->derived()._rdc_handle_recv(this_ptr, data, condition);
@@ -52,15 +52,20 @@ auto f(Args&& ... args){
 #include <tuple>
 #include <unordered_map>
 #include <type_traits>
+#include <typeinfo>
+#include <vector>
 #include <map>
 
 #include <asio2/3rd/asio.hpp>
 #include <asio2/base/error.hpp>
 #include <asio2/base/detail/function_traits.hpp>
+#include <asio2/base/detail/coarse_timer.hpp>
 
 #include <asio2/rpc/detail/rpc_serialization.hpp>
 #include <asio2/rpc/detail/rpc_protocol.hpp>
 #include <asio2/rpc/detail/rpc_invoker.hpp>
+#include <asio2/rpc/detail/rpc_batch.hpp>
+#include <asio2/rpc/detail/rpc_pending_table.hpp>
 
 namespace asio2::detail
 {
@@ -71,9 +76,10 @@ namespace asio2::detail
 		/**
 		 * @constructor
 		 */
-		rpc_call_cp(io_t&, rpc_serializer& sr, rpc_deserializer& dr)
+		rpc_call_cp(io_t& io, rpc_serializer& sr, rpc_deserializer& dr)
 			: sr_(sr), dr_(dr)
 		{
+			this->reqs_.metrics(io.metrics_ptr());
 		}
 
 		/**
@@ -81,6 +87,32 @@ namespace asio2::detail
 		 */
 		~rpc_call_cp() = default;
 
+	public:
+		/**
+		 * @function : enable or disable the method id mode, default is disabled.
+		 * When enabled, the function name of the rpc request is replaced by the 32 bits method id
+		 * (the FNV-1a hash of the name, see asio2::rpc::method_id), the peer find the function by
+		 * the method id in a flat table, so the function name is not transferred and there is no
+		 * string allocation and hash when the peer dispatch the request. The peer always accepts
+		 * both the function name and the method id, but the old version of the peer doesn't know
+		 * the method id, so don't enable it when the peer is the old version. If the names of two
+		 * functions binded by the peer have the same method id, the peer replies not_found for the
+		 * method id, call these functions with the method id mode disabled.
+		 */
+		inline derived_t& method_id_mode(bool enable)
+		{
+			this->method_id_mode_ = enable;
+			return static_cast<derived_t&>(*this);
+		}
+
+		/**
+		 * @function : get whether the method id mode is enabled.
+		 */
+		inline bool method_id_mode() const
+		{
+			return this->method_id_mode_;
+		}
+
 	protected:
 		template<class derive_t>
 		struct sync_call_op
@@ -103,6 +135,9 @@ namespace asio2::detail
 					rpc_header::id_type id = derive.mkid();
 					rpc_request<Args...> req(id, std::move(name), std::forward<Args>(args)...);
 
+					if (derive.method_id_mode())
+						req.use_method_id();
+
 					std::shared_ptr<std::promise<error_code>> promise =
 						std::make_shared<std::promise<error_code>>();
 					std::future<error_code> future = promise->get_future();
@@ -143,17 +178,12 @@ namespace asio2::detail
 					{
 						derive.reqs_.emplace(req.id(), std::move(ex));
 
-						derive.async_send((derive.sr_.reset() << req).str(),
+						derive.async_send((derive.sr_.reset() << req).take(),
 						[&derive, id = req.id()]() mutable
 						{
 							if (get_last_error()) // send data failed with error
 							{
-								auto iter = derive.reqs_.find(id);
-								if (iter != derive.reqs_.end())
-								{
-									auto& ex = iter->second;
-									ex(get_last_error(), std::string_view{});
-								}
+								derive.reqs_.invoke(id, get_last_error(), std::string_view{});
 							}
 						});
 					});
@@ -320,6 +350,9 @@ namespace asio2::detail
 
 				error_code ec;
 
+				if (derive.method_id_mode())
+					req.use_method_id();
+
 				try
 				{
 					if (!derive.is_started())
@@ -327,7 +360,7 @@ namespace asio2::detail
 
 					derive.post([&derive, req = std::forward<Req>(req)]() mutable
 					{
-						derive.async_send((derive.sr_.reset() << req).str());
+						derive.async_send((derive.sr_.reset() << req).take());
 					});
 
 					return;
@@ -349,20 +382,20 @@ namespace asio2::detail
 
 				req.id(id);
 
+				if (derive.method_id_mode())
+					req.use_method_id();
+
 				// 2020-12-03 Fix possible bug: move the "timer->async_wait" into the io_context thread.
 				// otherwise the "derive.send" maybe has't called, the "timer->async_wait" has called
 				// already.
-				std::shared_ptr<asio::steady_timer> timer =
-					std::make_shared<asio::steady_timer>(derive.io().context());
+				std::shared_ptr<coarse_timer> timer = std::make_shared<coarse_timer>(derive.io());
 
 				auto ex = [&derive, id, timer, cb = std::forward<Callback>(cb)]
 				(error_code ec, std::string_view data) mutable
 				{
 					ASIO2_ASSERT(derive.io().strand().running_in_this_thread());
 
-					error_code ec_ignore{};
-
-					timer->cancel(ec_ignore);
+					timer->cancel();
 
 					if (cb) { cb(ec, data); }
 
@@ -404,34 +437,23 @@ namespace asio2::detail
 
 						auto this_ptr = derive.selfptr();
 
-						timer->expires_after(timeout);
-						timer->async_wait(asio::bind_executor(derive.io().strand(),
+						timer->async_wait(timeout,
 						[this_ptr = std::move(this_ptr), &derive, id = req.id()]
 						(const error_code& ec) mutable
 						{
 							if (ec == asio::error::operation_aborted)
 								return;
 
-							auto iter = derive.reqs_.find(id);
-							if (iter != derive.reqs_.end())
-							{
-								auto& ex = iter->second;
-								ex(asio::error::timed_out, std::string_view{});
-							}
-						}));
+							derive.reqs_.invoke(id, asio::error::timed_out, std::string_view{});
+						});
 
 						// 3. third, send request.
-						derive.async_send((derive.sr_.reset() << req).str(),
+						derive.async_send((derive.sr_.reset() << req).take(),
 						[&derive, id = req.id()]() mutable
 						{
 							if (get_last_error()) // send data failed with error
 							{
-								auto iter = derive.reqs_.find(id);
-								if (iter != derive.reqs_.end())
-								{
-									auto& ex = iter->second;
-									ex(get_last_error(), std::string_view{});
-								}
+								derive.reqs_.invoke(id, get_last_error(), std::string_view{});
 							}
 						});
 					});
@@ -632,6 +654,170 @@ namespace asio2::detail
 			error_code*                                         ec_       = nullptr;
 		};
 
+		template<class derive_t>
+		class batch_caller
+		{
+			template <class, class>                       friend class rpc_call_cp;
+		protected:
+			batch_caller(derive_t& d) : derive(d), id_(d.mkid()), tm_(d.default_timeout())
+				, sr_(std::make_unique<rpc_serializer>())
+			{
+				this->sr_->reset();
+				(*(this->sr_)) << rpc_header(rpc_type_req_batch, this->id_, std::string_view{});
+			}
+			batch_caller(batch_caller&& o) : derive(o.derive), id_(std::move(o.id_)), tm_(std::move(o.tm_))
+				, sr_(std::move(o.sr_)), types_(std::move(o.types_)), ec_(std::move(o.ec_)) {}
+			batch_caller(const batch_caller&) = delete;
+			batch_caller& operator=(batch_caller&&) = delete;
+			batch_caller& operator=(const batch_caller&) = delete;
+
+		public:
+			~batch_caller() = default;
+
+			template<class Rep, class Period>
+			inline batch_caller& timeout(std::chrono::duration<Rep, Period> timeout)
+			{
+				this->tm_ = timeout;
+				return (*this);
+			}
+
+			/**
+			 * @function : append a rpc call into the batch, the call is serialized immediately.
+			 * the return_t is the result type of the rpc function, it is used to check the type
+			 * of batch_result::get<return_t>(index), the index is the order of the call.
+			 */
+			template<class return_t, class ...Args>
+			inline batch_caller& call(std::string name, Args&&... args)
+			{
+				rpc_request<Args...> req(std::move(name), std::forward<Args>(args)...);
+
+				if (derive.method_id_mode())
+					req.use_method_id();
+
+				std::size_t pos = this->sr_->begin_block();
+
+				try
+				{
+					(*(this->sr_)) << req;
+				}
+				catch (cereal::exception&  ) { if (!ec_) ec_ = asio::error::no_data; }
+				catch (system_error     & e) { if (!ec_) ec_ = e.code();             }
+				catch (std::exception   &  ) { if (!ec_) ec_ = asio::error::eof;     }
+
+				this->sr_->end_block(pos);
+
+				this->types_.emplace_back(&typeid(return_t));
+
+				return (*this);
+			}
+
+			/**
+			 * @function : send all the calls of the batch in one frame, and wait the results
+			 * of all the calls in one frame with a single timeout.
+			 * Callback signature : void(asio::error_code ec, asio2::rpc::batch_result& results)
+			 * the ec is the error of the whole batch, eg : timed_out, and the error of each call
+			 * can be got by results.get<return_t>(index, ec).
+			 */
+			template<class Callback>
+			inline void async_exec(Callback&& cb)
+			{
+				error_code ec = this->ec_;
+
+				rpc_header::id_type id = this->id_;
+
+				std::shared_ptr<coarse_timer> timer = std::make_shared<coarse_timer>(derive.io());
+
+				auto ex = [&derive = this->derive, id, timer, types = std::move(this->types_),
+					cb = std::forward<Callback>(cb)](error_code ec, std::string_view data) mutable
+				{
+					detail::ignore_unused(data);
+
+					ASIO2_ASSERT(derive.io().strand().running_in_this_thread());
+
+					timer->cancel();
+
+					std::vector<std::string_view> blocks;
+
+					if (!ec)
+					{
+						std::string_view rest = derive.dr_.buffer().rest(), block;
+
+						blocks.reserve(types.size());
+
+						while (rpc_deserializer::next_block(rest, block))
+							blocks.emplace_back(block);
+
+						if (!rest.empty() || blocks.size() != types.size())
+							ec = asio::error::no_data;
+					}
+
+					set_last_error(ec);
+
+					rpc::batch_result results(derive.dr_, ec, std::move(blocks), types);
+
+					cb(ec, results);
+
+					derive.reqs_.erase(id);
+				};
+
+				try
+				{
+					if (ec)
+						asio::detail::throw_error(ec);
+
+					if (!derive.is_started())
+						asio::detail::throw_error(asio::error::not_connected);
+
+					derive.post([&derive = this->derive, timer = std::move(timer), timeout = this->tm_, id,
+						data = this->sr_->take(), ex = std::move(ex)]() mutable
+					{
+						derive.reqs_.emplace(id, std::move(ex));
+
+						auto this_ptr = derive.selfptr();
+
+						timer->async_wait(timeout,
+						[this_ptr = std::move(this_ptr), &derive, id](const error_code& ec) mutable
+						{
+							if (ec == asio::error::operation_aborted)
+								return;
+
+							derive.reqs_.invoke(id, asio::error::timed_out, std::string_view{});
+						});
+
+						derive.async_send(std::move(data), [&derive, id]() mutable
+						{
+							if (get_last_error()) // send data failed with error
+							{
+								derive.reqs_.invoke(id, get_last_error(), std::string_view{});
+							}
+						});
+					});
+
+					return;
+				}
+				catch (cereal::exception&  ) { ec = asio::error::no_data; }
+				catch (system_error     & e) { ec = e.code();             }
+				catch (std::exception   &  ) { ec = asio::error::eof;     }
+
+				set_last_error(ec);
+
+				derive.post([ec, ex = std::move(ex)]() mutable
+				{
+					set_last_error(ec);
+
+					ex(ec, std::string_view{});
+				});
+			}
+
+		protected:
+			derive_t&                                           derive;
+			rpc_header::id_type                                 id_;
+			asio::steady_timer::duration                        tm_;
+			std::unique_ptr<rpc_serializer>                     sr_;
+			std::vector<const std::type_info*>                  types_;
+			error_code                                          ec_;
+		};
+
 	public:
 		/**
 		 * @function : call a rpc function
@@ -797,11 +983,28 @@ namespace asio2::detail
 			return std::move(caller);
 		}
 
+		/**
+		 * @function : create a batch of rpc calls, all the calls are sent in one frame, and the
+		 * peer dispatch them in one pass and response all the results in one frame, there is
+		 * only one request id and one timeout timer for the whole batch. eg :
+		 * client.batch().call<int>("add", 1, 2).call<std::string>("echo", "x").async_exec(...);
+		 * note : the rpc function which returns rpc::future or is binded with rpc::offload is
+		 * called as a notification in the batch, and it's result is asio::error::operation_not_supported.
+		 */
+		inline batch_caller<derived_t> batch()
+		{
+			batch_caller<derived_t> caller{ static_cast<derived_t&>(*this) };
+			return std::move(caller);
+		}
+
 	protected:
 		rpc_serializer    & sr_;
 		rpc_deserializer  & dr_;
 
-		std::map<rpc_header::id_type, std::function<void(error_code, std::string_view)>> reqs_;
+		rpc_pending_table<rpc_header::id_type, rpc_pending_callback> reqs_;
+
+		/// whether the function name is replaced by the method id when calling
+		bool                                                 method_id_mode_ = false;
 	};
 }
 
@@ -0,0 +1,151 @@
+/*
+ * COPYRIGHT (C) 2017-2021, zhllxt
+ *
+ * author   : zhllxt
+ * email    : 37792738@qq.com
+ *
+ * Distributed under the GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+ * (See accompanying file LICENSE or see <http://www.gnu.org/licenses/>)
+ */
+
+#ifndef __ASIO2_RPC_BATCH_HPP__
+#define __ASIO2_RPC_BATCH_HPP__
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+#pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+#include <asio2/3rd/asio.hpp>
+#include <asio2/base/error.hpp>
+
+#include <asio2/rpc/detail/rpc_serialization.hpp>
+
+namespace asio2::rpc
+{
+	/**
+	 * The results of the batch calls, see rpc_call_cp::batch. The result of each call is
+	 * deserialized when it is got, and the result can only be got in the callback of the batch.
+	 * eg :
+	 * client.batch().call<int>("add", 1, 2).call<std::string>("echo", "x").async_exec(
+	 * [](asio::error_code ec, asio2::rpc::batch_result& results)
+	 * {
+	 *     int v = results.get<int>(0);
+	 *     std::string s = results.get<std::string>(1, ec);
+	 * });
+	 */
+	class batch_result
+	{
+	public:
+		/**
+		 * @constructor
+		 */
+		batch_result(detail::rpc_deserializer& dr, error_code ec, std::vector<std::string_view> blocks,
+			const std::vector<const std::type_info*>& types)
+			: dr_(dr), ec_(ec), blocks_(std::move(blocks)), types_(types)
+		{
+		}
+
+		/**
+		 * @destructor
+		 */
+		~batch_result() = default;
+
+		/**
+		 * @function : get the count of the calls of the batch.
+		 */
+		inline std::size_t size() const noexcept
+		{
+			return this->types_.size();
+		}
+
+		/**
+		 * @function : get the error of the whole batch, eg : timed_out
+		 */
+		inline error_code error() const noexcept
+		{
+			return this->ec_;
+		}
+
+		/**
+		 * @function : get the result of the call by index, the error is saved into the ec.
+		 */
+		template<class return_t>
+		inline return_t get(std::size_t index, error_code& ec)
+		{
+			ec = this->ec_;
+
+			if (!ec && !(index < this->blocks_.size()))
+				ec = asio::error::no_data;
+
+			// the return type must be same as the type of call<return_t>(...)
+			ASIO2_ASSERT(ec || *(this->types_[index]) == typeid(return_t));
+
+			if constexpr (!std::is_void_v<return_t>)
+			{
+				return_t result{};
+
+				if (!ec)
+				{
+					try
+					{
+						this->dr_.reset_block(this->blocks_[index]);
+						this->dr_ >> ec;
+						if (!ec)
+							this->dr_ >> result;
+					}
+					catch (cereal::exception&  ) { ec = asio::error::no_data; }
+					catch (system_error     & e) { ec = e.code();             }
+					catch (std::exception   &  ) { ec = asio::error::eof;     }
+				}
+
+				set_last_error(ec);
+
+				return result;
+			}
+			else
+			{
+				if (!ec)
+				{
+					try
+					{
+						this->dr_.reset_block(this->blocks_[index]);
+						this->dr_ >> ec;
+					}
+					catch (cereal::exception&  ) { ec = asio::error::no_data; }
+					catch (system_error     & e) { ec = e.code();             }
+					catch (std::exception   &  ) { ec = asio::error::eof;     }
+				}
+
+				set_last_error(ec);
+			}
+		}
+
+		/**
+		 * @function : get the result of the call by index, use get_last_error() to check
+		 * whether there is an error.
+		 */
+		template<class return_t>
+		inline return_t get(std::size_t index)
+		{
+			error_code ec;
+			return this->template get<return_t>(index, ec);
+		}
+
+	protected:
+		detail::rpc_deserializer               & dr_;
+
+		error_code                               ec_;
+
+		std::vector<std::string_view>            blocks_;
+
+		const std::vector<const std::type_info*>& types_;
+	};
+}
+
+#endif // !__ASIO2_RPC_BATCH_HPP__
@@ -27,6 +27,8 @@
 #include <future>
 #include <tuple>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include <type_traits>
 #include <optional>
 
@@ -40,6 +42,7 @@
 
 #include <asio2/rpc/detail/rpc_serialization.hpp>
 #include <asio2/rpc/detail/rpc_protocol.hpp>
+#include <asio2/rpc/detail/rpc_offload.hpp>
 
 #include <asio2/util/string.hpp>
 
@@ -248,16 +251,76 @@ namespace asio2::detail
 #endif
 			this->_bind(std::move(name), std::forward<F>(fun), std::forward<C>(obj)...);
 
+			this->_rebuild_method_ids();
+
+			return (*this);
+		}
+
+		/**
+		 * @function : bind a rpc function with the execution policy
+		 * @param    : Policy - asio2::rpc::offload : the function will be called in the offload
+		 * worker pool, and the response will be sent in the io thread of the session, so the
+		 * slow function (eg: database query) will not block other sessions in the same io thread.
+		 * the function can't return rpc::future, and the caller parameter is a copy of the session
+		 * shared_ptr, all other parameters are same as the bind without policy.
+		 */
+		template<class Policy, class F, class ...C>
+		inline typename std::enable_if_t<std::is_same_v<Policy, rpc::offload>, self&>
+		bind(std::string name, F&& fun, C&&... obj)
+		{
+			asio2::trim_both(name);
+
+			ASIO2_ASSERT(!name.empty());
+			if (name.empty())
+				return (*this);
+
+#if defined(_DEBUG) || defined(DEBUG)
+			{
+				ASIO2_ASSERT(this->invokers_.find(name) == this->invokers_.end());
+			}
+#endif
+			this->_bind_offload(std::move(name), std::forward<F>(fun), std::forward<C>(obj)...);
+
+			this->_rebuild_method_ids();
+
 			return (*this);
 		}
 
+		/**
+		 * @function : set the thread count and the max count of the waiting requests of the
+		 * offload worker pool, the request will be responsed with asio::error::try_again when
+		 * the waiting queue is full. it must be called before any offload function is called.
+		 * default thread count is std::thread::hardware_concurrency(), max pending is 1024.
+		 */
+		inline self& offload_pool(std::size_t thread_count, std::size_t max_pending)
+		{
+			this->offload_pool_.config(thread_count, max_pending);
+			return (*this);
+		}
+
+		/**
+		 * @function : get the counters of the offload worker pool, include the queue wait time
+		 * and the execution time of the offload functions.
+		 */
+		inline rpc_offload_stats offload_stats()
+		{
+			return this->offload_pool_.stats();
+		}
+
 		/**
 		 * @function : unbind a rpc function
 		 */
 		inline self& unbind(std::string const& name)
 		{
 			//asio2_unique_lock guard(this->mutex_);
-			this->invokers_.erase(name);
+			auto iter = this->invokers_.find(name);
+			if (iter == this->invokers_.end())
+				return (*this);
+
+			this->async_invokers_.erase(std::addressof(iter->second));
+			this->invokers_.erase(iter);
+
+			this->_rebuild_method_ids();
 
 			return (*this);
 		}
@@ -275,34 +338,296 @@ namespace asio2::detail
 			return (&(iter->second));
 		}
 
+		/**
+		 * @function : check whether the binded rpc function is called asynchronously, that is
+		 * the function returns rpc::future or it is binded with rpc::offload, the response of
+		 * these functions is not sent by the invoker directly.
+		 */
+		inline bool is_async(
+			const std::function<bool(std::shared_ptr<caller_t>&, caller_t*, rpc_serializer&, rpc_deserializer&)>* fn)
+			const noexcept
+		{
+			return (this->async_invokers_.find(fn) != this->async_invokers_.end());
+		}
+
+		/**
+		 * @function : find binded rpc function by method id, see asio2::rpc::method_id
+		 */
+		inline std::function<bool(std::shared_ptr<caller_t>&, caller_t*, rpc_serializer&, rpc_deserializer&)>*
+			find(std::uint32_t method_id)
+		{
+			if (this->method_ids_.empty())
+				return nullptr;
+
+			std::size_t mask = this->method_ids_.size() - 1;
+
+			for (std::size_t i = method_id & mask; this->method_ids_[i].invoker; i = (i + 1) & mask)
+			{
+				// the ambiguous method id returns null, then the peer replies not_found, and the
+				// caller must call these functions by the function name.
+				if (this->method_ids_[i].id == method_id)
+					return (this->method_ids_[i].ambiguous ? nullptr : this->method_ids_[i].invoker);
+			}
+
+			return nullptr;
+		}
+
 	protected:
 		inline self& _invoker() { return (*this); }
 
+		/**
+		 * Rebuild the open addressing table of the method ids, the pointers of the unordered_map
+		 * elements are stable, so the table only need to be rebuilt when bind or unbind.
+		 */
+		inline void _rebuild_method_ids()
+		{
+			std::size_t capacity = 16;
+			while (capacity < this->invokers_.size() * 2)
+				capacity <<= 1;
+
+			this->method_ids_.assign(capacity, method_id_slot{});
+
+			std::size_t mask = capacity - 1;
+
+			for (auto& [name, fn] : this->invokers_)
+			{
+				std::uint32_t method_id = rpc::method_id(name);
+
+				std::size_t i = method_id & mask;
+				for (; this->method_ids_[i].invoker; i = (i + 1) & mask)
+				{
+					if (this->method_ids_[i].id == method_id)
+						break;
+				}
+
+				// two function names have the same method id, don't dispatch the method id to any
+				// of them, these functions can only be called by the function name.
+				if (this->method_ids_[i].invoker)
+					this->method_ids_[i].ambiguous = true;
+				else
+					this->method_ids_[i] = { method_id, false, std::addressof(fn) };
+			}
+		}
+
+		inline void _mark_async(
+			const std::function<bool(std::shared_ptr<caller_t>&, caller_t*, rpc_serializer&, rpc_deserializer&)>& fn,
+			bool async)
+		{
+			// the function with the same name may be rebinded, so the mark must be updated too.
+			if (async)
+				this->async_invokers_.emplace(std::addressof(fn));
+			else
+				this->async_invokers_.erase(std::addressof(fn));
+		}
+
 		template<class F>
 		inline void _bind(std::string name, F f)
 		{
 			//asio2_unique_lock guard(this->mutex_);
-			this->invokers_[std::move(name)] = std::bind(&self::template _proxy<F, dummy>,
+			auto& fn = this->invokers_[std::move(name)];
+			fn = std::bind(&self::template _proxy<F, dummy>,
 				this, std::move(f), nullptr,
 				std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4);
+			this->_mark_async(fn, detail::is_template_instance_of_v<rpc::future,
+				typename function_traits<F>::return_type>);
 		}
 
 		template<class F, class C>
 		inline void _bind(std::string name, F f, C& c)
 		{
 			//asio2_unique_lock guard(this->mutex_);
-			this->invokers_[std::move(name)] = std::bind(&self::template _proxy<F, C>,
+			auto& fn = this->invokers_[std::move(name)];
+			fn = std::bind(&self::template _proxy<F, C>,
 				this, std::move(f), &c,
 				std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4);
+			this->_mark_async(fn, detail::is_template_instance_of_v<rpc::future,
+				typename function_traits<F>::return_type>);
 		}
 
 		template<class F, class C>
 		inline void _bind(std::string name, F f, C* c)
 		{
 			//asio2_unique_lock guard(this->mutex_);
-			this->invokers_[std::move(name)] = std::bind(&self::template _proxy<F, C>,
+			auto& fn = this->invokers_[std::move(name)];
+			fn = std::bind(&self::template _proxy<F, C>,
 				this, std::move(f), c,
 				std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4);
+			this->_mark_async(fn, detail::is_template_instance_of_v<rpc::future,
+				typename function_traits<F>::return_type>);
+		}
+
+		template<class F>
+		inline void _bind_offload(std::string name, F f)
+		{
+			auto& fn = this->invokers_[std::move(name)];
+			fn = std::bind(&self::template _offload_proxy<F, dummy>,
+				this, std::make_shared<F>(std::move(f)), nullptr,
+				std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4);
+			this->_mark_async(fn, true);
+		}
+
+		template<class F, class C>
+		inline void _bind_offload(std::string name, F f, C& c)
+		{
+			auto& fn = this->invokers_[std::move(name)];
+			fn = std::bind(&self::template _offload_proxy<F, C>,
+				this, std::make_shared<F>(std::move(f)), &c,
+				std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4);
+			this->_mark_async(fn, true);
+		}
+
+		template<class F, class C>
+		inline void _bind_offload(std::string name, F f, C* c)
+		{
+			auto& fn = this->invokers_[std::move(name)];
+			fn = std::bind(&self::template _offload_proxy<F, C>,
+				this, std::make_shared<F>(std::move(f)), c,
+				std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4);
+			this->_mark_async(fn, true);
+		}
+
+		// the arguments are deserialized in the io thread, and the function is called in the
+		// offload worker pool, then the response is serialized and sent in the io thread.
+		// async - return true, sync - return false
+		template<class F, class C>
+		inline bool _offload_proxy(std::shared_ptr<F>& f, C* c, std::shared_ptr<caller_t>& caller_ptr,
+			caller_t* caller, rpc_serializer& sr, rpc_deserializer& dr)
+		{
+			using fun_traits_type = function_traits<F>;
+			using fun_args_tuple = typename fun_traits_type::pod_tuple_type;
+			using fun_ret_type = typename fun_traits_type::return_type;
+
+			static_assert(!detail::is_template_instance_of_v<rpc::future, fun_ret_type>,
+				"The offload rpc function can't return rpc::future.");
+
+			constexpr bool has_caller = _offload_has_caller<fun_traits_type::argc>((fun_args_tuple*)0);
+
+			auto tp = _offload_args_tuple<has_caller>(dr, (fun_args_tuple*)0);
+
+			// The number of parameters passed in when calling rpc function exceeds the number of
+			// parameters of local function, return false and the caller will response the error.
+			if (dr.buffer().in_avail() != 0)
+				return false;
+
+			bool posted = this->offload_pool_.post(
+			[this, f, c, caller_ptr, caller, &sr, head = caller->header_, tp = std::move(tp)]
+			(const error_code& pool_ec) mutable
+			{
+				// the pool is destroyed before this task is executed. the pool is destroyed after
+				// the server or the client is stopped, the io of the caller is stopped already, so
+				// don't call the function and don't post anything to the io.
+				if (pool_ec)
+					return;
+
+				error_code ec{};
+
+				std::optional<typename rpc_result_t<fun_ret_type>::type> r;
+
+				try
+				{
+					if constexpr (has_caller)
+					{
+						auto tp_new = std::tuple_cat(std::tuple<std::shared_ptr<caller_t>&>(caller_ptr), std::move(tp));
+						r = this->template _invoke_impl<fun_ret_type>(*f, c,
+							std::make_index_sequence<std::tuple_size_v<decltype(tp_new)>>{}, std::move(tp_new));
+					}
+					else
+					{
+						r = this->template _invoke_impl<fun_ret_type>(*f, c,
+							std::make_index_sequence<std::tuple_size_v<decltype(tp)>>{}, std::move(tp));
+					}
+				}
+				catch (system_error      const& e) { ec = e.code();                }
+				catch (std::exception    const&  ) { ec = asio::error::no_data;    }
+
+				// the notify has no response, but the caller_ptr must be released in the io thread
+				// too, it maybe the last reference and the session can't be destroyed in this thread.
+				if (head.id() == static_cast<rpc_header::id_type>(0))
+				{
+					asio::post(caller->io().strand(), [caller_ptr = std::move(caller_ptr)]() mutable
+					{
+						detail::ignore_unused(caller_ptr);
+					});
+					return;
+				}
+
+				// the operator for "sr" must be in the io_context thread.
+				asio::post(caller->io().strand(),
+				[caller_ptr = std::move(caller_ptr), caller, &sr, ec, head = std::move(head),
+					r = std::move(r)]() mutable
+				{
+					detail::ignore_unused(caller_ptr);
+
+					try
+					{
+						sr.reset();
+						sr << head;
+						sr << ec;
+						if (!ec)
+						{
+							if constexpr (!std::is_same_v<fun_ret_type, void>)
+								sr << r.value(); // maybe throw some exception
+							else
+								std::ignore = r;
+						}
+
+						caller->async_send(sr.take());
+
+						return;
+					}
+					catch (cereal::exception const&  ) { if (!ec) ec = asio::error::invalid_argument; }
+					catch (std::exception    const&  ) { if (!ec) ec = asio::error::no_data         ; }
+
+					sr.reset();
+					sr << head;
+					sr << ec;
+
+					caller->async_send(sr.take());
+				});
+			});
+
+			if (posted)
+				return true;
+
+			// the waiting queue of the offload worker pool is full.
+			asio::detail::throw_error(asio::error::try_again);
+
+			return false;
+		}
+
+		template<std::size_t Argc, typename... Args>
+		static constexpr bool _offload_has_caller(std::tuple<Args...>*)
+		{
+			if constexpr (Argc != 0)
+				return std::is_same_v<std::shared_ptr<caller_t>,
+					typename std::tuple_element<0, std::tuple<Args...>>::type>;
+			else
+				return false;
+		}
+
+		template<bool HasCaller, typename... Args>
+		inline decltype(auto) _offload_args_tuple(rpc_deserializer& dr, std::tuple<Args...>* tp)
+		{
+			if constexpr (HasCaller)
+			{
+				auto args = _body_args_tuple(tp);
+				detail::for_each_tuple(args, [&dr](auto& elem) mutable
+				{
+					dr >> elem;
+				});
+				return args;
+			}
+			else
+			{
+				detail::ignore_unused(tp);
+
+				std::tuple<Args...> args;
+				detail::for_each_tuple(args, [&dr](auto& elem) mutable
+				{
+					dr >> elem;
+				});
+				return args;
+			}
 		}
 
 		template<class F, class C>
@@ -408,7 +733,7 @@ namespace asio2::detail
 						v = std::move(defer->v_)]
 					() mutable
 					{
-						head.type(rpc_type_rep);
+						head.to_response();
 
 						if (v.has_value() == false && (!ec))
 							ec = asio::error::no_data;
@@ -430,7 +755,7 @@ namespace asio2::detail
 								}
 							}
 
-							caller->async_send(sr.str());
+							caller->async_send(sr.take());
 
 							return; // not exception, return
 						}
@@ -447,7 +772,7 @@ namespace asio2::detail
 						sr << head;
 						sr << ec;
 
-						caller->async_send(sr.str());
+						caller->async_send(sr.take());
 					}));
 				});
 
@@ -498,8 +823,29 @@ namespace asio2::detail
 	protected:
 		//asio2_shared_mutex                          mutex_;
 
+		/// the worker pool which is used to call the functions binded with rpc::offload
+		rpc_offload_pool                                offload_pool_;
+
 		std::unordered_map<std::string, std::function<bool(
 			std::shared_ptr<caller_t>&, caller_t*, rpc_serializer&, rpc_deserializer&)>> invokers_;
+
+		struct method_id_slot
+		{
+			std::uint32_t id        = 0;
+
+			/// more than one function names have this method id
+			bool          ambiguous = false;
+
+			std::function<bool(
+				std::shared_ptr<caller_t>&, caller_t*, rpc_serializer&, rpc_deserializer&)>* invoker = nullptr;
+		};
+
+		/// the open addressing table of the method id to the element of invokers_
+		std::vector<method_id_slot>                     method_ids_;
+
+		/// the elements of invokers_ which return rpc::future or are binded with rpc::offload
+		std::unordered_set<const std::function<bool(
+			std::shared_ptr<caller_t>&, caller_t*, rpc_serializer&, rpc_deserializer&)>*> async_invokers_;
 	};
 }
 
@@ -0,0 +1,260 @@
+/*
+ * COPYRIGHT (C) 2017-2021, zhllxt
+ *
+ * author   : zhllxt
+ * email    : 37792738@qq.com
+ *
+ * Distributed under the GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+ * (See accompanying file LICENSE or see <http://www.gnu.org/licenses/>)
+ */
+
+#ifndef __ASIO2_RPC_OFFLOAD_HPP__
+#define __ASIO2_RPC_OFFLOAD_HPP__
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+#pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <asio2/base/error.hpp>
+
+namespace asio2::rpc
+{
+	/**
+	 * The execution policy of the rpc function, the function which is binded with this policy
+	 * will be called in the offload worker pool, instead of the io thread of the session.
+	 * eg : server.bind<asio2::rpc::offload>("query", fn);
+	 */
+	struct offload {};
+}
+
+namespace asio2::detail
+{
+	/**
+	 * The counters of the offload worker pool, the time is in nanoseconds.
+	 */
+	struct rpc_offload_stats
+	{
+		/// the count of the functions which has been called
+		std::uint64_t executed       = 0;
+
+		/// the count of the requests which are rejected because the queue is full
+		std::uint64_t rejected       = 0;
+
+		/// the count of the functions which are waiting in the queue now
+		std::uint64_t pending        = 0;
+
+		/// the total and max time of the functions waited in the queue
+		std::uint64_t wait_time      = 0;
+		std::uint64_t wait_time_max  = 0;
+
+		/// the total and max time of the functions executed
+		std::uint64_t exec_time      = 0;
+		std::uint64_t exec_time_max  = 0;
+	};
+
+	/**
+	 * A bounded worker pool which is used to call the rpc functions binded with rpc::offload.
+	 * The threads are created when the first task is posted, so there is no thread if none rpc
+	 * function is binded with rpc::offload.
+	 */
+	class rpc_offload_pool
+	{
+	public:
+		using clock_type = std::chrono::steady_clock;
+
+		/**
+		 * @constructor
+		 */
+		rpc_offload_pool() = default;
+
+		/**
+		 * @destructor
+		 */
+		~rpc_offload_pool()
+		{
+			std::queue<std::pair<clock_type::time_point, std::function<void(const error_code&)>>> tasks;
+
+			{
+				std::unique_lock<std::mutex> lock(this->mtx_);
+				this->stop_ = true;
+				tasks.swap(this->tasks_);
+			}
+
+			this->cv_.notify_all();
+
+			for (auto& worker : this->workers_)
+			{
+				if (worker.joinable())
+					worker.join();
+			}
+
+			// the tasks which are still waiting in the queue are not executed, they are completed
+			// with operation_aborted and must not touch the io of the callers, the pool is destroyed
+			// after the iopool is stopped.
+			while (!tasks.empty())
+			{
+				tasks.front().second(asio::error::operation_aborted);
+				tasks.pop();
+			}
+		}
+
+		rpc_offload_pool(rpc_offload_pool&&) = delete;
+		rpc_offload_pool(rpc_offload_pool const&) = delete;
+		rpc_offload_pool& operator=(rpc_offload_pool&&) = delete;
+		rpc_offload_pool& operator=(rpc_offload_pool const&) = delete;
+
+		/**
+		 * @function : set the thread count and the max count of the tasks waiting in the queue,
+		 * it must be called before the first task is posted.
+		 */
+		inline void config(std::size_t thread_count, std::size_t max_pending)
+		{
+			std::unique_lock<std::mutex> lock(this->mtx_);
+
+			ASIO2_ASSERT(this->workers_.empty());
+
+			this->thread_count_ = (std::max)(thread_count, std::size_t(1));
+			this->max_pending_  = (std::max)(max_pending , std::size_t(1));
+		}
+
+		/**
+		 * @function : post a task into the pool, return false if the queue is full.
+		 * Task signature : void(const error_code& ec), the ec is operation_aborted if the pool is
+		 * destroyed before the task is executed, the task should only release its data then.
+		 */
+		template<class Fun>
+		inline bool post(Fun&& fun)
+		{
+			{
+				std::unique_lock<std::mutex> lock(this->mtx_);
+
+				if (this->stop_ || this->tasks_.size() >= this->max_pending_)
+				{
+					this->rejected_.fetch_add(1, std::memory_order_relaxed);
+					return false;
+				}
+
+				if (this->workers_.empty())
+					this->_start_workers();
+
+				this->tasks_.emplace(clock_type::now(), std::forward<Fun>(fun));
+			}
+
+			this->cv_.notify_one();
+
+			return true;
+		}
+
+		/**
+		 * @function : get the counters of the pool
+		 */
+		inline rpc_offload_stats stats()
+		{
+			rpc_offload_stats s;
+
+			{
+				std::unique_lock<std::mutex> lock(this->mtx_);
+				s.pending = this->tasks_.size();
+			}
+
+			s.executed      = this->executed_     .load(std::memory_order_relaxed);
+			s.rejected      = this->rejected_     .load(std::memory_order_relaxed);
+			s.wait_time     = this->wait_time_    .load(std::memory_order_relaxed);
+			s.wait_time_max = this->wait_time_max_.load(std::memory_order_relaxed);
+			s.exec_time     = this->exec_time_    .load(std::memory_order_relaxed);
+			s.exec_time_max = this->exec_time_max_.load(std::memory_order_relaxed);
+
+			return s;
+		}
+
+	protected:
+		inline void _start_workers()
+		{
+			this->workers_.reserve(this->thread_count_);
+
+			for (std::size_t i = 0; i < this->thread_count_; ++i)
+			{
+				this->workers_.emplace_back([this]
+				{
+					for (;;)
+					{
+						std::pair<clock_type::time_point, std::function<void(const error_code&)>> task;
+
+						{
+							std::unique_lock<std::mutex> lock(this->mtx_);
+							this->cv_.wait(lock, [this] { return (this->stop_ || !this->tasks_.empty()); });
+
+							if (this->stop_)
+								return;
+
+							task = std::move(this->tasks_.front());
+							this->tasks_.pop();
+						}
+
+						auto t1 = clock_type::now();
+
+						task.second(error_code{});
+
+						auto t2 = clock_type::now();
+
+						this->_record(this->wait_time_, this->wait_time_max_, t1 - task.first);
+						this->_record(this->exec_time_, this->exec_time_max_, t2 - t1);
+
+						this->executed_.fetch_add(1, std::memory_order_relaxed);
+					}
+				});
+			}
+		}
+
+		inline void _record(std::atomic<std::uint64_t>& total, std::atomic<std::uint64_t>& max,
+			clock_type::duration d)
+		{
+			std::uint64_t ns = static_cast<std::uint64_t>(
+				std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+
+			total.fetch_add(ns, std::memory_order_relaxed);
+
+			std::uint64_t old = max.load(std::memory_order_relaxed);
+			while (old < ns && !max.compare_exchange_weak(old, ns, std::memory_order_relaxed));
+		}
+
+	protected:
+		std::vector<std::thread>                                                               workers_;
+
+		std::queue<std::pair<clock_type::time_point, std::function<void(const error_code&)>>> tasks_;
+
+		std::mutex                                                                             mtx_;
+		std::condition_variable                                                                cv_;
+
+		bool                                                                                   stop_ = false;
+
+		std::size_t thread_count_ = (std::max)(std::thread::hardware_concurrency(), 1u);
+		std::size_t max_pending_  = 1024;
+
+		std::atomic<std::uint64_t> executed_     { 0 };
+		std::atomic<std::uint64_t> rejected_     { 0 };
+		std::atomic<std::uint64_t> wait_time_    { 0 };
+		std::atomic<std::uint64_t> wait_time_max_{ 0 };
+		std::atomic<std::uint64_t> exec_time_    { 0 };
+		std::atomic<std::uint64_t> exec_time_max_{ 0 };
+	};
+}
+
+namespace asio2
+{
+	using rpc_offload_stats = detail::rpc_offload_stats;
+}
+
+#endif // !__ASIO2_RPC_OFFLOAD_HPP__
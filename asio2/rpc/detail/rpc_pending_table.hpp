@@ -0,0 +1,293 @@
+/*
+ * COPYRIGHT (C) 2017-2021, zhllxt
+ *
+ * author   : zhllxt
+ * email    : 37792738@qq.com
+ *
+ * Distributed under the GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+ * (See accompanying file LICENSE or see <http://www.gnu.org/licenses/>)
+ */
+
+#ifndef __ASIO2_RPC_PENDING_TABLE_HPP__
+#define __ASIO2_RPC_PENDING_TABLE_HPP__
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+#pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <asio2/base/error.hpp>
+#include <asio2/base/detail/metrics.hpp>
+#include <asio2/base/detail/slab_allocator.hpp>
+
+namespace asio2::detail
+{
+	/**
+	 * The callback of the pending rpc request. The callbacks made by rpc_call_cp capture the
+	 * timer and the user callback, they are larger than the small buffer of std::function, so
+	 * they are stored in the slab cache instead of the global heap.
+	 */
+	using rpc_pending_callback = slab_function<void(error_code, std::string_view)>;
+
+	/**
+	 * The table of the pending rpc requests, the key is the request id and the value is the
+	 * callback which is called when the response is recved.
+	 * The slots are a flat power of two array, the slot index is the high bits of the request id
+	 * multiplied by the golden ratio (fibonacci hashing), because the ids are made by the
+	 * sequential id_maker, if the low bits of the id are used as the slot index directly, the ids
+	 * which are in flight become long continuous runs and the probing is very long when the
+	 * responses are out of order. The whole id is saved in the slot as the generation, so the
+	 * response of a timed out request never matchs the new request which is in the same slot.
+	 * Collided ids are placed in the next free slot (linear probing), and the slots are reused,
+	 * so there is no memory allocation when the table is not growing, and the insert, find and
+	 * erase are O(1).
+	 * This class is not thread safed, it must be used in the io_context thread.
+	 */
+	template<class IdT, class F>
+	class rpc_pending_table
+	{
+	protected:
+		struct slot
+		{
+			/// the request id, 0 means the slot is empty
+			IdT id = 0;
+			F   fn{};
+		};
+
+	public:
+		/**
+		 * @constructor
+		 */
+		rpc_pending_table() = default;
+
+		/**
+		 * @destructor
+		 */
+		~rpc_pending_table()
+		{
+			if (this->metrics_)
+				this->metrics_->rpc_in_flight.sub(static_cast<std::int64_t>(this->size_));
+		}
+
+		inline std::size_t size () const noexcept { return this->size_;        }
+		inline bool        empty() const noexcept { return this->size_ == 0;   }
+
+		/**
+		 * @function : set the metrics which the count of the pending requests is added to.
+		 */
+		inline void metrics(std::shared_ptr<io_metrics> m) noexcept
+		{
+			this->metrics_ = std::move(m);
+		}
+
+		/**
+		 * @function : insert the callback of the request id.
+		 * @return   : false if the request id is exists already.
+		 */
+		inline bool emplace(IdT id, F fn)
+		{
+			ASIO2_ASSERT(id != static_cast<IdT>(0));
+
+			// keep the load factor not greater than 0.5, so the probing is short.
+			if ((this->size_ + 1) * 2 > this->slots_.size())
+				this->_grow();
+
+			std::size_t mask = this->slots_.size() - 1;
+
+			for (std::size_t i = this->_index(id);; i = (i + 1) & mask)
+			{
+				slot& s = this->slots_[i];
+
+				if (s.id == id)
+					return false;
+
+				if (s.id == static_cast<IdT>(0))
+				{
+					s.id = id;
+					s.fn = std::move(fn);
+
+					++(this->size_);
+
+					if (this->metrics_)
+						this->metrics_->rpc_in_flight.add(1);
+
+					return true;
+				}
+			}
+		}
+
+		/**
+		 * @function : find the callback of the request id.
+		 * @return   : the pointer of the callback, or nullptr if not found.
+		 */
+		inline F* find(IdT id) noexcept
+		{
+			std::size_t i = this->_find(id);
+
+			return (i == npos ? nullptr : std::addressof(this->slots_[i].fn));
+		}
+
+		/**
+		 * @function : remove the callback of the request id.
+		 */
+		inline bool erase(IdT id)
+		{
+			std::size_t i = this->_find(id);
+
+			if (i == npos)
+				return false;
+
+			this->_erase(i);
+
+			return true;
+		}
+
+		/**
+		 * @function : remove the callback of the request id, and then call it with the args,
+		 * the callback is removed before it is called, so the callback can modify the table.
+		 * @return   : false if the request id is not found.
+		 */
+		template<class... Args>
+		inline bool invoke(IdT id, Args&&... args)
+		{
+			std::size_t i = this->_find(id);
+
+			if (i == npos)
+				return false;
+
+			F fn = std::move(this->slots_[i].fn);
+
+			this->_erase(i);
+
+			fn(std::forward<Args>(args)...);
+
+			return true;
+		}
+
+		/**
+		 * @function : remove all the callbacks, and then call each of them with the args.
+		 */
+		template<class... Args>
+		inline void invoke_all(Args&&... args)
+		{
+			std::vector<slot> slots = std::move(this->slots_);
+
+			this->slots_.clear();
+
+			if (this->metrics_)
+				this->metrics_->rpc_in_flight.sub(static_cast<std::int64_t>(this->size_));
+
+			this->size_ = 0;
+
+			for (slot& s : slots)
+			{
+				if (s.id != static_cast<IdT>(0))
+					s.fn(args...);
+			}
+		}
+
+	protected:
+		static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+		inline std::size_t _index(IdT id) const noexcept
+		{
+			return static_cast<std::size_t>(
+				(static_cast<std::uint64_t>(id) * 11400714819323198485ull) >> this->shift_);
+		}
+
+		inline std::size_t _find(IdT id) const noexcept
+		{
+			if (this->size_ == 0 || id == static_cast<IdT>(0))
+				return npos;
+
+			std::size_t mask = this->slots_.size() - 1;
+
+			for (std::size_t i = this->_index(id);; i = (i + 1) & mask)
+			{
+				const slot& s = this->slots_[i];
+
+				if (s.id == id)
+					return i;
+
+				if (s.id == static_cast<IdT>(0))
+					return npos;
+			}
+		}
+
+		/// erase the slot, and shift the following collided slots backward, so no tombstone is needed.
+		inline void _erase(std::size_t i)
+		{
+			std::size_t mask = this->slots_.size() - 1;
+
+			for (std::size_t j = (i + 1) & mask;; j = (j + 1) & mask)
+			{
+				slot& s = this->slots_[j];
+
+				if (s.id == static_cast<IdT>(0))
+					break;
+
+				std::size_t k = this->_index(s.id);
+
+				// the home slot of the element j is cyclically in (i, j], it can't be moved to i.
+				if ((i <= j) ? (i < k && k <= j) : (i < k || k <= j))
+					continue;
+
+				this->slots_[i] = std::move(s);
+				i = j;
+			}
+
+			this->slots_[i].id = static_cast<IdT>(0);
+			this->slots_[i].fn = F{};
+
+			--(this->size_);
+
+			if (this->metrics_)
+				this->metrics_->rpc_in_flight.sub(1);
+		}
+
+		inline void _grow()
+		{
+			std::vector<slot> slots = std::move(this->slots_);
+
+			this->slots_.clear();
+			this->slots_.resize(slots.empty() ? std::size_t(16) : slots.size() * 2);
+
+			this->shift_ = 64;
+			for (std::size_t n = this->slots_.size(); n > std::size_t(1); n >>= 1)
+				--(this->shift_);
+
+			std::size_t mask = this->slots_.size() - 1;
+
+			for (slot& s : slots)
+			{
+				if (s.id == static_cast<IdT>(0))
+					continue;
+
+				std::size_t i = this->_index(s.id);
+				while (this->slots_[i].id != static_cast<IdT>(0))
+					i = (i + 1) & mask;
+
+				this->slots_[i] = std::move(s);
+			}
+		}
+
+	protected:
+		std::vector<slot> slots_;
+
+		std::size_t       size_ = 0;
+
+		/// 64 - log2(slots_.size())
+		unsigned int      shift_ = 64;
+
+		/// the metrics of the io, the rpc_in_flight is the count of the pending requests
+		std::shared_ptr<io_metrics> metrics_;
+	};
+}
+
+#endif // !__ASIO2_RPC_PENDING_TABLE_HPP__
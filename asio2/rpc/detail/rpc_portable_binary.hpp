@@ -33,7 +33,10 @@
 
 #include <cereal/cereal.hpp>
 
+#include <cstring>
 #include <sstream>
+#include <streambuf>
+#include <string>
 #include <limits>
 
 namespace cereal
@@ -58,6 +61,43 @@ namespace cereal
       for( std::size_t i = 0, end = DataSize / 2; i < end; ++i )
         std::swap( data[i], data[DataSize - i - 1] );
     }
+
+    //! The output buffer which can be written by the archive directly
+    /*! The write function is not virtual, so the archive don't need to call the virtual
+        std::streambuf::xsputn for each field.
+        @ingroup Internal */
+    class direct_ostrbuf : public std::streambuf
+    {
+    public:
+      inline void write( const char * data, std::size_t size )
+      {
+        this->str_.append( data, size );
+      }
+
+    protected:
+      std::string str_;
+    };
+
+    //! The input buffer which can be read by the archive directly
+    /*! The read function is not virtual, it copies the data from the get area directly.
+        @ingroup Internal */
+    class direct_istrbuf : public std::streambuf
+    {
+    public:
+      inline std::streamsize read( char * data, std::streamsize size )
+      {
+        std::streamsize avail = static_cast<std::streamsize>( this->egptr() - this->gptr() );
+
+        if( avail < size )
+          return avail;
+
+        std::memcpy( data, this->gptr(), static_cast<std::size_t>( size ) );
+
+        this->setg( this->eback(), this->gptr() + size, this->egptr() );
+
+        return size;
+      }
+    };
   } // end namespace rpc_portable_binary_detail
 
   // ######################################################################
@@ -143,12 +183,25 @@ namespace cereal
 		return (*this);
       }
 
+      //! Sets the buffer which is written directly, it must be the rdbuf of the stream
+      RPCPortableBinaryOutputArchive& direct( rpc_portable_binary_detail::direct_ostrbuf * buf )
+      {
+        itsDirect = buf;
+		return (*this);
+      }
+
       //! Writes size bytes of data to the output stream
       template <std::streamsize DataSize> inline
       void saveBinary( const void * data, std::streamsize size )
       {
         std::streamsize writtenSize = 0;
 
+        if( itsDirect && !itsConvertEndianness )
+        {
+          itsDirect->write( reinterpret_cast<const char*>( data ), static_cast<std::size_t>( size ) );
+          return;
+        }
+
         if( itsConvertEndianness )
         {
           for( std::streamsize i = 0; i < size; i += DataSize )
@@ -166,6 +219,7 @@ namespace cereal
 
     private:
       std::ostream & itsStream;
+      rpc_portable_binary_detail::direct_ostrbuf * itsDirect = nullptr;
       const uint8_t itsConvertEndianness; //!< If set to true, we will need to swap bytes upon saving
 	  Options options_;
   };
@@ -265,6 +319,13 @@ namespace cereal
 		return (*this);
       }
 
+      //! Sets the buffer which is read directly, it must be the rdbuf of the stream
+      RPCPortableBinaryInputArchive& direct( rpc_portable_binary_detail::direct_istrbuf * buf )
+      {
+        itsDirect = buf;
+		return (*this);
+      }
+
       //! Reads size bytes of data from the input stream
       /*! @param data The data to save
           @param size The number of bytes in the data
@@ -273,7 +334,9 @@ namespace cereal
       void loadBinary( void * const data, std::streamsize size )
       {
         // load data
-        auto const readSize = itsStream.rdbuf()->sgetn( reinterpret_cast<char*>( data ), size );
+        auto const readSize = itsDirect ?
+          itsDirect->read( reinterpret_cast<char*>( data ), size ) :
+          itsStream.rdbuf()->sgetn( reinterpret_cast<char*>( data ), size );
 
         if(readSize != size)
           throw Exception("Failed to read " + std::to_string(size) + " bytes from input stream! Read " + std::to_string(readSize));
@@ -291,6 +354,7 @@ namespace cereal
 
     private:
       std::istream & itsStream;
+      rpc_portable_binary_detail::direct_istrbuf * itsDirect = nullptr;
       uint8_t itsConvertEndianness; //!< If set to true, we will need to swap bytes upon loading
 	  Options options_;
   };
@@ -15,6 +15,7 @@
 #pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include <cstdint>
 #include <string>
 #include <string_view>
 
@@ -22,6 +23,25 @@
 
 #include <asio2/rpc/detail/rpc_serialization.hpp>
 
+namespace asio2::rpc
+{
+	/**
+	 * @function : Calculate the method id of the rpc function name, it's the 32 bits FNV-1a hash
+	 * of the name, and it can be calculated at compile time, eg :
+	 * constexpr std::uint32_t id = asio2::rpc::method_id("add");
+	 */
+	constexpr std::uint32_t method_id(std::string_view name) noexcept
+	{
+		std::uint32_t hash = 2166136261u;
+		for (char c : name)
+		{
+			hash ^= static_cast<std::uint8_t>(c);
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+}
+
 namespace asio2::detail
 {
 	struct use_tcp {};
@@ -35,11 +55,33 @@ namespace asio2::detail
 	 * message type : q - request, p - response
 	 *
 	 * if result type is void, then result type will wrapped to std::int8_t
+	 *
+	 * when the method id mode is enabled (see rpc_call_cp::method_id_mode), the function name is
+	 * replaced by the 32 bits method id (see asio2::rpc::method_id) :
+	 *
+	 * request  : message type + request id + method id + parameters value...
+	 * response : message type + request id + method id + error code + result value
+	 *
+	 * message type : Q - request, P - response
+	 *
+	 * the batch calls (see rpc_call_cp::batch) are sent in one frame, each call or result is a
+	 * block which is prefixed with the 4 bytes little endian size of the block :
+	 *
+	 * batch request  : message type + request id + empty name + (size + request without id)...
+	 * batch response : message type + request id + empty name + (size + error code + result value)...
+	 *
+	 * message type : m - batch request, n - batch response
 	 */
 
 	static constexpr char rpc_type_req = 'q';
 	static constexpr char rpc_type_rep = 'p';
 
+	static constexpr char rpc_type_req_id = 'Q';
+	static constexpr char rpc_type_rep_id = 'P';
+
+	static constexpr char rpc_type_req_batch = 'm';
+	static constexpr char rpc_type_rep_batch = 'n';
+
 	class rpc_header
 	{
 	public:
@@ -50,14 +92,15 @@ namespace asio2::detail
 			: type_(type), id_(id), name_(name) {}
 		~rpc_header() = default;
 
-		rpc_header(const rpc_header& r) : type_(r.type_), id_(r.id_), name_(r.name_) {}
-		rpc_header(rpc_header&& r) : type_(r.type_), id_(r.id_), name_(std::move(r.name_)) {}
+		rpc_header(const rpc_header& r) : type_(r.type_), id_(r.id_), name_(r.name_), method_id_(r.method_id_) {}
+		rpc_header(rpc_header&& r) : type_(r.type_), id_(r.id_), name_(std::move(r.name_)), method_id_(r.method_id_) {}
 
 		inline rpc_header& operator=(const rpc_header& r)
 		{
 			type_ = r.type_;
 			id_ = r.id_;
 			name_ = r.name_;
+			method_id_ = r.method_id_;
 			return (*this);
 		}
 		inline rpc_header& operator=(rpc_header&& r)
@@ -65,6 +108,7 @@ namespace asio2::detail
 			type_ = r.type_;
 			id_ = r.id_;
 			name_ = std::move(r.name_);
+			method_id_ = r.method_id_;
 			return (*this);
 		}
 
@@ -77,30 +121,78 @@ namespace asio2::detail
 		template <class Archive>
 		void save(Archive & ar) const
 		{
-			ar(type_, id_, name_);
+			if (this->has_method_id())
+				ar(type_, id_, method_id_);
+			else
+				ar(type_, id_, name_);
 		}
 
 		template <class Archive>
 		void load(Archive & ar)
 		{
-			ar(type_, id_, name_);
+			ar(type_, id_);
+
+			if (this->has_method_id())
+			{
+				name_.clear();
+				ar(method_id_);
+			}
+			else
+			{
+				ar(name_);
+			}
 		}
 
-		inline       char         type() const { return this->type_; }
-		inline       id_type      id()   const { return this->id_;   }
-		inline const std::string& name() const { return this->name_; }
+		inline       char          type()      const { return this->type_;      }
+		inline       id_type       id()        const { return this->id_;        }
+		inline const std::string&  name()      const { return this->name_;      }
+		inline       std::uint32_t method_id() const { return this->method_id_; }
+
+		inline bool is_request()  { return this->type_ == rpc_type_req || this->type_ == rpc_type_req_id; }
+		inline bool is_response() { return this->type_ == rpc_type_rep || this->type_ == rpc_type_rep_id; }
 
-		inline bool is_request()  { return this->type_ == rpc_type_req; }
-		inline bool is_response() { return this->type_ == rpc_type_rep; }
+		inline bool is_batch_request () { return this->type_ == rpc_type_req_batch; }
+		inline bool is_batch_response() { return this->type_ == rpc_type_rep_batch; }
+
+		/**
+		 * @function : Returns true if the header carries the method id instead of the function name.
+		 */
+		inline bool has_method_id() const
+		{
+			return this->type_ == rpc_type_req_id || this->type_ == rpc_type_rep_id;
+		}
 
 		inline rpc_header& type(char type            ) { this->type_ = type; return (*this); }
 		inline rpc_header& id  (id_type id           ) { this->id_   = id  ; return (*this); }
 		inline rpc_header& name(std::string_view name) { this->name_ = name; return (*this); }
 
+		/**
+		 * @function : Replace the function name with the method id when the header is serialized.
+		 */
+		inline rpc_header& use_method_id()
+		{
+			this->method_id_ = rpc::method_id(this->name_);
+			this->type_ = (this->type_ == rpc_type_rep ? rpc_type_rep_id : rpc_type_req_id);
+			return (*this);
+		}
+
+		/**
+		 * @function : Convert the request header to the response header.
+		 */
+		inline rpc_header& to_response()
+		{
+			if (this->type_ == rpc_type_req_batch || this->type_ == rpc_type_rep_batch)
+				this->type_ = rpc_type_rep_batch;
+			else
+				this->type_ = (this->has_method_id() ? rpc_type_rep_id : rpc_type_rep);
+			return (*this);
+		}
+
 	protected:
 		char           type_;
 		id_type        id_ = 0;
 		std::string    name_;
+		std::uint32_t  method_id_ = 0;
 	};
 
 	template<class ...Args>
@@ -15,6 +15,9 @@
 #pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include <cstdint>
+#include <cstring>
+#include <memory>
 #include <istream>
 #include <ostream>
 #include <streambuf>
@@ -25,12 +28,13 @@
 
 #include <asio2/3rd/asio.hpp>
 #include <asio2/base/error.hpp>
+#include <asio2/base/detail/pooled_buffer.hpp>
 
 #include <asio2/rpc/detail/rpc_portable_binary.hpp>
 
 namespace asio2::detail
 {
-	class ostrbuf : public std::streambuf
+	class ostrbuf : public cereal::rpc_portable_binary_detail::direct_ostrbuf
 	{
 	public:
 		using string_type = std::basic_string<char_type, traits_type>;
@@ -51,6 +55,38 @@ namespace asio2::detail
 			this->setp(this->str_.data(), this->str_.data() + this->str_.size());
 		}
 
+		inline size_type size() const
+		{
+			return this->str_.size();
+		}
+
+		inline void resize(size_type n)
+		{
+			this->str_.resize(n);
+
+			this->setp(this->str_.data(), this->str_.data() + this->str_.size());
+		}
+
+		inline void overwrite(size_type pos, const char_type* s, size_type n)
+		{
+			ASIO2_ASSERT(pos + n <= this->str_.size());
+
+			std::memcpy((void*)(this->str_.data() + pos), (const void*)s, n);
+		}
+
+		/**
+		 * @function : move the string out, and use the new string as the buffer.
+		 */
+		inline string_type exchange(string_type&& s)
+		{
+			string_type r = std::move(this->str_);
+
+			this->str_ = std::move(s);
+			this->clear();
+
+			return r;
+		}
+
 	protected:
 		virtual std::streamsize xsputn(const char_type* s, std::streamsize count) override
 		{
@@ -60,12 +96,9 @@ namespace asio2::detail
 
 			return count;
 		}
-
-	protected:
-		string_type str_;
 	};
 
-	class istrbuf : public std::streambuf
+	class istrbuf : public cereal::rpc_portable_binary_detail::direct_istrbuf
 	{
 	public:
 		using string_type = std::basic_string<char_type, traits_type>;
@@ -85,6 +118,14 @@ namespace asio2::detail
 			return this;
 		}
 
+		/**
+		 * @function : get the data which has not been read.
+		 */
+		inline std::string_view rest() const
+		{
+			return std::string_view(this->gptr(), size_type(this->egptr() - this->gptr()));
+		}
+
 	protected:
 		virtual std::streamsize xsgetn(char_type* s, std::streamsize count) override
 		{
@@ -108,7 +149,12 @@ namespace asio2::detail
 			: obuffer_()
 			, ostream_(&obuffer_)
 			, oarchive_(ostream_)
-		{}
+			, pool_(std::make_shared<buffer_pool>())
+		{
+			// the archive writes the fields into the buffer directly, without the virtual call
+			// of the std::streambuf.
+			this->oarchive_.direct(std::addressof(this->obuffer_));
+		}
 		~rpc_serializer() = default;
 
 		template<typename T>
@@ -143,12 +189,61 @@ namespace asio2::detail
 			return this->obuffer_.str();
 		}
 
+		/**
+		 * @function : take the serialized data away without copying, the data can be passed to
+		 * async_send directly, and the memory is given back to the serializer when the sending
+		 * is completed, so the next serialization don't need to allocate memory again.
+		 */
+		inline pooled_buffer take()
+		{
+			return pooled_buffer(this->pool_, this->obuffer_.exchange(this->pool_->acquire()));
+		}
+
+		/**
+		 * @function : begin a size prefixed block, the 4 bytes little endian size is written
+		 * when the block is end, see rpc_deserializer::next_block.
+		 * @return   : the position of the block.
+		 */
+		inline std::size_t begin_block()
+		{
+			std::size_t pos = this->obuffer_.size();
+			this->obuffer_.write("\0\0\0\0", 4);
+			return pos;
+		}
+
+		/**
+		 * @function : write the size of the block which is begin at the position.
+		 */
+		inline rpc_serializer& end_block(std::size_t pos)
+		{
+			std::uint32_t size = static_cast<std::uint32_t>(this->obuffer_.size() - pos - 4);
+
+			char bytes[4] = {
+				static_cast<char>((size      ) & 0xff), static_cast<char>((size >>  8) & 0xff),
+				static_cast<char>((size >> 16) & 0xff), static_cast<char>((size >> 24) & 0xff) };
+
+			this->obuffer_.overwrite(pos, bytes, 4);
+
+			return (*this);
+		}
+
+		/**
+		 * @function : discard the data which has been written into the block.
+		 */
+		inline rpc_serializer& clear_block(std::size_t pos)
+		{
+			this->obuffer_.resize(pos + 4);
+			return (*this);
+		}
+
 		inline ostrbuf& buffer() { return this->obuffer_; }
 
 	protected:
 		ostrbuf         obuffer_;
 		std::ostream    ostream_;
 		oarchive        oarchive_;
+
+		std::shared_ptr<buffer_pool> pool_;
 	};
 
 	class rpc_deserializer
@@ -160,7 +255,10 @@ namespace asio2::detail
 			: ibuffer_()
 			, istream_(&ibuffer_)
 			, iarchive_(istream_)
-		{}
+		{
+			// the archive reads the fields from the received data directly.
+			this->iarchive_.direct(std::addressof(this->ibuffer_));
+		}
 		~rpc_deserializer() = default;
 
 		template<typename T>
@@ -192,6 +290,40 @@ namespace asio2::detail
 			return (*this);
 		}
 
+		/**
+		 * @function : get the next size prefixed block from the data which has not been read,
+		 * see rpc_serializer::begin_block. the rest data is advanced to the end of the block.
+		 * @return   : false if there is no more block or the block is incomplete.
+		 */
+		static inline bool next_block(std::string_view& rest, std::string_view& block)
+		{
+			if (rest.size() < std::size_t(4))
+				return false;
+
+			const unsigned char* p = reinterpret_cast<const unsigned char*>(rest.data());
+
+			std::size_t size = std::size_t(p[0]) | (std::size_t(p[1]) << 8) |
+				(std::size_t(p[2]) << 16) | (std::size_t(p[3]) << 24);
+
+			if (rest.size() - 4 < size)
+				return false;
+
+			block = rest.substr(4, size);
+			rest.remove_prefix(4 + size);
+
+			return true;
+		}
+
+		/**
+		 * @function : read the block which is got by next_block, the endian of the block is the
+		 * same as the whole data, so the endian is not loaded again.
+		 */
+		inline rpc_deserializer& reset_block(std::string_view block)
+		{
+			this->ibuffer_.setbuf(block);
+			return (*this);
+		}
+
 		inline istrbuf& buffer() { return this->ibuffer_; }
 
 	protected:
@@ -87,10 +87,12 @@ namespace asio2::detail
 			{
 				try
 				{
-					head.type(rpc_type_rep);
+					auto* fn = head.has_method_id() ?
+						derive._invoker().find(head.method_id()) :
+						derive._invoker().find(head.name());
+					head.to_response();
 					sr.reset();
 					sr << head;
-					auto* fn = derive._invoker().find(head.name());
 					if (fn)
 					{
 						// async - return true, sync - return false
@@ -123,17 +125,67 @@ namespace asio2::detail
 
 				if (head.id() != static_cast<rpc_header::id_type>(0))
 				{
-					derive.async_send(sr.str());
+					derive.async_send(sr.take());
 				}
 			}
-			else if (head.is_response())
+			else if (head.is_batch_request())
 			{
-				auto iter = derive.reqs_.find(head.id());
-				if (iter != derive.reqs_.end())
+				head.to_response();
+
+				rpc_header::id_type id = head.id();
+
+				sr.reset();
+				sr << head;
+
+				std::string_view rest = dr.buffer().rest(), block;
+
+				// the header of each call has no request id, so the function which returns
+				// rpc::future or is binded with rpc::offload can't be called in the batch.
+				while (rpc_deserializer::next_block(rest, block))
 				{
-					std::function<void(error_code, std::string_view)>& cb = iter->second;
-					cb(error_code{}, data);
+					std::size_t pos = sr.begin_block();
+
+					try
+					{
+						dr.reset_block(block);
+						dr >> head;
+
+						auto* fn = head.has_method_id() ?
+							derive._invoker().find(head.method_id()) :
+							derive._invoker().find(head.name());
+
+						if (!fn)
+							asio::detail::throw_error(asio::error::not_found);
+
+						// the async function must be rejected before it is called, otherwise the
+						// function will be executed but the result of it will never be replied.
+						if (derive._invoker().is_async(fn))
+							asio::detail::throw_error(asio::error::operation_not_supported);
+
+						// async - return true, sync - return false
+						bool async = (*fn)(this_ptr, &derive, sr, dr);
+
+						ASIO2_ASSERT(!async);
+						detail::ignore_unused(async);
+
+						if (dr.buffer().in_avail() != 0)
+							asio::detail::throw_error(asio::error::invalid_argument);
+					}
+					catch (cereal::exception const&  ) { sr.clear_block(pos) << error_code{ asio::error::invalid_argument }; }
+					catch (system_error      const& e) { sr.clear_block(pos) << e.code();                                    }
+					catch (std::exception    const&  ) { sr.clear_block(pos) << error_code{ asio::error::no_data          }; }
+
+					sr.end_block(pos);
 				}
+
+				if (id != static_cast<rpc_header::id_type>(0))
+				{
+					derive.async_send(sr.take());
+				}
+			}
+			else if (head.is_response() || head.is_batch_response())
+			{
+				derive.reqs_.invoke(head.id(), error_code{}, data);
 			}
 			else
 			{
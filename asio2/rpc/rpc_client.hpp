@@ -137,11 +137,7 @@ namespace asio2::detail
 
 		inline void _handle_disconnect(const error_code& ec, std::shared_ptr<derived_t> this_ptr)
 		{
-			while (!this->reqs_.empty())
-			{
-				auto& fn = this->reqs_.begin()->second;
-				fn(asio::error::operation_aborted, std::string_view{});
-			}
+			this->reqs_.invoke_all(asio::error::operation_aborted, std::string_view{});
 
 			super::_handle_disconnect(ec, std::move(this_ptr));
 		}
@@ -150,6 +146,8 @@ namespace asio2::detail
 		inline void _fire_recv(std::shared_ptr<derived_t>& this_ptr, std::string_view data,
 			condition_wrap<MatchCondition>& condition)
 		{
+			detail::metrics_recv_scope ms(this->derived().io().metrics(), data.size());
+
 			this->listener_.notify(event_type::recv, data);
 
 			this->derived()._rpc_handle_recv(this_ptr, data, condition);
@@ -106,11 +106,7 @@ namespace asio2::detail
 
 		inline void _handle_disconnect(const error_code& ec, std::shared_ptr<derived_t> this_ptr)
 		{
-			while (!this->reqs_.empty())
-			{
-				auto& fn = this->reqs_.begin()->second;
-				fn(asio::error::operation_aborted, std::string_view{});
-			}
+			this->reqs_.invoke_all(asio::error::operation_aborted, std::string_view{});
 
 			super::_handle_disconnect(ec, std::move(this_ptr));
 		}
@@ -119,6 +115,8 @@ namespace asio2::detail
 		inline void _fire_recv(std::shared_ptr<derived_t>& this_ptr, std::string_view data,
 			condition_wrap<MatchCondition>& condition)
 		{
+			detail::metrics_recv_scope ms(this->derived().io().metrics(), data.size());
+
 			this->listener_.notify(event_type::recv, this_ptr, data);
 
 			this->derived()._rpc_handle_recv(this_ptr, data, condition);
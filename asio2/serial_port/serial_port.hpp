@@ -542,6 +542,10 @@ namespace asio2::detail
 			// close all async_events
 			this->notify_all_events();
 
+			// execute the events which are pushed from the other threads, they hold the self
+			// shared_ptr, if they are left in the lock free queue, will cause loop refrence.
+			this->_drain_mpsc_events();
+
 			// destroy user data, maybe the user data is self shared_ptr,
 			// if don't destroy it, will cause loop refrence.
 			this->user_data_.reset();
@@ -664,6 +668,8 @@ namespace asio2::detail
 		inline void _fire_recv(std::shared_ptr<derived_t>& this_ptr, std::string_view data,
 			condition_wrap<MatchCondition>& condition)
 		{
+			detail::metrics_recv_scope ms(this->derived().io().metrics(), data.size());
+
 			this->listener_.notify(event_type::recv, data);
 
 			this->derived()._rdc_handle_recv(this_ptr, data, condition);
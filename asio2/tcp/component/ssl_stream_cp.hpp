@@ -70,7 +70,7 @@ namespace asio2::detail
 			}
 			else
 			{
-				ASIO2_ASSERT(derive.sessions().io().strand().running_in_this_thread());
+				ASIO2_ASSERT(derive.sessions().io(derive.hash_key()).strand().running_in_this_thread());
 			}
 
 			// Why put the initialization code of ssl stream here ?
@@ -236,7 +236,7 @@ namespace asio2::detail
 			{
 				// Use "sessions().dispatch" to ensure that the _fire_accept function and the _fire_handshake
 				// function are fired in the same thread
-				derive.sessions().dispatch(
+				derive.sessions().dispatch(derive.hash_key(),
 				[&derive, ec, this_ptr = std::move(self_ptr), condition = std::move(condition)]
 				() mutable
 				{
@@ -17,19 +17,45 @@
 
 #include <memory>
 #include <future>
+#include <atomic>
+#include <algorithm>
 #include <utility>
 #include <string_view>
 
 #include <asio2/3rd/asio.hpp>
 #include <asio2/base/error.hpp>
 #include <asio2/base/detail/condition_wrap.hpp>
+#include <asio2/base/detail/buffer_wrap.hpp>
 
 namespace asio2::detail
 {
+	/**
+	 * The memory counters of the recv buffers of all the sessions of a server.
+	 */
+	struct recv_buffer_counter
+	{
+		/// the bytes of the recv buffers which are held by the sessions now
+		std::atomic<std::size_t> bytes        { 0 };
+
+		/// the max bytes of the recv buffers which were held by the sessions at the same time
+		std::atomic<std::size_t> peak_bytes   { 0 };
+
+		/// the count of the sessions which hold a recv buffer storage now
+		std::atomic<std::size_t> buffers      { 0 };
+
+		/// the times the recv buffer storage was released because the session is idle
+		std::atomic<std::size_t> idle_releases{ 0 };
+
+		/// the times the recv buffer was shrunk to the size of the recent recvs
+		std::atomic<std::size_t> shrinks      { 0 };
+	};
+
 	template<class derived_t, class args_t = void>
 	class tcp_recv_op
 	{
 	public:
+		using recv_buffer_type = typename args_t::buffer_t;
+
 		/**
 		 * @constructor
 		 */
@@ -38,9 +64,145 @@ namespace asio2::detail
 		/**
 		 * @destructor
 		 */
-		~tcp_recv_op() = default;
+		~tcp_recv_op()
+		{
+			if (this->recv_counter_ && this->recv_accounted_ > 0)
+			{
+				this->recv_counter_->bytes  .fetch_sub(this->recv_accounted_, std::memory_order_relaxed);
+				this->recv_counter_->buffers.fetch_sub(1, std::memory_order_relaxed);
+			}
+		}
+
+	public:
+		/**
+		 * @function : enable or disable releasing the recv buffer when the peer sends nothing,
+		 * default is disabled.
+		 * When enabled and the recv buffer is empty after the recved data is handled, the buffer
+		 * storage is freed if there is no more data in the socket, then it waits for the socket
+		 * to be readable without a buffer, and allocates the buffer again with the size of the
+		 * arrived data. It costs an extra ioctl syscall for each recv.
+		 * note : It only take effect for the plain tcp socket whose recv buffer is the
+		 *        asio2::stream_buffer, for ssl stream and serial port this setting will be ignored.
+		 */
+		inline derived_t& recv_buffer_release(bool enable)
+		{
+			this->recv_release_ = enable;
+			return static_cast<derived_t&>(*this);
+		}
+
+		/**
+		 * @function : get whether the recv buffer is released when the peer sends nothing.
+		 */
+		inline bool recv_buffer_release() const
+		{
+			return this->recv_release_;
+		}
+
+		/**
+		 * @function : get the recv size hint, it is the decayed max size of the recent recvs, the
+		 * recv buffer which is much larger than it is shrunk when it is empty.
+		 */
+		inline std::size_t recv_buffer_hint() const
+		{
+			return this->recv_hint_;
+		}
 
 	protected:
+		/**
+		 * @function : bind the memory counter of the server, called when the session is created.
+		 */
+		inline void _tcp_recv_buffer_init(std::shared_ptr<recv_buffer_counter> counter, bool release)
+		{
+			this->recv_counter_ = std::move(counter);
+			this->recv_release_ = release;
+
+			this->_tcp_recv_account();
+		}
+
+		inline decltype(auto) _tcp_recv_buffer()
+		{
+			derived_t& derive = static_cast<derived_t&>(*this);
+
+			// the asio::streambuf is passed by reference, the other dynamic buffer is passed by value.
+			if constexpr (buffer_has_release<recv_buffer_type>::value)
+				return dynamic_buffer_ref<recv_buffer_type>(derive.buffer().base());
+			else
+				return derive.buffer().base();
+		}
+
+		/**
+		 * @function : size the recv buffer by the recent recvs when it is empty, the size of each
+		 * read is the free capacity of the buffer, so it is grown to the recv size hint ahead
+		 * of the next read, and it is shrunk if it is much larger than the recent recvs, one
+		 * large message will not make the session hold the large buffer forever.
+		 */
+		inline void _tcp_recv_adapt(std::size_t bytes_recvd)
+		{
+			if constexpr (buffer_has_release<recv_buffer_type>::value)
+			{
+				derived_t& derive = static_cast<derived_t&>(*this);
+
+				this->recv_hint_ = (std::max)(bytes_recvd, this->recv_hint_ - this->recv_hint_ / 4);
+
+				std::size_t keep = (std::max)(this->recv_hint_, derive.buffer().pre_size());
+
+				if (derive.buffer().size() == 0 && derive.buffer().capacity() > keep * 4)
+				{
+					derive.buffer().base().release();
+					derive.buffer().base().reserve(keep);
+
+					if (this->recv_counter_)
+						this->recv_counter_->shrinks.fetch_add(1, std::memory_order_relaxed);
+				}
+				else if (derive.buffer().size() == 0 && derive.buffer().capacity() < keep)
+				{
+					derive.buffer().base().reserve(keep);
+				}
+
+				this->_tcp_recv_account();
+			}
+			else
+			{
+				std::ignore = bytes_recvd;
+			}
+		}
+
+		inline void _tcp_recv_account()
+		{
+			derived_t& derive = static_cast<derived_t&>(*this);
+
+			if (!this->recv_counter_)
+				return;
+
+			std::size_t capacity = derive.buffer().capacity();
+
+			if (capacity == this->recv_accounted_)
+				return;
+
+			recv_buffer_counter& counter = *(this->recv_counter_);
+
+			if (capacity > this->recv_accounted_)
+			{
+				std::size_t bytes = counter.bytes.fetch_add(capacity - this->recv_accounted_,
+					std::memory_order_relaxed) + (capacity - this->recv_accounted_);
+
+				std::size_t peak = counter.peak_bytes.load(std::memory_order_relaxed);
+				while (peak < bytes && !counter.peak_bytes.compare_exchange_weak(
+					peak, bytes, std::memory_order_relaxed));
+			}
+			else
+			{
+				counter.bytes.fetch_sub(this->recv_accounted_ - capacity, std::memory_order_relaxed);
+			}
+
+			if /**/ (this->recv_accounted_ == 0)
+				counter.buffers.fetch_add(1, std::memory_order_relaxed);
+			else if (capacity == 0)
+				counter.buffers.fetch_sub(1, std::memory_order_relaxed);
+
+			this->recv_accounted_ = capacity;
+		}
+
 		template<typename MatchCondition>
 		void _tcp_post_recv(std::shared_ptr<derived_t> this_ptr, condition_wrap<MatchCondition> condition)
 		{
@@ -51,6 +213,67 @@ namespace asio2::detail
 			if (!derive.is_started())
 				return;
 
+			if constexpr (buffer_has_release<recv_buffer_type>::value &&
+				!std::is_same_v<condition_type, asio2::detail::hook_buffer_t> &&
+				std::is_same_v<std::remove_reference_t<decltype(derive.stream())>, asio::ip::tcp::socket>)
+			{
+				if (this->recv_release_ && derive.buffer().size() == 0)
+				{
+					error_code ec;
+
+					if (derive.stream().available(ec) == 0 && !ec)
+					{
+						if (derive.buffer().capacity() > 0)
+						{
+							derive.buffer().base().release();
+
+							if (this->recv_counter_)
+								this->recv_counter_->idle_releases.fetch_add(1, std::memory_order_relaxed);
+
+							this->_tcp_recv_account();
+						}
+
+						derive.stream().async_wait(asio::socket_base::wait_read,
+							asio::bind_executor(derive.io().strand(), make_allocator(derive.rallocator(),
+								[&derive, self_ptr = std::move(this_ptr), condition]
+						(const error_code& ec) mutable
+						{
+							if (ec)
+							{
+								derive._handle_recv(ec, 0, std::move(self_ptr), std::move(condition));
+								return;
+							}
+
+							if (!derive.is_started())
+								return;
+
+							// the recent recvs maybe large, but only the bytes which are arrived now are
+							// needed, the buffer will grow if the message is larger than it.
+							error_code ec_ignored;
+
+							derive.buffer().base().reserve((std::max)(
+								derive.stream().available(ec_ignored), derive.buffer().pre_size()));
+
+							derive._tcp_recv_account();
+
+							derive._tcp_do_recv(std::move(self_ptr), std::move(condition));
+						})));
+
+						return;
+					}
+				}
+			}
+
+			derive._tcp_do_recv(std::move(this_ptr), std::move(condition));
+		}
+
+		template<typename MatchCondition>
+		void _tcp_do_recv(std::shared_ptr<derived_t> this_ptr, condition_wrap<MatchCondition> condition)
+		{
+			using condition_type = typename condition_wrap<MatchCondition>::condition_type;
+
+			derived_t& derive = static_cast<derived_t&>(*this);
+
 			try
 			{
 				if constexpr (
@@ -59,7 +282,7 @@ namespace asio2::detail
 					std::is_same_v<condition_type, asio::detail::transfer_exactly_t> ||
 					std::is_same_v<condition_type, asio2::detail::hook_buffer_t>)
 				{
-					asio::async_read(derive.stream(), derive.buffer().base(), condition(),
+					asio::async_read(derive.stream(), derive._tcp_recv_buffer(), condition(),
 						asio::bind_executor(derive.io().strand(), make_allocator(derive.rallocator(),
 							[&derive, self_ptr = std::move(this_ptr), condition]
 					(const error_code& ec, std::size_t bytes_recvd) mutable
@@ -69,7 +292,7 @@ namespace asio2::detail
 				}
 				else
 				{
-					asio::async_read_until(derive.stream(), derive.buffer().base(), condition(),
+					asio::async_read_until(derive.stream(), derive._tcp_recv_buffer(), condition(),
 						asio::bind_executor(derive.io().strand(), make_allocator(derive.rallocator(),
 							[&derive, self_ptr = std::move(this_ptr), condition]
 					(const error_code& ec, std::size_t bytes_recvd) mutable
@@ -140,6 +363,8 @@ namespace asio2::detail
 				if constexpr (!std::is_same_v<condition_type, asio2::detail::hook_buffer_t>)
 				{
 					derive.buffer().consume(bytes_recvd);
+
+					derive._tcp_recv_adapt(bytes_recvd);
 				}
 				else
 				{
@@ -159,7 +384,23 @@ namespace asio2::detail
 		}
 
 	protected:
+		/// the memory counter of the server which the session belongs to, it's null for the client
+		std::shared_ptr<recv_buffer_counter> recv_counter_;
+
+		/// the buffer capacity which is added to the memory counter
+		std::size_t                          recv_accounted_ = 0;
+
+		/// the decayed max size of the recent recvs
+		std::size_t                          recv_hint_      = 0;
+
+		/// whether release the recv buffer when the peer sends nothing
+		bool                                 recv_release_   = false;
 	};
 }
 
+namespace asio2
+{
+	using recv_buffer_counter = detail::recv_buffer_counter;
+}
+
 #endif // !__ASIO2_TCP_RECV_OP_HPP__
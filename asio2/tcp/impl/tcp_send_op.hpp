@@ -19,14 +19,29 @@
 #include <future>
 #include <utility>
 #include <string_view>
+#include <deque>
+#include <vector>
+#include <functional>
 
 #include <asio2/3rd/asio.hpp>
 #include <asio2/base/error.hpp>
+#include <asio2/base/define.hpp>
 #include <asio2/base/detail/condition_wrap.hpp>
 #include <asio2/base/detail/buffer_wrap.hpp>
+#include <asio2/base/detail/slab_allocator.hpp>
 
 namespace asio2::detail
 {
+	ASIO2_CLASS_FORWARD_DECLARE_BASE;
+	ASIO2_CLASS_FORWARD_DECLARE_TCP_CLIENT;
+	ASIO2_CLASS_FORWARD_DECLARE_TCP_SESSION;
+
+	/// default max bytes of a coalesced (gathered) write
+	static std::size_t constexpr tcp_coalesce_max_bytes   = 64 * 1024;
+
+	/// default max buffer count of a coalesced (gathered) write, the linux IOV_MAX is 1024
+	static std::size_t constexpr tcp_coalesce_max_buffers = 64;
+
 	template<class derived_t, class args_t = void>
 	class tcp_send_op
 	{
@@ -41,6 +56,88 @@ namespace asio2::detail
 		//struct has_member_dgram<T, std::void_t<decltype(T::dgram_), std::enable_if_t<
 		//	std::is_same_v<decltype(T::dgram_), bool>>>> : std::true_type {};
 
+		struct coalesce_probe_callback
+		{
+			inline void operator()(const error_code&, std::size_t) {}
+		};
+
+		/// the persisted data and the user callback of a pending send, it owns the data, so the
+		/// buffer of the data is valid until the op is destroyed.
+		struct coalesce_op_base
+		{
+			virtual ~coalesce_op_base() = default;
+
+			virtual asio::const_buffer buffer() const noexcept = 0;
+
+			virtual void complete(const error_code& ec, std::size_t bytes_sent) = 0;
+
+			/// destroy the op and free the memory into the slab cache
+			virtual void destroy() noexcept = 0;
+		};
+
+		template<class Data, class Callback>
+		struct coalesce_op : public coalesce_op_base
+		{
+			template<class D, class C>
+			coalesce_op(D&& d, C&& c) : data(std::forward<D>(d)), callback(std::forward<C>(c)) {}
+
+			virtual asio::const_buffer buffer() const noexcept override
+			{
+				return asio::buffer(this->data);
+			}
+
+			virtual void complete(const error_code& ec, std::size_t bytes_sent) override
+			{
+				this->callback(ec, bytes_sent);
+			}
+
+			virtual void destroy() noexcept override
+			{
+				this->~coalesce_op();
+				slab_deallocate(this, sizeof(coalesce_op));
+			}
+
+			Data     data;
+			Callback callback;
+		};
+
+		struct coalesce_op_deleter
+		{
+			inline void operator()(coalesce_op_base* op) const noexcept { op->destroy(); }
+		};
+
+		using coalesce_op_ptr = std::unique_ptr<coalesce_op_base, coalesce_op_deleter>;
+
+		/// the send event which can be coalesced with the adjacent send events, the flush finds
+		/// the adjacent send events by walking the event queue, so it must be a named type.
+		struct coalesce_event
+		{
+			inline void operator()(event_queue_guard<derived_t>&& g)
+			{
+				this->self->_tcp_coalesce_flush(std::move(g));
+			}
+
+			tcp_send_op*               self;
+
+			/// hold the derived object until the event is executed
+			std::shared_ptr<derived_t> p;
+
+			/// the persisted data and the user callback, it is empty after it has been sent with
+			/// the previous coalesced write or it has been aborted.
+			coalesce_op_ptr            op;
+		};
+
+		/// the async_write copies the buffer sequence, so the reused gather buffers are passed
+		/// by this view, then the vector is not copied.
+		struct coalesce_buffers_view
+		{
+			const asio::const_buffer* first;
+			const asio::const_buffer* last;
+
+			inline const asio::const_buffer* begin() const noexcept { return this->first; }
+			inline const asio::const_buffer* end  () const noexcept { return this->last;  }
+		};
+
 	public:
 		/**
 		 * @constructor
@@ -52,6 +149,39 @@ namespace asio2::detail
 		 */
 		~tcp_send_op() = default;
 
+	public:
+		/**
+		 * @function : enable or disable the send coalescing, default is disabled.
+		 * When enabled, all the pending sends which are queued behind the send which is at
+		 * the head of the send queue will be gathered into a single scatter/gather write,
+		 * and each send's callback is still called with its own bytes sent.
+		 * note : It only take effect for the raw tcp stream which is not in the dgram mode,
+		 *        for http, websocket, mqtt, rpc and so on, this setting will be ignored.
+		 */
+		inline derived_t& send_coalesce(bool enable)
+		{
+			this->coalesce_enabled_ = enable;
+			return static_cast<derived_t&>(*this);
+		}
+
+		/**
+		 * @function : set the max bytes and the max buffer count of a coalesced write.
+		 */
+		inline derived_t& send_coalesce_limits(std::size_t max_bytes, std::size_t max_buffers)
+		{
+			this->coalesce_max_bytes_   = (std::max)(max_bytes  , std::size_t(1));
+			this->coalesce_max_buffers_ = (std::max)(max_buffers, std::size_t(1));
+			return static_cast<derived_t&>(*this);
+		}
+
+		/**
+		 * @function : get whether the send coalescing is enabled.
+		 */
+		inline bool send_coalesce() const
+		{
+			return this->coalesce_enabled_;
+		}
+
 	protected:
 		template<class Data, class Callback>
 		inline bool _tcp_send(Data& data, Callback&& callback)
@@ -175,7 +305,197 @@ namespace asio2::detail
 			return true;
 		}
 
+		/**
+		 * @function : check whether the derived class sends the raw bytes by _tcp_send, the
+		 * derived classes like http, websocket, mqtt has override the _do_send function, and
+		 * the data of these classes can't be coalesced.
+		 */
+		template<class T = derived_t>
+		static constexpr bool _tcp_is_raw_stream()
+		{
+			using fn_t = decltype(&T::template _do_send<std::string, coalesce_probe_callback>);
+
+			return (
+				std::is_same_v<fn_t, bool(tcp_session_impl_t<derived_t, args_t>::*)(
+					std::string&, coalesce_probe_callback&&)> ||
+				std::is_same_v<fn_t, bool(tcp_client_impl_t <derived_t, args_t>::*)(
+					std::string&, coalesce_probe_callback&&)>);
+		}
+
+		/**
+		 * @function : check whether the send coalescing can be used currently.
+		 */
+		inline bool _tcp_coalescable()
+		{
+			derived_t& derive = static_cast<derived_t&>(*this);
+
+			if constexpr (_tcp_is_raw_stream())
+			{
+				return (this->coalesce_enabled_ && !derive.dgram_);
+			}
+			else
+			{
+				std::ignore = derive;
+				return false;
+			}
+		}
+
+		/**
+		 * @function : push a send event which can be coalesced with the adjacent send events.
+		 * Callback signature : void(const error_code& ec, std::size_t bytes_sent)
+		 */
+		template<class Data, class Callback>
+		inline void _tcp_send_coalesce(Data&& data, Callback&& callback)
+		{
+			derived_t& derive = static_cast<derived_t&>(*this);
+
+			using op_type = coalesce_op<detail::remove_cvref_t<Data>, detail::remove_cvref_t<Callback>>;
+
+			static_assert(alignof(op_type) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+				"The alignment of the send data is greater than the alignment of the slab cache.");
+
+			// the op is allocated from the slab cache of this thread, and it may be freed in the
+			// io thread, the slab cache allows this.
+			coalesce_op_ptr op{ ::new (slab_allocate(sizeof(op_type))) op_type(
+				std::forward<Data>(data), std::forward<Callback>(callback)) };
+
+			// the op is owned by the event, so the sends of the other threads are pushed by the
+			// lock free event queue too when it's enabled.
+			derive.push_event(coalesce_event{ this, derive.selfptr(), std::move(op) });
+		}
+
+		inline void _tcp_coalesce_flush(event_queue_guard<derived_t>&& g)
+		{
+			derived_t& derive = static_cast<derived_t&>(*this);
+
+			ASIO2_ASSERT(derive.io().strand().running_in_this_thread());
+
+			// the executing event is always at the front of the event queue.
+			coalesce_event* front = derive.events_.front().template target<coalesce_event>();
+
+			ASIO2_ASSERT(front);
+
+			// the op of this event has been sent with the previous coalesced write already.
+			if (!front->op)
+				return;
+
+			std::size_t count = 0, bytes = 0;
+
+			// the gather buffers are reused, the previous write is completed already, because
+			// this event is at the head of the event queue.
+			std::vector<asio::const_buffer>& buffers = this->coalesce_buffers_;
+
+			buffers.clear();
+
+			for (auto& f : derive.events_)
+			{
+				coalesce_event* e = f.template target<coalesce_event>();
+
+				// other events has been pushed between the two sends, can't coalesce them.
+				if (!e || !e->op)
+					break;
+
+				asio::const_buffer buffer = e->op->buffer();
+
+				if (count > 0 && (count >= this->coalesce_max_buffers_ ||
+					bytes + buffer.size() > this->coalesce_max_bytes_))
+					break;
+
+				buffers.emplace_back(buffer);
+
+				bytes += buffer.size();
+
+				++count;
+			}
+
+			// the ops of the writing events can't be aborted when stopping, the write handler
+			// will complete them.
+			this->coalesce_writing_ = count;
+
+			derive._tcp_send_general(coalesce_buffers_view{ buffers.data(), buffers.data() + buffers.size() },
+				[this, &derive, count, g = std::move(g)](const error_code& ec, std::size_t bytes_sent) mutable
+			{
+				ASIO2_ASSERT(g.valid());
+
+				// the front event is not popped until the guard is destroyed, and the events are
+				// only appended after it, so the positions of the written events are not changed.
+				for (std::size_t i = 0; i < count && i < derive.events_.size(); ++i)
+				{
+					coalesce_event* e = derive.events_[i].template target<coalesce_event>();
+
+					ASIO2_ASSERT(e);
+
+					if (!e || !e->op)
+						continue;
+
+					// move the op out of the event before the callback is called, then the event
+					// will be skipped when it's executed.
+					coalesce_op_ptr op = std::move(e->op);
+
+					std::size_t n = (std::min)(bytes_sent, op->buffer().size());
+
+					bytes_sent -= n;
+
+					// the coalesced sends are not pushed by _send_enqueue, so count them here.
+					if (!ec)
+						derive.io().metrics().sent(n);
+
+					op->complete(ec, n);
+				}
+
+				this->coalesce_writing_ = 0;
+
+				// remove the other written events here, otherwise each of them is popped by the
+				// guard of the previous one, and the queue is drained by the nested next_event
+				// calls, one level of the stack for each coalesced send.
+				std::size_t written = (std::min)(count, derive.events_.size());
+
+				if (written > 1)
+				{
+					derive.events_.erase(derive.events_.begin() + 1, derive.events_.begin() + written);
+					derive.metrics_->send_queue_depth.sub(static_cast<std::int64_t>(written - 1));
+				}
+			});
+		}
+
+		/**
+		 * @function : complete the pending coalesced sends with operation_aborted when stopping,
+		 * otherwise they are destroyed with the event queue without calling the callbacks.
+		 */
+		inline void _tcp_coalesce_abort()
+		{
+			derived_t& derive = static_cast<derived_t&>(*this);
+
+			ASIO2_ASSERT(derive.io().strand().running_in_this_thread());
+
+			for (std::size_t i = this->coalesce_writing_; i < derive.events_.size(); ++i)
+			{
+				coalesce_event* e = derive.events_[i].template target<coalesce_event>();
+
+				if (!e || !e->op)
+					continue;
+
+				coalesce_op_ptr op = std::move(e->op);
+
+				op->complete(asio::error::operation_aborted, 0);
+			}
+		}
+
 	protected:
+		/// the reused gather buffers of the coalesced write, it's only accessed in the strand
+		std::vector<asio::const_buffer> coalesce_buffers_;
+
+		/// the count of the events which are written by the coalesced write currently
+		std::size_t                coalesce_writing_     = 0;
+
+		/// whether the send coalescing is enabled
+		bool                       coalesce_enabled_     = false;
+
+		/// the max bytes of a coalesced write
+		std::size_t                coalesce_max_bytes_   = tcp_coalesce_max_bytes;
+
+		/// the max buffer count of a coalesced write
+		std::size_t                coalesce_max_buffers_ = tcp_coalesce_max_buffers;
 	};
 }
 
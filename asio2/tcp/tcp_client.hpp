@@ -18,6 +18,7 @@
 #include <asio2/base/detail/push_options.hpp>
 
 #include <asio2/base/client.hpp>
+#include <asio2/base/detail/linear_buffer.hpp>
 
 #include <asio2/tcp/component/tcp_keepalive_cp.hpp>
 #include <asio2/tcp/impl/tcp_send_op.hpp>
@@ -32,7 +33,7 @@ namespace asio2::detail
 		static constexpr bool is_server  = false;
 
 		using socket_t    = asio::ip::tcp::socket;
-		using buffer_t    = asio::streambuf;
+		using buffer_t    = asio2::stream_buffer;
 		using send_data_t = std::string_view;
 		using recv_data_t = std::string_view;
 	};
@@ -518,6 +519,9 @@ namespace asio2::detail
 				// call the base class stop function
 				super::stop();
 
+				// the pending coalesced sends will never be sent, notify them with operation_aborted.
+				this->derived()._tcp_coalesce_abort();
+
 				// call CRTP polymorphic stop
 				this->derived()._handle_stop(ec, std::move(this_ptr));
 			});
@@ -571,6 +575,21 @@ namespace asio2::detail
 			return this->derived()._tcp_send(data, std::forward<Callback>(callback));
 		}
 
+		template<class Data, class Callback>
+		inline void _send_enqueue(Data&& data, Callback&& callback)
+		{
+			if constexpr (self::template _tcp_is_raw_stream<derived_t>())
+			{
+				if (this->derived()._tcp_coalescable())
+				{
+					this->derived()._tcp_send_coalesce(std::forward<Data>(data), std::forward<Callback>(callback));
+					return;
+				}
+			}
+
+			super::_send_enqueue(std::forward<Data>(data), std::forward<Callback>(callback));
+		}
+
 		template<class Data>
 		inline send_data_t _rdc_convert_to_send_data(Data& data)
 		{
@@ -626,6 +645,8 @@ namespace asio2::detail
 		inline void _fire_recv(std::shared_ptr<derived_t>& this_ptr, std::string_view data,
 			condition_wrap<MatchCondition>& condition)
 		{
+			detail::metrics_recv_scope ms(this->derived().io().metrics(), data.size());
+
 			this->listener_.notify(event_type::recv, data);
 
 			this->derived()._rdc_handle_recv(this_ptr, data, condition);
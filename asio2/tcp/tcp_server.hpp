@@ -26,6 +26,22 @@ namespace asio2::detail
 	ASIO2_CLASS_FORWARD_DECLARE_TCP_BASE;
 	ASIO2_CLASS_FORWARD_DECLARE_TCP_SERVER;
 
+	/**
+	 * The additional listening socket which is opened when the server is started with the
+	 * asio2::reuse_port option, it's owned by the io_context "io".
+	 */
+	struct tcp_reuse_port_acceptor
+	{
+		explicit tcp_reuse_port_acceptor(io_t& io_ref)
+			: io(io_ref), acceptor(io_ref.context()), timer(io_ref.context())
+		{
+		}
+
+		io_t                  & io;
+		asio::ip::tcp::acceptor acceptor;
+		asio::steady_timer      timer;
+	};
+
 	template<class derived_t, class session_t>
 	class tcp_server_impl_t : public server_impl_t<derived_t, session_t>
 	{
@@ -115,6 +131,11 @@ namespace asio2::detail
 		 * function:std::pair<iterator, bool> match_condition(iterator begin, iterator end),
 		 * asio::transfer_at_least,asio::transfer_exactly
 		 * more details see asio::read_until
+		 * asio2::reuse_port(N) can be passed to open N listening sockets with the SO_REUSEPORT
+		 * option, each socket accepts the connections in its own io_context thread, and the
+		 * sessions are running in the io_context of the socket which accepts them, the policy of
+		 * session_placement is not used, eg :
+		 * server.start("0.0.0.0", 8080, asio2::reuse_port(4));
 		 */
 		template<typename String, typename StrOrInt, typename... Args>
 		inline bool start(String&& host, StrOrInt&& service, Args&&... args)
@@ -286,6 +307,48 @@ namespace asio2::detail
 			return (this->derived());
 		}
 
+	public:
+		/**
+		 * @function : set the shard count of the session manager, the sessions are stored in N
+		 * shards, each shard has its own lock and is owned by its own io_context, the sessions
+		 * are inserted and erased in the shard's thread, and the accept/connect/disconnect
+		 * notifications of a session are fired in the thread of the shard which it belongs to.
+		 * if the count is 0, the shard count will be equal to the iopool's size.
+		 * it must be called before the server is started, the default shard count is 1.
+		 */
+		inline derived_t & session_shards(std::size_t count)
+		{
+			this->sessions_.shards(count);
+			return (this->derived());
+		}
+
+		/**
+		 * @function : get the shard count of the session manager
+		 */
+		inline std::size_t session_shards() { return this->sessions_.shards(); }
+
+		/**
+		 * @function : enable or disable releasing the recv buffer of the idle sessions, default is
+		 * disabled, see tcp_recv_op::recv_buffer_release. It only take effect for the sessions
+		 * which are created after it is called.
+		 */
+		inline derived_t & recv_buffer_release(bool enable)
+		{
+			this->recv_buffer_release_ = enable;
+			return (this->derived());
+		}
+
+		/**
+		 * @function : get whether the recv buffer of the idle sessions is released.
+		 */
+		inline bool recv_buffer_release() { return this->recv_buffer_release_; }
+
+		/**
+		 * @function : get the memory counters of the recv buffers of all the sessions, the counters
+		 * are updated after each recv of the sessions.
+		 */
+		inline const detail::recv_buffer_counter& recv_buffer_stats() { return *(this->recv_buffer_counter_); }
+
 	public:
 		/**
 		 * @function : get the acceptor refrence
@@ -380,10 +443,39 @@ namespace asio2::detail
 					// set port reuse
 					this->acceptor_.set_option(asio::ip::tcp::acceptor::reuse_address(true));
 
+					std::size_t acceptor_count = 1;
+
+					if constexpr (condition_helper::has_reuse_port<MatchCondition>())
+					{
+						acceptor_count = condition.impl_->reuse_port_option(std::in_place).count(
+							this->iots_.size());
+					}
+
+					if (acceptor_count > 1)
+						detail::set_reuse_port(this->acceptor_);
+
 					this->derived()._fire_init();
 
 					this->acceptor_.bind(endpoint);
 					this->acceptor_.listen();
+
+					// the first acceptor is this->acceptor_, the others are owned by the other
+					// io_contexts, the kernel distribute the new connections between them.
+					for (std::size_t i = 1; i < acceptor_count; ++i)
+					{
+						std::shared_ptr<tcp_reuse_port_acceptor> acc =
+							std::make_shared<tcp_reuse_port_acceptor>(this->_get_io(i));
+
+						acc->acceptor.open(endpoint.protocol());
+						acc->acceptor.set_option(asio::ip::tcp::acceptor::reuse_address(true));
+
+						detail::set_reuse_port(acc->acceptor);
+
+						acc->acceptor.bind(endpoint);
+						acc->acceptor.listen();
+
+						this->reuse_acceptors_.emplace_back(std::move(acc));
+					}
 				}
 				catch (system_error const& e)
 				{
@@ -439,6 +531,16 @@ namespace asio2::detail
 
 				asio::detail::throw_error(ec);
 
+				for (std::shared_ptr<tcp_reuse_port_acceptor>& acc : this->reuse_acceptors_)
+				{
+					asio::post(acc->io.strand(),
+					[this, acc, counter = this->counter_ptr_, condition]() mutable
+					{
+						this->derived()._post_reuse_port_accept(
+							std::move(acc), std::move(counter), std::move(condition));
+					});
+				}
+
 				this->derived()._post_accept(std::move(condition));
 			}
 			catch (system_error & e)
@@ -492,6 +594,19 @@ namespace asio2::detail
 				this->sessions_.is_all_session_stop_called_ = true;
 			#endif
 
+				// close the reuse port acceptors in their own threads, then the pending accept
+				// operations will be aborted and release the counter_ptr_.
+				for (std::shared_ptr<tcp_reuse_port_acceptor>& acc : this->reuse_acceptors_)
+				{
+					asio::post(acc->io.strand(), [acc]() mutable
+					{
+						error_code ec_ignore{};
+
+						acc->timer.cancel(ec_ignore);
+						acc->acceptor.close(ec_ignore);
+					});
+				}
+
 				if (this->counter_ptr_)
 				{
 					this->counter_ptr_.reset();
@@ -543,6 +658,8 @@ namespace asio2::detail
 			// been called,otherwise the _handle_accept will never return
 			this->acceptor_.close(ec_ignore);
 
+			this->reuse_acceptors_.clear();
+
 			state_t expected = state_t::stopping;
 			if (!this->state_.compare_exchange_strong(expected, state_t::stopped))
 			{
@@ -557,11 +674,15 @@ namespace asio2::detail
 		}
 
 		template<typename... Args>
-		inline std::shared_ptr<session_t> _make_session(Args&&... args)
+		inline std::shared_ptr<session_t> _make_session(io_t& io, Args&&... args)
 		{
-			return std::make_shared<session_t>(std::forward<Args>(args)...,
-				this->sessions_, this->listener_, this->_get_io(),
+			std::shared_ptr<session_t> session_ptr = std::make_shared<session_t>(std::forward<Args>(args)...,
+				this->sessions_, this->listener_, io,
 				this->init_buffer_size_, this->max_buffer_size_);
+
+			session_ptr->_tcp_recv_buffer_init(this->recv_buffer_counter_, this->recv_buffer_release_);
+
+			return session_ptr;
 		}
 
 		template<typename MatchCondition>
@@ -574,7 +695,10 @@ namespace asio2::detail
 
 			try
 			{
-				std::shared_ptr<session_t> session_ptr = this->derived()._make_session();
+				// when the reuse port acceptors are used, the session which is accepted by the first
+				// acceptor is running in the io_context of it too, like the other acceptors.
+				std::shared_ptr<session_t> session_ptr = this->derived()._make_session(
+					this->reuse_acceptors_.empty() ? this->derived()._get_io() : this->io_);
 
 				auto& socket = session_ptr->socket().lowest_layer();
 				this->acceptor_.async_accept(socket, asio::bind_executor(this->io_.strand(),
@@ -617,16 +741,102 @@ namespace asio2::detail
 
 			if (!ec)
 			{
+				this->io_.metrics().accepts.add(1);
+
 				if (this->is_started())
 				{
 					session_ptr->counter_ptr_ = this->counter_ptr_;
-					session_ptr->start(condition);
+					this->derived()._start_session(std::move(session_ptr), condition);
 				}
 			}
 
 			this->derived()._post_accept(std::move(condition));
 		}
 
+		template<typename MatchCondition>
+		inline void _start_session(std::shared_ptr<session_t> session_ptr, condition_wrap<MatchCondition> condition)
+		{
+			// the accept and connect notifications must be fired in the thread of the session
+			// manager's shard which the session belongs to, so start the session in that thread.
+			// if there is only one shard, the thread is the thread 0, and the session is started
+			// directly when the accept is completed in the thread 0.
+			typename session_t::key_type key = session_ptr->hash_key();
+
+			this->sessions_.dispatch(key,
+			[session_ptr = std::move(session_ptr), condition = std::move(condition)]() mutable
+			{
+				session_ptr->start(std::move(condition));
+			});
+		}
+
+		template<typename MatchCondition>
+		inline void _post_reuse_port_accept(std::shared_ptr<tcp_reuse_port_acceptor> acc,
+			std::shared_ptr<void> counter, condition_wrap<MatchCondition> condition)
+		{
+			ASIO2_ASSERT(acc->io.strand().running_in_this_thread());
+
+			if (!super::is_started() || !acc->acceptor.is_open())
+				return;
+
+			try
+			{
+				// the kernel spreads the connections over the listening sockets already, so the
+				// io_placement policy is not used here, the session is running in the io_context
+				// of the acceptor which accepts it, and it's counted in the load of that io_context.
+				std::shared_ptr<session_t> session_ptr = this->derived()._make_session(acc->io);
+
+				auto& socket = session_ptr->socket().lowest_layer();
+				acc->acceptor.async_accept(socket, asio::bind_executor(acc->io.strand(),
+				[this, acc, counter, sptr = std::move(session_ptr), condition]
+				(const error_code& ec) mutable
+				{
+					this->derived()._handle_reuse_port_accept(ec, std::move(acc), std::move(counter),
+						std::move(sptr), std::move(condition));
+				}));
+			}
+			// handle exception, may be is the exception "Too many open files" (exception code : 24)
+			catch (system_error & e)
+			{
+				set_last_error(e);
+
+				acc->timer.expires_after(std::chrono::seconds(1));
+				acc->timer.async_wait(asio::bind_executor(acc->io.strand(),
+				[this, acc, counter, condition](const error_code& ec) mutable
+				{
+					set_last_error(ec);
+					if (ec) return;
+					this->derived()._post_reuse_port_accept(
+						std::move(acc), std::move(counter), std::move(condition));
+				}));
+			}
+		}
+
+		template<typename MatchCondition>
+		inline void _handle_reuse_port_accept(const error_code & ec,
+			std::shared_ptr<tcp_reuse_port_acceptor> acc, std::shared_ptr<void> counter,
+			std::shared_ptr<session_t> session_ptr, condition_wrap<MatchCondition> condition)
+		{
+			set_last_error(ec);
+
+			// if the acceptor status is closed,don't call _post_reuse_port_accept again.
+			if (ec == asio::error::operation_aborted)
+				return;
+
+			if (!ec)
+			{
+				// the accept is completed in the thread of the acceptor's io
+				acc->io.metrics().accepts.add(1);
+
+				if (super::is_started())
+				{
+					session_ptr->counter_ptr_ = counter;
+					this->derived()._start_session(std::move(session_ptr), condition);
+				}
+			}
+
+			this->derived()._post_reuse_port_accept(std::move(acc), std::move(counter), std::move(condition));
+		}
+
 		inline void _fire_init()
 		{
 			// the _fire_init must be executed in the thread 0.
@@ -669,10 +879,19 @@ namespace asio2::detail
 		/// used to hold the acceptor io_context util all sessions are closed already.
 		asio::steady_timer      counter_timer_;
 
+		/// the additional acceptors when the server is started with the asio2::reuse_port option
+		std::vector<std::shared_ptr<tcp_reuse_port_acceptor>> reuse_acceptors_;
+
 		std::size_t             init_buffer_size_ = tcp_frame_size;
 
 		std::size_t             max_buffer_size_  = max_buffer_size;
 
+		/// the memory counters of the recv buffers of all the sessions
+		std::shared_ptr<detail::recv_buffer_counter> recv_buffer_counter_ = std::make_shared<detail::recv_buffer_counter>();
+
+		/// whether release the recv buffer of the idle sessions
+		bool                    recv_buffer_release_ = false;
+
 	#if defined(ASIO2_ENABLE_LOG)
 		bool                    is_stop_called_  = false;
 	#endif
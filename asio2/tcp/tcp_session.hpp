@@ -18,6 +18,7 @@
 #include <asio2/base/detail/push_options.hpp>
 
 #include <asio2/base/session.hpp>
+#include <asio2/base/detail/linear_buffer.hpp>
 
 #include <asio2/tcp/component/tcp_keepalive_cp.hpp>
 #include <asio2/tcp/impl/tcp_send_op.hpp>
@@ -32,7 +33,7 @@ namespace asio2::detail
 		static constexpr bool is_server  = false;
 
 		using socket_t    = asio::ip::tcp::socket;
-		using buffer_t    = asio::streambuf;
+		using buffer_t    = asio2::stream_buffer;
 		using send_data_t = std::string_view;
 		using recv_data_t = std::string_view;
 	};
@@ -215,6 +216,9 @@ namespace asio2::detail
 			// call the base class stop function
 			super::stop();
 
+			// the pending coalesced sends will never be sent, notify them with operation_aborted.
+			this->derived()._tcp_coalesce_abort();
+
 			// call CRTP polymorphic stop
 			this->derived()._handle_stop(ec, std::move(this_ptr));
 		}
@@ -275,6 +279,21 @@ namespace asio2::detail
 			return this->derived()._tcp_send(data, std::forward<Callback>(callback));
 		}
 
+		template<class Data, class Callback>
+		inline void _send_enqueue(Data&& data, Callback&& callback)
+		{
+			if constexpr (self::template _tcp_is_raw_stream<derived_t>())
+			{
+				if (this->derived()._tcp_coalescable())
+				{
+					this->derived()._tcp_send_coalesce(std::forward<Data>(data), std::forward<Callback>(callback));
+					return;
+				}
+			}
+
+			super::_send_enqueue(std::forward<Data>(data), std::forward<Callback>(callback));
+		}
+
 		template<class Data>
 		inline send_data_t _rdc_convert_to_send_data(Data& data)
 		{
@@ -322,6 +341,8 @@ namespace asio2::detail
 		inline void _fire_recv(std::shared_ptr<derived_t>& this_ptr, std::string_view data,
 			condition_wrap<MatchCondition>& condition)
 		{
+			detail::metrics_recv_scope ms(this->derived().io().metrics(), data.size());
+
 			this->listener_.notify(event_type::recv, this_ptr, data);
 
 			this->derived()._rdc_handle_recv(this_ptr, data, condition);
@@ -330,7 +351,7 @@ namespace asio2::detail
 		inline void _fire_accept(std::shared_ptr<derived_t>& this_ptr)
 		{
 			// the _fire_accept must be executed in the thread 0.
-			ASIO2_ASSERT(this->sessions().io().strand().running_in_this_thread());
+			ASIO2_ASSERT(this->sessions().io(this->derived().hash_key()).strand().running_in_this_thread());
 
 			this->listener_.notify(event_type::accept, this_ptr);
 		}
@@ -339,7 +360,7 @@ namespace asio2::detail
 		inline void _fire_connect(std::shared_ptr<derived_t>& this_ptr, condition_wrap<MatchCondition>& condition)
 		{
 			// the _fire_connect must be executed in the thread 0.
-			ASIO2_ASSERT(this->sessions().io().strand().running_in_this_thread());
+			ASIO2_ASSERT(this->sessions().io(this->derived().hash_key()).strand().running_in_this_thread());
 
 		#if defined(ASIO2_ENABLE_LOG)
 			ASIO2_ASSERT(this->is_disconnect_called_ == false);
@@ -353,7 +374,7 @@ namespace asio2::detail
 		inline void _fire_disconnect(std::shared_ptr<derived_t>& this_ptr)
 		{
 			// the _fire_disconnect must be executed in the thread 0.
-			ASIO2_ASSERT(this->sessions().io().strand().running_in_this_thread());
+			ASIO2_ASSERT(this->sessions().io(this->derived().hash_key()).strand().running_in_this_thread());
 
 		#if defined(ASIO2_ENABLE_LOG)
 			this->is_disconnect_called_ = true;
@@ -92,9 +92,9 @@ namespace asio2::detail
 
 	protected:
 		template<typename... Args>
-		inline std::shared_ptr<session_t> _make_session(Args&&... args)
+		inline std::shared_ptr<session_t> _make_session(io_t& io, Args&&... args)
 		{
-			return super::_make_session(std::forward<Args>(args)..., *this);
+			return super::_make_session(io, std::forward<Args>(args)..., *this);
 		}
 	};
 }
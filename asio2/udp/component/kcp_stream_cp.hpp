@@ -53,8 +53,14 @@ namespace asio2::detail
 		 * @constructor
 		 */
 		kcp_stream_cp(derived_t& d, io_t& io)
-			: derive(d), kcp_timer_(io.context())
+			: derive(d)
 		{
+			detail::ignore_unused(io);
+
+			this->kcp_timer_.callback([this]() mutable
+			{
+				this->_handle_kcp_timer();
+			});
 		}
 
 		/**
@@ -79,12 +85,25 @@ namespace asio2::detail
 			}
 
 			this->kcp_ = kcp::ikcp_create(conv, (void*)this);
+			this->kcp_xmit_ = 0;
 			this->kcp_->output = &kcp_stream_cp<derived_t, args_t>::_kcp_output;
 
 			kcp::ikcp_nodelay(this->kcp_, 1, 10, 2, 1);
 			kcp::ikcp_wndsize(this->kcp_, 128, 512);
 
-			this->_post_kcp_timer(std::move(this_ptr));
+			// the ikcp_flush does nothing before the first ikcp_update is called, so update
+			// it immediately, otherwise the data sent before the first tick of the timer wheel
+			// will be merged into one big packet.
+			kcp::ikcp_update(this->kcp_, static_cast<std::uint32_t>(std::chrono::duration_cast<
+				std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()));
+
+			// the server session's handshake maybe executed in the session manager's thread,
+			// but the timer wheel must be accessed in the session's thread.
+			asio::dispatch(derive.io().strand(), make_allocator(derive.wallocator(),
+			[this, this_ptr = std::move(this_ptr)]() mutable
+			{
+				this->_post_kcp_timer(std::move(this_ptr));
+			}));
 		}
 
 		inline void _kcp_stop()
@@ -95,19 +114,44 @@ namespace asio2::detail
 			if (this->send_fin_)
 				this->_kcp_send_hdr(kcp::make_kcphdr_fin(0), ec_ignore);
 
-			this->kcp_timer_.cancel(ec_ignore);
+			// the wheel is not used if the kcp timer has never been scheduled.
+			if (this->kcp_timer_.scheduled())
+				derive.io().wheel().cancel(this->kcp_timer_);
+
+			// release the self shared_ptr which is holded by the timer
+			this->kcp_timer_holder_.reset();
 		}
 
 	protected:
 		inline std::size_t _kcp_send_hdr(kcp::kcphdr hdr, error_code& ec)
 		{
 			std::string msg = kcp::to_string(hdr);
-			std::size_t sent_bytes = 0;
+			return this->_kcp_send_to(msg.data(), msg.size(), ec);
+		}
+
+		inline std::size_t _kcp_send_to(const char* buf, std::size_t len, error_code& ec)
+		{
 			if constexpr (args_t::is_session)
-				sent_bytes = derive.stream().send_to(asio::buffer(msg), derive.remote_endpoint_, 0, ec);
+			{
+				// the session is not running in the thread of the server's socket, the socket
+				// maybe closed by that thread at the same time, so send the copied datagram in it.
+				if (derive.socket_io_)
+				{
+					asio::post(derive.socket_io_->strand(), make_allocator(derive.wallocator(),
+					[this_ptr = derive.selfptr(), msg = std::string(buf, len)]() mutable
+					{
+						error_code ec_ignore{};
+						this_ptr->stream().send_to(asio::buffer(msg), this_ptr->remote_endpoint_, 0, ec_ignore);
+					}));
+					return len;
+				}
+
+				return derive.stream().send_to(asio::buffer(buf, len), derive.remote_endpoint_, 0, ec);
+			}
 			else
-				sent_bytes = derive.stream().send(asio::buffer(msg), 0, ec);
-			return sent_bytes;
+			{
+				return derive.stream().send(asio::buffer(buf, len), 0, ec);
+			}
 		}
 
 		template<class Data, class Callback>
@@ -118,7 +162,10 @@ namespace asio2::detail
 			int ret = kcp::ikcp_send(this->kcp_, (const char *)buffer.data(), (int)buffer.size());
 			set_last_error(ret);
 			if (ret == 0)
+			{
 				kcp::ikcp_flush(this->kcp_);
+				this->_kcp_count_retransmits();
+			}
 			callback(get_last_error(), ret < 0 ? 0 : buffer.size());
 
 			return (ret == 0);
@@ -126,26 +173,29 @@ namespace asio2::detail
 
 		inline void _post_kcp_timer(std::shared_ptr<derived_t> this_ptr)
 		{
+			ASIO2_ASSERT(derive.io().strand().running_in_this_thread());
+
 			std::uint32_t clock1 = static_cast<std::uint32_t>(std::chrono::duration_cast<
 				std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
 			std::uint32_t clock2 = kcp::ikcp_check(this->kcp_, clock1);
 
-			this->kcp_timer_.expires_after(std::chrono::milliseconds(clock2 - clock1));
-			this->kcp_timer_.async_wait(asio::bind_executor(derive.io().strand(),
-				make_allocator(this->tallocator_,
-					[this, self_ptr = std::move(this_ptr)](const error_code & ec) mutable
-			{
-				this->_handle_kcp_timer(ec, std::move(self_ptr));
-			})));
+			// all the kcp sessions of the same io_context share one timer wheel, so there is
+			// no timer and no memory allocation for each session every time.
+			this->kcp_timer_holder_ = std::move(this_ptr);
+
+			derive.io().wheel().schedule(this->kcp_timer_, std::chrono::milliseconds(clock2 - clock1));
 		}
 
-		inline void _handle_kcp_timer(const error_code & ec, std::shared_ptr<derived_t> this_ptr)
+		inline void _handle_kcp_timer()
 		{
-			if (ec == asio::error::operation_aborted) return;
+			// the self shared_ptr of the client is empty, the client is always alive until the
+			// timer entry is canceled in the _kcp_stop.
+			std::shared_ptr<derived_t> this_ptr = std::move(this->kcp_timer_holder_);
 
 			std::uint32_t clock = static_cast<std::uint32_t>(std::chrono::duration_cast<
 				std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
 			kcp::ikcp_update(this->kcp_, clock);
+			this->_kcp_count_retransmits();
 			if (derive.is_started())
 				this->_post_kcp_timer(std::move(this_ptr));
 		}
@@ -180,6 +230,20 @@ namespace asio2::detail
 				else break;
 			}
 			kcp::ikcp_flush(this->kcp_);
+			this->_kcp_count_retransmits();
+		}
+
+		/**
+		 * add the segments which are retransmitted by the timeout since the last call to the
+		 * metrics of the io, must be called in the io strand.
+		 */
+		inline void _kcp_count_retransmits()
+		{
+			std::uint32_t xmit = this->kcp_->xmit;
+
+			derive.io().metrics().kcp_retransmits.add(xmit - this->kcp_xmit_);
+
+			this->kcp_xmit_ = xmit;
 		}
 
 		template<typename MatchCondition>
@@ -326,11 +390,7 @@ namespace asio2::detail
 			derived_t & derive = zhis->derive;
 
 			error_code ec;
-			if constexpr (args_t::is_session)
-				derive.stream().send_to(asio::buffer(buf, len),
-					derive.remote_endpoint_, 0, ec);
-			else
-				derive.stream().send(asio::buffer(buf, len), 0, ec);
+			zhis->_kcp_send_to(buf, static_cast<std::size_t>(len), ec);
 
 			return 0;
 		}
@@ -344,9 +404,14 @@ namespace asio2::detail
 
 		bool                          send_fin_ = true;
 
-		handler_memory<>              tallocator_;
+		/// the kcp_->xmit which has been added to the metrics
+		std::uint32_t                 kcp_xmit_ = 0;
+
+		/// the timer entry in the io's timer wheel, used to drive the ikcp_update
+		timer_entry                   kcp_timer_;
 
-		asio::steady_timer            kcp_timer_;
+		/// hold the self shared_ptr when the timer entry is scheduled
+		std::shared_ptr<derived_t>    kcp_timer_holder_;
 	};
 }
 
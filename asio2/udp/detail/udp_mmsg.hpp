@@ -0,0 +1,167 @@
+/*
+ * COPYRIGHT (C) 2017-2021, zhllxt
+ *
+ * author   : zhllxt
+ * email    : 37792738@qq.com
+ *
+ * Distributed under the GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+ * (See accompanying file LICENSE or see <http://www.gnu.org/licenses/>)
+ *
+ * receive multi datagrams with one system call (recvmmsg), only available on linux.
+ */
+
+#ifndef __ASIO2_UDP_MMSG_HPP__
+#define __ASIO2_UDP_MMSG_HPP__
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+#pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include <string_view>
+
+#include <asio2/3rd/asio.hpp>
+#include <asio2/base/error.hpp>
+
+#if defined(linux) || defined(__linux) || defined(__linux__) || defined(__gnu_linux__)
+	#include <sys/types.h>
+	#include <sys/socket.h>
+	#include <netinet/in.h>
+	#include <cerrno>
+
+	#ifndef ASIO2_HAS_RECVMMSG
+	#define ASIO2_HAS_RECVMMSG 1
+	#endif
+#else
+	#ifndef ASIO2_HAS_RECVMMSG
+	#define ASIO2_HAS_RECVMMSG 0
+	#endif
+#endif
+
+namespace asio2::detail
+{
+#if ASIO2_HAS_RECVMMSG
+	/**
+	 * N fixed size slots for the recvmmsg, all the slots are allocated in one block memory.
+	 */
+	class udp_mmsg_buffer
+	{
+	public:
+		/**
+		 * @constructor
+		 */
+		udp_mmsg_buffer() = default;
+
+		/**
+		 * @destructor
+		 */
+		~udp_mmsg_buffer() = default;
+
+		/**
+		 * @function : allocate the slots, it must be called before recv.
+		 */
+		inline void init(std::size_t count, std::size_t slot_size)
+		{
+			this->count_     = (std::max)(count, std::size_t(1));
+			this->slot_size_ = (std::max)(slot_size, std::size_t(1));
+
+			this->buffer_.resize(this->count_ * this->slot_size_);
+			this->iovs_  .resize(this->count_);
+			this->addrs_ .resize(this->count_);
+			this->msgs_  .resize(this->count_);
+
+			for (std::size_t i = 0; i < this->count_; ++i)
+			{
+				this->iovs_[i].iov_base = this->buffer_.data() + i * this->slot_size_;
+				this->iovs_[i].iov_len  = this->slot_size_;
+			}
+
+			this->reset();
+		}
+
+		/**
+		 * @function : receive datagrams from the nonblocking socket, returns the count of the
+		 * received datagrams, returns 0 if there is no datagram can be read.
+		 */
+		template<class NativeHandle>
+		inline std::size_t recv(NativeHandle fd, error_code& ec)
+		{
+			ec.clear();
+
+			this->reset();
+
+			int n = ::recvmmsg(fd, this->msgs_.data(), static_cast<unsigned int>(this->count_),
+				MSG_DONTWAIT, nullptr);
+
+			if (n < 0)
+			{
+				if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+					ec = error_code(errno, asio::error::get_system_category());
+				return std::size_t(0);
+			}
+
+			return static_cast<std::size_t>(n);
+		}
+
+		/**
+		 * @function : get the data of the datagram i
+		 */
+		inline std::string_view data(std::size_t i) const noexcept
+		{
+			return std::string_view(this->buffer_.data() + i * this->slot_size_, this->msgs_[i].msg_len);
+		}
+
+		/**
+		 * @function : check whether the datagram i is truncated because the slot is too small
+		 */
+		inline bool truncated(std::size_t i) const noexcept
+		{
+			return ((this->msgs_[i].msg_hdr.msg_flags & MSG_TRUNC) != 0);
+		}
+
+		/**
+		 * @function : get the remote endpoint of the datagram i
+		 */
+		inline void endpoint(std::size_t i, asio::ip::udp::endpoint& ep) const
+		{
+			std::size_t len = this->msgs_[i].msg_hdr.msg_namelen;
+
+			ASIO2_ASSERT(len <= ep.capacity());
+
+			std::memcpy(ep.data(), &(this->addrs_[i]), (std::min)(len, std::size_t(ep.capacity())));
+
+			ep.resize((std::min)(len, std::size_t(ep.capacity())));
+		}
+
+		inline std::size_t count    () const noexcept { return this->count_;     }
+		inline std::size_t slot_size() const noexcept { return this->slot_size_; }
+
+	protected:
+		inline void reset() noexcept
+		{
+			for (std::size_t i = 0; i < this->count_; ++i)
+			{
+				std::memset(&(this->msgs_[i]), 0, sizeof(::mmsghdr));
+
+				this->msgs_[i].msg_hdr.msg_name    = &(this->addrs_[i]);
+				this->msgs_[i].msg_hdr.msg_namelen = sizeof(::sockaddr_storage);
+				this->msgs_[i].msg_hdr.msg_iov     = &(this->iovs_[i]);
+				this->msgs_[i].msg_hdr.msg_iovlen  = 1;
+			}
+		}
+
+	protected:
+		std::size_t                      count_     = 0;
+		std::size_t                      slot_size_ = 0;
+
+		std::vector<char>                buffer_;
+		std::vector<::iovec>             iovs_;
+		std::vector<::sockaddr_storage>  addrs_;
+		std::vector<::mmsghdr>           msgs_;
+	};
+#endif
+}
+
+#endif // !__ASIO2_UDP_MMSG_HPP__
@@ -481,6 +481,10 @@ namespace asio2::detail
 			// close all async_events
 			this->notify_all_events();
 
+			// execute the events which are pushed from the other threads, they hold the self
+			// shared_ptr, if they are left in the lock free queue, will cause loop refrence.
+			this->_drain_mpsc_events();
+
 			// destroy user data, maybe the user data is self shared_ptr,
 			// if don't destroy it, will cause loop refrence.
 			this->user_data_.reset();
@@ -568,6 +572,8 @@ namespace asio2::detail
 		{
 			detail::ignore_unused(this_ptr, condition);
 
+			detail::metrics_recv_scope ms(this->derived().io().metrics(), data.size());
+
 			this->listener_.notify(event_type::recv, this->remote_endpoint_, data);
 		}
 
@@ -19,6 +19,7 @@
 
 #include <asio2/base/server.hpp>
 #include <asio2/udp/udp_session.hpp>
+#include <asio2/udp/detail/udp_mmsg.hpp>
 
 namespace asio2::detail
 {
@@ -26,6 +27,48 @@ namespace asio2::detail
 	ASIO2_CLASS_FORWARD_DECLARE_UDP_BASE;
 	ASIO2_CLASS_FORWARD_DECLARE_UDP_SERVER;
 
+	/**
+	 * The listening socket of the udp server, the first one is owned by the io_context 0, the
+	 * others are opened when the server is started with the asio2::reuse_port option, each of
+	 * them is owned by a different io_context "io" and receives the datagrams in its own thread,
+	 * the sessions created by a socket use the socket to send data, and are running in the same
+	 * io_context, except the recv batch mode with only one socket.
+	 */
+	template<class session_t>
+	struct udp_server_socket
+	{
+		explicit udp_server_socket(io_t& io_ref, std::size_t init_buf_size, std::size_t max_buf_size)
+			: io(io_ref), socket(io_ref.context()), remote_endpoint(), buffer(init_buf_size, max_buf_size)
+		{
+		}
+
+		io_t                                     & io;
+
+		/// the socket to recv datagrams
+		asio::ip::udp::socket                      socket;
+
+		/// the remote endpoint of the last recvd datagram
+		asio::ip::udp::endpoint                    remote_endpoint;
+
+		/// buffer
+		asio2::buffer_wrap<asio2::linear_buffer>   buffer;
+
+		/// The memory to use for handler-based custom memory allocation. used for recv.
+		handler_memory<>                           allocator;
+
+		/// the sessions which are starting in another thread and not in the session_mgr yet,
+		/// the datagrams recvd in this period are dispatched to them instead of making new sessions.
+		std::unordered_map<asio::ip::udp::endpoint, std::shared_ptr<session_t>> starting;
+
+		/// the starting map is swept when its size reaches this limit, see _sweep_starting.
+		std::size_t                                starting_sweep = 64;
+
+	#if ASIO2_HAS_RECVMMSG
+		/// the slots used for recvmmsg, it's null if the recv batch is disabled
+		std::unique_ptr<udp_mmsg_buffer>           mmsg;
+	#endif
+	};
+
 	template<class derived_t, class session_t>
 	class udp_server_impl_t : public server_impl_t<derived_t, session_t>
 	{
@@ -39,6 +82,8 @@ namespace asio2::detail
 
 		using session_type = session_t;
 
+		using socket_type  = udp_server_socket<session_t>;
+
 	public:
 		/**
 		 * @constructor
@@ -49,10 +94,10 @@ namespace asio2::detail
 			std::size_t concurrency   = 1
 		)
 			: super(concurrency)
-			, acceptor_(this->io_.context())
-			, remote_endpoint_()
-			, buffer_(init_buf_size, max_buf_size)
+			, counter_timer_(this->io_.context())
 		{
+			this->sockets_.emplace_back(std::make_shared<socket_type>(
+				this->io_, init_buf_size, max_buf_size));
 		}
 
 		template<class Scheduler, std::enable_if_t<!std::is_integral_v<detail::remove_cvref_t<Scheduler>>, int> = 0>
@@ -62,10 +107,10 @@ namespace asio2::detail
 			Scheduler&& scheduler
 		)
 			: super(std::forward<Scheduler>(scheduler))
-			, acceptor_(this->io_.context())
-			, remote_endpoint_()
-			, buffer_(init_buf_size, max_buf_size)
+			, counter_timer_(this->io_.context())
 		{
+			this->sockets_.emplace_back(std::make_shared<socket_type>(
+				this->io_, init_buf_size, max_buf_size));
 		}
 
 		template<class Scheduler, std::enable_if_t<!std::is_integral_v<detail::remove_cvref_t<Scheduler>>, int> = 0>
@@ -122,12 +167,54 @@ namespace asio2::detail
 		/**
 		 * @function : check whether the server is started
 		 */
-		inline bool is_started() { return (super::is_started() && this->acceptor_.is_open()); }
+		inline bool is_started() { return (super::is_started() && this->acceptor().is_open()); }
 
 		/**
 		 * @function : check whether the server is stopped
 		 */
-		inline bool is_stopped() { return (super::is_stopped() && !this->acceptor_.is_open()); }
+		inline bool is_stopped() { return (super::is_stopped() && !this->acceptor().is_open()); }
+
+		/**
+		 * @function : set the max count of the datagrams received by one system call, this function
+		 * must be called before the server is started, 0 or 1 means disabled(the default).
+		 * When enabled, the server uses recvmmsg to receive many datagrams in one wakeup, and each
+		 * session is bind to a io_context of the iopool(round robin), the datagrams are copied and
+		 * dispatched to the session's io_context, so the recv notifications of different sessions
+		 * can be executed in multi threads at the same time.
+		 * Only available on linux, on other platforms this option is ignored.
+		 */
+		inline derived_t & recv_batch(std::size_t count)
+		{
+			this->recv_batch_ = count;
+			return (this->derived());
+		}
+
+		/**
+		 * @function : get the max count of the datagrams received by one system call
+		 */
+		inline std::size_t recv_batch() const
+		{
+			return this->recv_batch_;
+		}
+
+		/**
+		 * @function : set the shard count of the session manager, the sessions are stored in N
+		 * shards, each shard has its own lock and is owned by its own io_context, the sessions
+		 * are inserted and erased in the shard's thread, and the connect/disconnect/handshake
+		 * notifications of a session are fired in the thread of the shard which it belongs to.
+		 * if the count is 0, the shard count will be equal to the iopool's size.
+		 * it must be called before the server is started, the default shard count is 1.
+		 */
+		inline derived_t & session_shards(std::size_t count)
+		{
+			this->sessions_.shards(count);
+			return (this->derived());
+		}
+
+		/**
+		 * @function : get the shard count of the session manager
+		 */
+		inline std::size_t session_shards() { return this->sessions_.shards(); }
 
 	public:
 		/**
@@ -258,7 +345,7 @@ namespace asio2::detail
 		/**
 		 * @function : get the acceptor refrence
 		 */
-		inline asio::ip::udp::socket & acceptor() { return this->acceptor_; }
+		inline asio::ip::udp::socket & acceptor() { return this->sockets_.front()->socket; }
 
 	protected:
 		template<typename String, typename StrOrInt, typename MatchCondition>
@@ -326,7 +413,9 @@ namespace asio2::detail
 
 					error_code ec_ignore{};
 
-					this->acceptor_.close(ec_ignore);
+					socket_type& main = *(this->sockets_.front());
+
+					main.socket.close(ec_ignore);
 
 					// parse address and port
 					asio::ip::udp::resolver resolver(this->io_.context());
@@ -334,7 +423,7 @@ namespace asio2::detail
 						asio::ip::resolver_base::flags::passive |
 						asio::ip::resolver_base::flags::address_configured).begin();
 
-					this->acceptor_.open(endpoint.protocol());
+					main.socket.open(endpoint.protocol());
 
 					// when you close socket in linux system,and start socket
 					// immediate,you will get like this "the address is in use",
@@ -346,7 +435,18 @@ namespace asio2::detail
 					// like below
 
 					// set port reuse
-					this->acceptor_.set_option(asio::ip::udp::socket::reuse_address(true));
+					main.socket.set_option(asio::ip::udp::socket::reuse_address(true));
+
+					std::size_t socket_count = 1;
+
+					if constexpr (condition_helper::has_reuse_port<MatchCondition>())
+					{
+						socket_count = condition.impl_->reuse_port_option(std::in_place).count(
+							this->iots_.size());
+					}
+
+					if (socket_count > 1)
+						detail::set_reuse_port(main.socket);
 
 					//// Join the multicast group. you can set this option in the on_init(_fire_init) function.
 					//this->acceptor_.set_option(
@@ -357,7 +457,26 @@ namespace asio2::detail
 
 					this->derived()._fire_init();
 
-					this->acceptor_.bind(endpoint);
+					main.socket.bind(endpoint);
+
+					// the first socket is owned by the io_context 0, the others are owned by the
+					// other io_contexts, the kernel distribute the datagrams between them by the
+					// hash of the source address and port, so the datagrams of a peer always
+					// arrive at the same socket.
+					for (std::size_t i = 1; i < socket_count; ++i)
+					{
+						std::shared_ptr<socket_type> sock = std::make_shared<socket_type>(
+							this->_get_io(i), main.buffer.pre_size(), main.buffer.max_size());
+
+						sock->socket.open(endpoint.protocol());
+						sock->socket.set_option(asio::ip::udp::socket::reuse_address(true));
+
+						detail::set_reuse_port(sock->socket);
+
+						sock->socket.bind(endpoint);
+
+						this->sockets_.emplace_back(std::move(sock));
+					}
 				}
 				catch (system_error const& e)
 				{
@@ -413,9 +532,38 @@ namespace asio2::detail
 
 				asio::detail::throw_error(ec);
 
-				this->buffer_.consume(this->buffer_.size());
+				for (std::shared_ptr<socket_type>& sock : this->sockets_)
+				{
+					sock->buffer.consume(sock->buffer.size());
+
+				#if ASIO2_HAS_RECVMMSG
+					if (this->recv_batch_ > 1)
+					{
+						if (!sock->mmsg)
+							sock->mmsg = std::make_unique<udp_mmsg_buffer>();
+						sock->mmsg->init(this->recv_batch_, sock->buffer.pre_size());
+					}
+					else
+					{
+						sock->mmsg.reset();
+					}
+				#endif
+				}
+
+				// the reuse port sockets hold the counter_ptr_, so the server will be stopped
+				// only after all of them has been closed already.
+				for (std::size_t i = 1; i < this->sockets_.size(); ++i)
+				{
+					std::shared_ptr<socket_type>& sock = this->sockets_[i];
+
+					asio::post(sock->io.strand(),
+					[this, sock, counter = this->counter_ptr_, condition]() mutable
+					{
+						this->derived()._post_recv(std::move(sock), std::move(counter), std::move(condition));
+					});
+				}
 
-				this->derived()._post_recv(std::move(condition));
+				this->derived()._post_recv(this->sockets_.front(), nullptr, std::move(condition));
 			}
 			catch (system_error & e)
 			{
@@ -458,6 +606,12 @@ namespace asio2::detail
 				// otherwise it may be cause loop lock.
 				set_last_error(ec);
 
+				// start timer to hold the io_context 0, the sessions and the reuse port sockets
+				// maybe release the counter_ptr_ in other threads, the io_context 0 must be alive
+				// until the _exec_stop is called.
+				this->counter_timer_.expires_after((std::chrono::nanoseconds::max)());
+				this->counter_timer_.async_wait(asio::bind_executor(this->io_.strand(), [](const error_code&) {}));
+
 				// stop all the sessions, the session::stop must be no blocking,
 				// otherwise it may be cause loop lock.
 				this->sessions_.for_each([](std::shared_ptr<session_t> & session_ptr) mutable
@@ -469,6 +623,24 @@ namespace asio2::detail
 				this->sessions_.is_all_session_stop_called_ = true;
 			#endif
 
+				// clear the starting sessions and close the reuse port sockets in their own
+				// threads, then the pending recv operations will be aborted and release the
+				// counter_ptr_.
+				for (std::size_t i = 0; i < this->sockets_.size(); ++i)
+				{
+					std::shared_ptr<socket_type>& sock = this->sockets_[i];
+
+					asio::dispatch(sock->io.strand(), [sock, i]() mutable
+					{
+						error_code ec_ignore{};
+
+						sock->starting.clear();
+
+						if (i > 0)
+							sock->socket.close(ec_ignore);
+					});
+				}
+
 				if (this->counter_ptr_)
 				{
 					this->counter_ptr_.reset();
@@ -508,155 +680,343 @@ namespace asio2::detail
 
 			this->derived()._fire_stop(ec);
 
+			this->counter_timer_.cancel(ec_ignore);
+
 			// call the base class stop function
 			super::stop();
 
 			// Call shutdown() to indicate that you will not write any more data to the socket.
-			this->acceptor_.shutdown(asio::socket_base::shutdown_both, ec_ignore);
+			this->acceptor().shutdown(asio::socket_base::shutdown_both, ec_ignore);
 			// Call close,otherwise the _handle_recv will never return
-			this->acceptor_.close(ec_ignore);
+			this->acceptor().close(ec_ignore);
+
+			this->sockets_.resize(1);
 		}
 
 		template<typename MatchCondition>
-		inline void _post_recv(condition_wrap<MatchCondition> condition)
+		inline void _post_recv(std::shared_ptr<socket_type> sock, std::shared_ptr<void> counter,
+			condition_wrap<MatchCondition> condition)
 		{
-			if (!this->is_started())
+			ASIO2_ASSERT(sock->io.strand().running_in_this_thread());
+
+			if (!super::is_started() || !sock->socket.is_open())
 				return;
 
+			socket_type& s = *sock;
+
 			try
 			{
-				this->acceptor_.async_receive_from(
-					this->buffer_.prepare(this->buffer_.pre_size()), this->remote_endpoint_,
-					asio::bind_executor(this->io_.strand(), make_allocator(this->rallocator_,
-						[this, condition = std::move(condition)]
+				s.socket.async_receive_from(
+					s.buffer.prepare(s.buffer.pre_size()), s.remote_endpoint,
+					asio::bind_executor(s.io.strand(), make_allocator(s.allocator,
+						[this, sock = std::move(sock), counter = std::move(counter), condition = std::move(condition)]
 				(const error_code& ec, std::size_t bytes_recvd) mutable
 				{
-					this->derived()._handle_recv(ec, bytes_recvd, std::move(condition));
+					this->derived()._handle_recv(ec, bytes_recvd,
+						std::move(sock), std::move(counter), std::move(condition));
 				})));
 			}
 			catch (system_error & e)
 			{
 				set_last_error(e);
-				this->derived()._do_stop(e.code());
+
+				if (!counter)
+					this->derived()._do_stop(e.code());
 			}
 		}
 
 		template<typename MatchCondition>
 		inline void _handle_recv(const error_code& ec, std::size_t bytes_recvd,
+			std::shared_ptr<socket_type> sock, std::shared_ptr<void> counter,
 			condition_wrap<MatchCondition> condition)
 		{
 			set_last_error(ec);
 
+			// the counter is empty means this is the socket of the io_context 0, the reuse port
+			// sockets are closed by the _post_stop, so just return.
 			if (ec == asio::error::operation_aborted)
 			{
-				this->derived()._do_stop(ec);
+				if (!counter)
+					this->derived()._do_stop(ec);
 				return;
 			}
 
-			if (!this->is_started())
+			if (!super::is_started() || !sock->socket.is_open())
 				return;
 
-			this->buffer_.commit(bytes_recvd);
+			socket_type& s = *sock;
+
+			s.buffer.commit(bytes_recvd);
 
 			if (!ec)
 			{
 				std::string_view data = std::string_view(static_cast<std::string_view::const_pointer>
-					(this->buffer_.data().data()), bytes_recvd);
+					(s.buffer.data().data()), bytes_recvd);
+
+				this->derived()._handle_datagram(sock, counter, data, condition);
+
+			#if ASIO2_HAS_RECVMMSG
+				// the first datagram is received by the async_receive_from, then read the remaining
+				// datagrams in the socket receive queue with recvmmsg, the async_receive_from is used
+				// to wait for the readable event, because it will try to read the socket immediately
+				// when it is called, so no readable event will be lost.
+				if (s.mmsg)
+					this->derived()._handle_recv_batch(sock, counter, condition);
+			#endif
+			}
+
+			s.buffer.consume(s.buffer.size());
+
+			if (bytes_recvd == s.buffer.pre_size())
+			{
+				s.buffer.pre_size((std::min)(s.buffer.pre_size() * 2, s.buffer.max_size()));
+			}
 
-				// first we find whether the session is in the session_mgr pool already,if not ,
-				// we new a session and put it into the session_mgr pool
-				std::shared_ptr<session_t> session_ptr = this->sessions_.find(this->remote_endpoint_);
-				if (!session_ptr)
+			this->derived()._post_recv(std::move(sock), std::move(counter), std::move(condition));
+		}
+
+		template<typename MatchCondition>
+		inline void _handle_datagram(std::shared_ptr<socket_type>& sock, std::shared_ptr<void>& counter,
+			std::string_view data, condition_wrap<MatchCondition>& condition)
+		{
+			error_code ec{};
+
+			// first we find whether the session is in the session_mgr pool already,if not ,
+			// we new a session and put it into the session_mgr pool
+			std::shared_ptr<session_t> session_ptr = this->sessions_.find(sock->remote_endpoint);
+			if (!session_ptr)
+			{
+				// the session of this endpoint maybe starting in another thread, then queue the
+				// datagram to it, the queued datagrams will be handled after it is started.
+				if (!sock->starting.empty())
 				{
-					this->derived()._handle_accept(ec, data, session_ptr, condition);
+					auto iter = sock->starting.find(sock->remote_endpoint);
+					if (iter != sock->starting.end() && !iter->second->is_stopped())
+					{
+						iter->second->_post_batch_recv(iter->second, data, condition);
+						return;
+					}
 				}
-				else
+
+				this->derived()._handle_accept(ec, data, session_ptr, sock, counter, condition);
+				return;
+			}
+
+			if (!sock->starting.empty())
+				sock->starting.erase(sock->remote_endpoint);
+
+			if constexpr (std::is_same_v<typename condition_wrap<MatchCondition>::condition_type, use_kcp_t>)
+			{
+				// the client is disconnect without send a "fin" or the server has't recvd the 
+				// "fin", and then the client connect again a later, at this time, the client
+				// is in the session map already, so we need check whether the first message is fin
+				if (data.size() == kcp::kcphdr::required_size() && kcp::is_kcphdr_syn(data))
 				{
-					if constexpr (std::is_same_v<typename condition_wrap<MatchCondition>::condition_type, use_kcp_t>)
+					if (session_ptr->kcp_)
+						session_ptr->kcp_->send_fin_ = false;
+					session_ptr->stop();
+
+					session_t* session = session_ptr.get();
+
+					session->push_event([this, ec, session_ptr = std::move(session_ptr),
+						sock, counter, condition, syn = std::string{ data.data(),data.size() }]
+					(event_queue_guard<session_t>&& g) mutable
 					{
-						if (data.size() == kcp::kcphdr::required_size())
-						{
-							// the client is disconnect without send a "fin" or the server has't recvd the 
-							// "fin", and then the client connect again a later, at this time, the client
-							// is in the session map already, so we need check whether the first message is fin
-							if /**/ (kcp::is_kcphdr_syn(data))
-							{
-								if (session_ptr->kcp_)
-									session_ptr->kcp_->send_fin_ = false;
-								session_ptr->stop();
-
-								session_t* session = session_ptr.get();
-
-								session->push_event([this, ec, session_ptr = std::move(session_ptr),
-									condition = std::move(condition), syn = std::string{ data.data(),data.size() }]
-								(event_queue_guard<session_t>&& g) mutable
-								{
-									detail::ignore_unused(g);
-
-									this->derived()._handle_accept(ec,
-										std::string_view{ syn }, std::move(session_ptr), std::move(condition));
-								});
-							}
-							else
-							{
-								session_ptr->_handle_recv(ec, data, session_ptr, condition);
-							}
-						}
-						else
+						detail::ignore_unused(g);
+
+						// the session maybe in another thread when the recv batch is enabled, so
+						// we need to switch to the socket's thread to make the new session.
+						asio::dispatch(sock->io.strand(), make_allocator(sock->allocator,
+						[this, ec, session_ptr = std::move(session_ptr), sock = std::move(sock),
+							counter = std::move(counter), condition = std::move(condition),
+							syn = std::move(syn)]() mutable
 						{
-							session_ptr->_handle_recv(ec, data, session_ptr, condition);
-						}
-					}
-					else
-					{
-						session_ptr->_handle_recv(ec, data, session_ptr, condition);
-					}
+							// the socket remote endpoint maybe changed already, so restore it.
+							sock->remote_endpoint = session_ptr->remote_endpoint_;
+
+							this->derived()._handle_accept(ec, std::string_view{ syn },
+								std::move(session_ptr), sock, counter, std::move(condition));
+						}));
+					});
+
+					return;
 				}
 			}
 
-			this->buffer_.consume(this->buffer_.size());
-
-			if (bytes_recvd == this->buffer_.pre_size())
+			// if the session is running in another thread, copy the datagram and dispatch it to
+			// the session's thread, otherwise handle it directly.
+			if (std::addressof(session_ptr->io()) != std::addressof(sock->io))
 			{
-				this->buffer_.pre_size((std::min)(this->buffer_.pre_size() * 2, this->buffer_.max_size()));
+				session_ptr->_post_batch_recv(session_ptr, data, condition);
+				return;
 			}
 
-			this->derived()._post_recv(std::move(condition));
+			session_ptr->_handle_recv(ec, data, session_ptr, condition);
 		}
 
+	#if ASIO2_HAS_RECVMMSG
+		template<typename MatchCondition>
+		inline void _handle_recv_batch(std::shared_ptr<socket_type>& sock, std::shared_ptr<void>& counter,
+			condition_wrap<MatchCondition>& condition)
+		{
+			socket_type& s = *sock;
+
+			udp_mmsg_buffer& mmsg = *(s.mmsg);
+
+			// limit the rounds of one wakeup, otherwise the other events in this thread will
+			// be starved when the datagrams are arrived continuously.
+			for (std::size_t round = 0; round < std::size_t(16) && super::is_started(); ++round)
+			{
+				error_code ec{};
+
+				std::size_t n = mmsg.recv(s.socket.native_handle(), ec);
+
+				if (ec)
+				{
+					set_last_error(ec);
+					break;
+				}
+
+				bool grow = false;
+
+				for (std::size_t i = 0; i < n; ++i)
+				{
+					std::string_view data = mmsg.data(i);
+
+					// the truncated datagram is dropped, the tail of it is lost already, the kcp
+					// and the user handlers must not get a corrupted payload.
+					if (mmsg.truncated(i))
+					{
+						grow = true;
+						s.io.metrics().udp_truncated.add(1);
+						continue;
+					}
+
+					if (data.size() == mmsg.slot_size())
+						grow = true;
+
+					mmsg.endpoint(i, s.remote_endpoint);
+
+					this->derived()._handle_datagram(sock, counter, data, condition);
+				}
+
+				// all the datagrams has been copied into the sessions already, so the slots can be
+				// reallocated safely.
+				if (grow)
+				{
+					std::size_t size = (std::min)(mmsg.slot_size() * 2,
+						(std::min)(s.buffer.max_size(), std::size_t(65536)));
+					if (size > mmsg.slot_size())
+						mmsg.init(mmsg.count(), size);
+				}
+
+				if (n < mmsg.count())
+					break;
+			}
+		}
+	#endif
+
 		template<typename... Args>
-		inline std::shared_ptr<session_t> _make_session(Args&&... args)
+		inline std::shared_ptr<session_t> _make_session(socket_type& sock, Args&&... args)
 		{
 			return std::make_shared<session_t>(
 				std::forward<Args>(args)...,
 				this->sessions_,
 				this->listener_,
-				this->io_,
-				this->buffer_.pre_size(),
-				this->buffer_.max_size(),
-				this->buffer_,
-				this->acceptor_,
-				this->remote_endpoint_);
+				this->derived()._get_session_io(sock),
+				sock.buffer.pre_size(),
+				sock.buffer.max_size(),
+				sock.buffer,
+				sock.socket,
+				sock.remote_endpoint);
+		}
+
+		inline io_t& _get_session_io(socket_type& sock)
+		{
+			// when the recv batch is enabled and there is only one socket, the sessions are
+			// distributed to the io_contexts of the iopool, otherwise the session is running
+			// in the io_context of the socket which recvd it.
+		#if ASIO2_HAS_RECVMMSG
+			if (sock.mmsg && this->sockets_.size() == 1)
+				return this->_get_io();
+		#endif
+
+			return sock.io;
 		}
 
 		template<typename MatchCondition>
 		inline void _handle_accept(const error_code & ec, std::string_view first,
-			std::shared_ptr<session_t> session_ptr, condition_wrap<MatchCondition> condition)
+			std::shared_ptr<session_t> session_ptr, std::shared_ptr<socket_type>& sock,
+			std::shared_ptr<void>& counter, condition_wrap<MatchCondition> condition)
 		{
 			set_last_error(ec);
 
 			if (!ec)
 			{
-				if (this->is_started())
+				if (super::is_started())
 				{
-					session_ptr = this->derived()._make_session();
-					session_ptr->counter_ptr_ = this->counter_ptr_;
-					session_ptr->first_ = first;
-					session_ptr->start(std::move(condition));
+					session_ptr = this->derived()._make_session(*sock);
+					session_ptr->counter_ptr_ = (counter ? counter : this->counter_ptr_);
+
+					// the new endpoint is handled in the thread of the socket's io
+					sock->io.metrics().accepts.add(1);
+					session_ptr->_init_first(first);
+
+					// the session is running in another thread than the socket, so it need its
+					// own buffer.
+					if (std::addressof(session_ptr->io()) != std::addressof(sock->io))
+						session_ptr->_init_batch_recv(sock->io);
+
+					// the session will be started in another thread, the session is not in the
+					// session_mgr until it is started, so record it to avoid making another session
+					// for the following datagrams of the same endpoint.
+					if (std::addressof(this->sessions_.io(session_ptr->hash_key())) != std::addressof(sock->io))
+					{
+						if (sock->starting.size() >= sock->starting_sweep)
+							this->derived()._sweep_starting(*sock);
+
+						sock->starting[session_ptr->hash_key()] = session_ptr;
+					}
+
+					this->derived()._start_session(std::move(session_ptr), std::move(condition));
 				}
 			}
 		}
 
+		inline void _sweep_starting(socket_type& sock)
+		{
+			// remove the sessions which are stopped or are in the session_mgr already. the map
+			// is only swept when it is doubled since the last sweep, so a burst of new endpoints
+			// costs an amortized constant work per endpoint instead of a walk of the whole map.
+			for (auto iter = sock.starting.begin(); iter != sock.starting.end();)
+			{
+				std::shared_ptr<session_t>& session_ptr = iter->second;
+
+				if (session_ptr->is_stopped() || this->sessions_.find(iter->first) == session_ptr)
+					iter = sock.starting.erase(iter);
+				else
+					++iter;
+			}
+
+			sock.starting_sweep = (std::max)(std::size_t(64), sock.starting.size() * 2);
+		}
+
+		template<typename MatchCondition>
+		inline void _start_session(std::shared_ptr<session_t> session_ptr, condition_wrap<MatchCondition> condition)
+		{
+			// the connect and handshake notifications must be fired in the thread of the session
+			// manager's shard which the session belongs to, so start the session in that thread.
+			// if there is only one shard and one socket, the session is started directly in the
+			// thread 0.
+			typename session_t::key_type key = session_ptr->hash_key();
+
+			this->sessions_.dispatch(key,
+			[session_ptr = std::move(session_ptr), condition = std::move(condition)]() mutable
+			{
+				session_ptr->start(std::move(condition));
+			});
+		}
+
 		inline void _fire_init()
 		{
 			// the _fire_init must be executed in the thread 0.
@@ -690,14 +1050,15 @@ namespace asio2::detail
 		}
 
 	protected:
-		/// acceptor to accept client connection
-		asio::ip::udp::socket    acceptor_;
+		/// the sockets to recv datagrams, the first one is owned by the io_context 0, the others
+		/// are opened when the server is started with the asio2::reuse_port option
+		std::vector<std::shared_ptr<socket_type>> sockets_;
 
-		/// endpoint for udp 
-		asio::ip::udp::endpoint  remote_endpoint_;
+		/// used to hold the io_context 0 util all sessions and sockets are closed already.
+		asio::steady_timer       counter_timer_;
 
-		/// buffer
-		asio2::buffer_wrap<asio2::linear_buffer> buffer_;
+		/// the max count of the datagrams received by one system call
+		std::size_t              recv_batch_ = 0;
 
 	#if defined(ASIO2_ENABLE_LOG)
 		bool                    is_stop_called_  = false;
@@ -17,6 +17,9 @@
 
 #include <asio2/base/detail/push_options.hpp>
 
+#include <cstring>
+#include <mutex>
+
 #include <asio2/base/session.hpp>
 #include <asio2/base/detail/linear_buffer.hpp>
 #include <asio2/udp/impl/udp_send_op.hpp>
@@ -312,10 +315,13 @@ namespace asio2::detail
 				// start the timer of check silence timeout
 				this->derived()._post_silence_timer(this->silence_timeout_, this_ptr);
 
-				if constexpr (std::is_same_v<condition_type, asio2::detail::use_kcp_t>)
-					detail::ignore_unused(this_ptr, condition);
-				else
-					this->derived()._handle_recv(error_code{}, this->first_, this_ptr, std::move(condition));
+				if constexpr (!std::is_same_v<condition_type, asio2::detail::use_kcp_t>)
+					this->derived()._handle_recv(error_code{}, this->first_, this_ptr, condition);
+
+				// handle the datagrams which are dispatched by the server before the session started
+				this->batch_started_ = true;
+
+				this->derived()._handle_batch_recv(this_ptr, condition);
 			}));
 		}
 
@@ -323,10 +329,24 @@ namespace asio2::detail
 		template<class Data, class Callback>
 		inline bool _do_send(Data& data, Callback&& callback)
 		{
-			if (!this->kcp_)
+			if (this->kcp_)
+				return this->kcp_->_kcp_send(data, std::forward<Callback>(callback));
+
+			if (!this->socket_io_)
 				return this->derived()._udp_send_to(
 					this->remote_endpoint_, data, std::forward<Callback>(callback));
-			return this->kcp_->_kcp_send(data, std::forward<Callback>(callback));
+
+			// the server's socket is recvd and closed in the thread of its io, so the send must
+			// be started in that thread too, the completion handler is still called in the
+			// thread of this session. the data is holded by the send event until the callback
+			// is called.
+			asio::post(this->socket_io_->strand(), make_allocator(this->wallocator_,
+			[this, this_ptr = this->derived().selfptr(), &data, callback = std::forward<Callback>(callback)]
+			() mutable
+			{
+				this->derived()._udp_send_to(this->remote_endpoint_, data, std::move(callback));
+			}));
+			return true;
 		}
 
 		template<class Data>
@@ -401,15 +421,112 @@ namespace asio2::detail
 				}
 				else
 				{
-					this->kcp_->_kcp_recv(this_ptr, data, this->buffer_ref_, condition);
+					if (this->batch_buffer_)
+						this->kcp_->_kcp_recv(this_ptr, data, *(this->batch_buffer_), condition);
+					else
+						this->kcp_->_kcp_recv(this_ptr, data, this->buffer_ref_, condition);
 				}
 			}
 		}
 
+		/**
+		 * @function : make the session own the first packet, because the session maybe started
+		 * in another thread, and the buffer of the first packet will be reused by the server.
+		 */
+		inline void _init_first(std::string_view first)
+		{
+			this->first_data_.assign(first.data(), first.size());
+			this->first_ = this->first_data_;
+		}
+
+		/**
+		 * @function : make the session own the kcp recv buffer, used when the session is running
+		 * in another thread than the server's socket, the datagrams are dispatched to the session
+		 * by _post_batch_recv, and the datagrams are sent in the thread of the socket_io.
+		 */
+		inline void _init_batch_recv(io_t& socket_io)
+		{
+			this->socket_io_ = std::addressof(socket_io);
+
+			this->batch_buffer_ = std::make_unique<asio2::buffer_wrap<asio2::linear_buffer>>(
+				this->buffer_ref_.pre_size(), this->buffer_ref_.max_size());
+		}
+
+		/**
+		 * @function : called by the server's thread, copy the datagram into the pending queue,
+		 * and post a event to handle the pending datagrams in the session's thread.
+		 */
+		template<typename MatchCondition>
+		inline void _post_batch_recv(std::shared_ptr<derived_t>& this_ptr, std::string_view data,
+			condition_wrap<MatchCondition>& condition)
+		{
+			bool idle = false;
+			{
+				std::lock_guard<std::mutex> guard(this->batch_mutex_);
+
+				// the session is too slow, drop the datagram like the socket receive queue is full.
+				if (this->batch_pending_.size() + data.size() > this->buffer_ref_.max_size())
+					return;
+
+				idle = this->batch_pending_.empty();
+
+				std::uint32_t size = static_cast<std::uint32_t>(data.size());
+
+				this->batch_pending_.append(reinterpret_cast<const char*>(std::addressof(size)), sizeof(size));
+				this->batch_pending_.append(data.data(), data.size());
+			}
+
+			// if the pending queue is not empty, a event has been posted already.
+			if (!idle)
+				return;
+
+			asio::post(this->io_.strand(), make_allocator(this->wallocator_,
+			[this, this_ptr, condition]() mutable
+			{
+				this->derived()._handle_batch_recv(this_ptr, condition);
+			}));
+		}
+
+		template<typename MatchCondition>
+		inline void _handle_batch_recv(std::shared_ptr<derived_t>& this_ptr,
+			condition_wrap<MatchCondition>& condition)
+		{
+			ASIO2_ASSERT(this->derived().io().strand().running_in_this_thread());
+
+			// the session is not started yet, the pending datagrams will be handled in _start_recv
+			if (!this->batch_started_)
+				return;
+
+			{
+				std::lock_guard<std::mutex> guard(this->batch_mutex_);
+
+				this->batch_processing_.swap(this->batch_pending_);
+			}
+
+			std::string_view pending = this->batch_processing_;
+
+			while (pending.size() >= sizeof(std::uint32_t))
+			{
+				std::uint32_t size = 0;
+
+				std::memcpy(std::addressof(size), pending.data(), sizeof(size));
+
+				pending.remove_prefix(sizeof(size));
+
+				this->derived()._handle_recv(error_code{}, pending.substr(0, size), this_ptr, condition);
+
+				pending.remove_prefix(size);
+			}
+
+			this->batch_processing_.clear();
+		}
+
 		template<typename MatchCondition>
 		inline void _fire_recv(std::shared_ptr<derived_t>& this_ptr, std::string_view data,
 			condition_wrap<MatchCondition>& condition)
 		{
+			detail::metrics_recv_scope ms(this->derived().io().metrics(), data.size());
+
 			this->listener_.notify(event_type::recv, this_ptr, data);
 
 			this->derived()._rdc_handle_recv(this_ptr, data, condition);
@@ -418,7 +535,7 @@ namespace asio2::detail
 		inline void _fire_handshake(std::shared_ptr<derived_t>& this_ptr, error_code ec)
 		{
 			// the _fire_handshake must be executed in the thread 0.
-			ASIO2_ASSERT(this->sessions().io().strand().running_in_this_thread());
+			ASIO2_ASSERT(this->sessions().io(this->derived().hash_key()).strand().running_in_this_thread());
 
 			this->listener_.notify(event_type::handshake, this_ptr, ec);
 		}
@@ -427,7 +544,7 @@ namespace asio2::detail
 		inline void _fire_connect(std::shared_ptr<derived_t>& this_ptr, condition_wrap<MatchCondition>& condition)
 		{
 			// the _fire_connect must be executed in the thread 0.
-			ASIO2_ASSERT(this->sessions().io().strand().running_in_this_thread());
+			ASIO2_ASSERT(this->sessions().io(this->derived().hash_key()).strand().running_in_this_thread());
 
 		#if defined(ASIO2_ENABLE_LOG)
 			ASIO2_ASSERT(this->is_disconnect_called_ == false);
@@ -441,7 +558,7 @@ namespace asio2::detail
 		inline void _fire_disconnect(std::shared_ptr<derived_t>& this_ptr)
 		{
 			// the _fire_disconnect must be executed in the thread 0.
-			ASIO2_ASSERT(this->sessions().io().strand().running_in_this_thread());
+			ASIO2_ASSERT(this->sessions().io(this->derived().hash_key()).strand().running_in_this_thread());
 
 		#if defined(ASIO2_ENABLE_LOG)
 			this->is_disconnect_called_ = true;
@@ -475,6 +592,24 @@ namespace asio2::detail
 		/// first recvd data packet
 		std::string_view                                  first_;
 
+		/// the data of the first packet, the first_ is point to it
+		std::string                                       first_data_;
+
+		/// the kcp recv buffer owned by this session, just used when the session is not running in
+		/// the thread of the server's socket
+		std::unique_ptr<asio2::buffer_wrap<asio2::linear_buffer>> batch_buffer_;
+
+		/// the datagrams dispatched by the server but not handled yet, just used when the session is
+		/// not running in the thread of the server's socket
+		std::mutex                                        batch_mutex_;
+		std::string                                       batch_pending_;
+		std::string                                       batch_processing_;
+		bool                                              batch_started_ = false;
+
+		/// the io of the server's socket, it's not null when this session is not running in the
+		/// thread of the server's socket, then the sends on the shared socket are posted to it
+		io_t                                            * socket_io_ = nullptr;
+
 	#if defined(ASIO2_ENABLE_LOG)
 		bool                                              is_disconnect_called_ = false;
 	#endif
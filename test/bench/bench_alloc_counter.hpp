@@ -0,0 +1,99 @@
+// Count the memory allocations of the global heap, the global operator new and operator delete
+// are replaced, "allocations" is the allocation count and "allocated" is the allocated bytes.
+//
+// this file defines the replacement functions, so it can only be included by one source file
+// of a program, it is included by the benches which count the memory allocations.
+
+#ifndef __ASIO2_BENCH_ALLOC_COUNTER_HPP__
+#define __ASIO2_BENCH_ALLOC_COUNTER_HPP__
+
+#include <cstddef>
+#include <cstdlib>
+#include <algorithm>
+#include <atomic>
+#include <new>
+
+static std::atomic<std::size_t> allocations{ 0 }, allocated{ 0 };
+
+// all the replaced operator new allocate by std::malloc and all the replaced operator delete
+// free by counted_free, it is not inlined, otherwise gcc sees a std::free of the memory which
+// is returned by operator new and warns with -Wmismatched-new-delete.
+#if defined(__GNUC__) || defined(__clang__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define BENCH_NOINLINE __declspec(noinline)
+#else
+#define BENCH_NOINLINE
+#endif
+
+static inline void* counted_alloc(std::size_t size, const std::nothrow_t&) noexcept
+{
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	allocated.fetch_add(size, std::memory_order_relaxed);
+	return std::malloc(size ? size : 1);
+}
+
+static inline void* counted_alloc(std::size_t size)
+{
+	if (void* p = counted_alloc(size, std::nothrow); p)
+		return p;
+	throw std::bad_alloc();
+}
+
+// the aligned memory is allocated by std::malloc too, the pointer returned by std::malloc is
+// stored in front of the aligned pointer, and it is freed by counted_free_aligned.
+static inline void* counted_alloc(std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept
+{
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	allocated.fetch_add(size, std::memory_order_relaxed);
+	std::size_t align = (std::max)(static_cast<std::size_t>(al), sizeof(void*));
+	void* raw = std::malloc(size + align + sizeof(void*));
+	if (!raw)
+		return nullptr;
+	std::size_t addr = (reinterpret_cast<std::size_t>(raw) + sizeof(void*) + align - 1) & ~(align - 1);
+	void* p = reinterpret_cast<void*>(addr);
+	static_cast<void**>(p)[-1] = raw;
+	return p;
+}
+
+static inline void* counted_alloc(std::size_t size, std::align_val_t al)
+{
+	if (void* p = counted_alloc(size, al, std::nothrow); p)
+		return p;
+	throw std::bad_alloc();
+}
+
+BENCH_NOINLINE static void counted_free(void* p) noexcept
+{
+	std::free(p);
+}
+
+BENCH_NOINLINE static void counted_free_aligned(void* p) noexcept
+{
+	if (p)
+		std::free(static_cast<void**>(p)[-1]);
+}
+
+void* operator new  (std::size_t size) { return counted_alloc(size); }
+void* operator new[](std::size_t size) { return counted_alloc(size); }
+void* operator new  (std::size_t size, const std::nothrow_t&) noexcept { return counted_alloc(size, std::nothrow); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return counted_alloc(size, std::nothrow); }
+void* operator new  (std::size_t size, std::align_val_t al) { return counted_alloc(size, al); }
+void* operator new[](std::size_t size, std::align_val_t al) { return counted_alloc(size, al); }
+void* operator new  (std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return counted_alloc(size, al, std::nothrow); }
+void* operator new[](std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return counted_alloc(size, al, std::nothrow); }
+
+void operator delete  (void* p) noexcept { counted_free(p); }
+void operator delete[](void* p) noexcept { counted_free(p); }
+void operator delete  (void* p, std::size_t) noexcept { counted_free(p); }
+void operator delete[](void* p, std::size_t) noexcept { counted_free(p); }
+void operator delete  (void* p, const std::nothrow_t&) noexcept { counted_free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { counted_free(p); }
+void operator delete  (void* p, std::align_val_t) noexcept { counted_free_aligned(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { counted_free_aligned(p); }
+void operator delete  (void* p, std::size_t, std::align_val_t) noexcept { counted_free_aligned(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { counted_free_aligned(p); }
+void operator delete  (void* p, std::align_val_t, const std::nothrow_t&) noexcept { counted_free_aligned(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { counted_free_aligned(p); }
+
+#endif // !__ASIO2_BENCH_ALLOC_COUNTER_HPP__
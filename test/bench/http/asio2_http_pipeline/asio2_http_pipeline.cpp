@@ -0,0 +1,153 @@
+// Compare the throughput of the pipelined requests when the pipelining of the http server is
+// disabled (pipeline_limit(1), the requests are handled one by one, each response is sent by
+// one write and the next request is read after the response is sent) and enabled (the requests
+// which are in the recv buffer already are handled together and the responses are sent by one
+// write).
+//
+// usage : asio2_http_pipeline [pipeline depth] [connection count] [seconds]
+// eg    : asio2_http_pipeline 16 4 5
+//
+// each connection is a blocking client thread which sends "pipeline depth" GET requests by one
+// write, and then reads all the responses, the body of each response is the target of the request,
+// so the order of the responses is checked too.
+//
+// the last run sends every fourth request to a handler which defers its response, the deferred
+// responses must be sent after the batched responses of the requests in front of them.
+
+#include <asio2/http/http_server.hpp>
+
+#include <cstdlib>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// read one response and return the body, or set the ec if failed.
+std::string read_response(asio::ip::tcp::socket& socket, std::string& buf, asio::error_code& ec)
+{
+	std::size_t n = asio::read_until(socket, asio::dynamic_buffer(buf), "\r\n\r\n", ec);
+	if (ec)
+		return {};
+
+	std::string_view head(buf.data(), n);
+
+	std::size_t pos = head.find("Content-Length: ");
+	if (pos == std::string_view::npos)
+	{
+		ec = asio::error::invalid_argument;
+		return {};
+	}
+
+	std::size_t length = std::strtoull(head.data() + pos + 16, nullptr, 10);
+
+	if (buf.size() < n + length)
+		asio::read(socket, asio::dynamic_buffer(buf), asio::transfer_exactly(n + length - buf.size()), ec);
+	if (ec)
+		return {};
+
+	std::string body = buf.substr(n, length);
+
+	buf.erase(0, n + length);
+
+	return body;
+}
+
+void run_once(const char* name, std::size_t limit, std::size_t depth, std::size_t conns, std::size_t seconds,
+	bool defer = false)
+{
+	asio2::http_server server;
+
+	server.pipeline_limit(limit);
+
+	server.bind<http::verb::get>("/api/*", [](http::request& req, http::response& rep)
+	{
+		rep.fill_text(std::string(req.target()));
+	});
+
+	// the guard is not kept, so the deferred response is sent when the session releases the guard.
+	server.bind<http::verb::get>("/defer/*", [](http::request& req, http::response& rep)
+	{
+		rep.defer();
+		rep.fill_text(std::string(req.target()));
+	});
+
+	server.start("127.0.0.1", 0);
+
+	std::atomic<std::size_t> requests{ 0 }, errors{ 0 };
+	std::atomic<bool> stop{ false };
+
+	std::vector<std::thread> threads;
+
+	for (std::size_t i = 0; i < conns; ++i)
+	{
+		threads.emplace_back([&]()
+		{
+			asio::io_context ioc;
+			asio::ip::tcp::socket socket(ioc);
+			asio::error_code ec;
+
+			socket.connect(asio::ip::tcp::endpoint(asio::ip::make_address("127.0.0.1"), server.listen_port()), ec);
+			if (ec) { errors++; return; }
+
+			std::string reqs, buf;
+
+			std::vector<std::string> targets;
+
+			for (std::size_t j = 0; j < depth; ++j)
+			{
+				targets.emplace_back((defer && j % 4 == 3 ? "/defer/" : "/api/") + std::to_string(j));
+
+				reqs += "GET ";
+				reqs += targets.back();
+				reqs += " HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+			}
+
+			while (!stop)
+			{
+				asio::write(socket, asio::buffer(reqs), ec);
+				if (ec) { errors++; return; }
+
+				for (std::size_t j = 0; j < depth; ++j)
+				{
+					std::string body = read_response(socket, buf, ec);
+					if (ec) { errors++; return; }
+
+					// the responses must be in the order of the requests.
+					if (body != targets[j]) { errors++; return; }
+				}
+
+				requests += depth;
+			}
+		});
+	}
+
+	auto t1 = std::chrono::steady_clock::now();
+	std::this_thread::sleep_for(std::chrono::seconds(seconds));
+	stop = true;
+	for (auto& t : threads)
+		t.join();
+	auto t2 = std::chrono::steady_clock::now();
+
+	server.stop();
+
+	double secs = double(std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count()) / 1000.0;
+
+	printf("%-24s : %12.0lf req/Sec, errors : %zu\n", name, double(requests) / secs, errors.load());
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t depth   = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 16);
+	std::size_t conns   = (argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4);
+	std::size_t seconds = (argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 5);
+
+	depth = (std::max)(depth, std::size_t(1));
+
+	printf("pipeline depth : %zu, connections : %zu, seconds : %zu\n", depth, conns, seconds);
+
+	run_once("pipeline_limit(1)" , 1    , depth, conns, seconds);
+	run_once("pipeline_limit(16)", 16   , depth, conns, seconds);
+	run_once("pipeline_limit(64)", 64   , depth, conns, seconds);
+	run_once("pipeline_limit(16) defer", 16, depth, conns, seconds, true);
+
+	return 0;
+}
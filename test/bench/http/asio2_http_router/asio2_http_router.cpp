@@ -0,0 +1,170 @@
+// Compare the route lookup of the http router (radix tree, with ":name" and "*" segments) with
+// the old way (a hash map for the static routes, and a linear scan with http::url_match for the
+// wildcard routes).
+//
+// usage : asio2_http_router [resource count] [lookup count]
+// eg    : asio2_http_router 200 1000000
+//
+// each resource has 3 routes, so there are 600 routes by default :
+// "/api/v1/resource{n}/list", "/api/v1/resource{n}/:id" and "/static/resource{n}/*"
+// the old way has no ":name" segment, so "/api/v1/resource{n}/*" is used instead of it.
+// the memory allocation count of the lookup is counted by the global operator new.
+
+#include <asio2/http/http_server.hpp>
+
+#include <cstdlib>
+#include <atomic>
+#include <new>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include "../../bench_alloc_counter.hpp"
+
+using optype = asio2::detail::http_router_t<asio2::http_session>::optype;
+
+class bench_request : public http::request
+{
+public:
+	explicit bench_request(std::string target)
+	{
+		this->method(http::verb::get);
+		this->target(target);
+		std::string_view t = this->target();
+		http::http_parser_ns::http_parser_parse_url(t.data(), t.size(), 0, &(this->url_parser_));
+	}
+};
+
+// expose the lookup of the http router
+class new_router : public asio2::detail::http_router_t<asio2::http_session>
+{
+public:
+	inline std::shared_ptr<optype>& find(http::request& req, http::response& rep)
+	{
+		return this->template _find<true>(req, rep);
+	}
+};
+
+// the old way, copied from the http router before the radix tree was used
+class old_router
+{
+public:
+	void bind(std::string name, std::shared_ptr<optype> op)
+	{
+		std::string uri = "3" + name;
+		if (name.back() == '*')
+			wildcard_routers_[std::move(uri)] = std::move(op);
+		else
+			strictly_routers_[std::move(uri)] = std::move(op);
+	}
+
+	std::shared_ptr<optype>& find(http::request& req, http::response&)
+	{
+		std::string_view path = req.path();
+		while (path.size() > std::size_t(1) && path.back() == '/')
+			path.remove_suffix(1);
+
+		std::string uri;
+		uri.reserve(1 + path.size());
+		uri += "3";
+		uri += path;
+
+		if (auto it = strictly_routers_.find(uri); it != strictly_routers_.end())
+			return it->second;
+
+		for (auto it = wildcard_routers_.rbegin(); it != wildcard_routers_.rend(); ++it)
+		{
+			auto& k = it->first;
+			if (!uri.empty() && !k.empty() && uri.front() == k.front() && uri.size() >= (k.size() - 2)
+				&& uri[k.size() - 3] == k[k.size() - 3] && http::url_match(k, uri))
+			{
+				return it->second;
+			}
+		}
+
+		return dummy_router_;
+	}
+
+	std::unordered_map<std::string, std::shared_ptr<optype>> strictly_routers_;
+	std::          map<std::string, std::shared_ptr<optype>> wildcard_routers_;
+	std::shared_ptr<optype>                                  dummy_router_;
+};
+
+template<class Router>
+void run_once(const char* name, Router& router, std::vector<std::unique_ptr<bench_request>>& reqs,
+	std::size_t lookups)
+{
+	http::response rep;
+	std::size_t found = 0;
+
+	allocations = 0;
+
+	auto t1 = std::chrono::steady_clock::now();
+
+	for (std::size_t i = 0; i < lookups; ++i)
+	{
+		if (router.find(*reqs[i % reqs.size()], rep))
+			++found;
+	}
+
+	auto t2 = std::chrono::steady_clock::now();
+
+	std::size_t allocs = allocations;
+
+	double ns = double(std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count());
+
+	printf("%-28s : %8.1lf ns/lookup %12.0lf lookups/Sec, found : %zu, allocations/lookup : %.2lf\n",
+		name, ns / double(lookups), double(lookups) / (ns / 1000000000.0), found,
+		double(allocs) / double(lookups));
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t count   = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200);
+	std::size_t lookups = (argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000);
+
+	std::shared_ptr<optype> op = std::make_shared<optype>([](auto&, auto&, auto&) {});
+
+	new_router router1;
+	old_router router2;
+
+	auto fn = [](http::request&, http::response&) {};
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		std::string n = std::to_string(i);
+
+		router1.bind<http::verb::get>("/api/v1/resource" + n + "/list", fn);
+		router1.bind<http::verb::get>("/api/v1/resource" + n + "/:id", fn);
+		router1.bind<http::verb::get>("/static/resource" + n + "/*", fn);
+
+		router2.bind("/api/v1/resource" + n + "/list", op);
+		router2.bind("/api/v1/resource" + n + "/*", op);
+		router2.bind("/static/resource" + n + "/*", op);
+	}
+
+	std::vector<std::unique_ptr<bench_request>> static_reqs, param_reqs, wildcard_reqs, missed_reqs;
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		std::string n = std::to_string((i * 7) % count);
+
+		static_reqs  .emplace_back(std::make_unique<bench_request>("/api/v1/resource" + n + "/list"));
+		param_reqs   .emplace_back(std::make_unique<bench_request>("/api/v1/resource" + n + "/12345?x=1"));
+		wildcard_reqs.emplace_back(std::make_unique<bench_request>("/static/resource" + n + "/js/main.js"));
+		missed_reqs  .emplace_back(std::make_unique<bench_request>("/missed/resource" + n + "/list"));
+	}
+
+	printf("routes : %zu, lookups : %zu\n", count * 3, lookups);
+
+	run_once("static   : radix tree", router1, static_reqs, lookups);
+	run_once("static   : map + url_match", router2, static_reqs, lookups);
+	run_once("param    : radix tree", router1, param_reqs, lookups);
+	run_once("param    : map + url_match", router2, param_reqs, lookups);
+	run_once("wildcard : radix tree", router1, wildcard_reqs, lookups);
+	run_once("wildcard : map + url_match", router2, wildcard_reqs, lookups);
+	run_once("missed   : radix tree", router1, missed_reqs, lookups);
+	run_once("missed   : map + url_match", router2, missed_reqs, lookups / 10);
+
+	return 0;
+}
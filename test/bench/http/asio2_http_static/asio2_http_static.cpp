@@ -0,0 +1,158 @@
+// Compare the throughput of the static file serving (http_server::bind_static, the small files are
+// served from the hot file cache, and the others are sent by sendfile on linux) with the current
+// way (a route which calls rep.fill_file, the file is read into a buffer by chunks and then sent).
+//
+// usage : asio2_http_static [file size] [connection count] [seconds]
+// eg    : asio2_http_static 4096 8 5
+//         asio2_http_static 8388608 4 5
+//
+// a file of the "file size" is created in the temp directory, each connection is a blocking client
+// thread which sends the GET request with keep-alive and reads the response and drops the body.
+
+#include <asio2/http/http_server.hpp>
+
+#include <cinttypes>
+#include <cstdlib>
+#include <atomic>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+// read one response and drop the body, return the body size, or -1 if failed.
+long long read_response(asio::ip::tcp::socket& socket, std::string& buf)
+{
+	asio::error_code ec;
+
+	std::size_t n = asio::read_until(socket, asio::dynamic_buffer(buf), "\r\n\r\n", ec);
+	if (ec)
+		return -1;
+
+	std::string_view head(buf.data(), n);
+
+	std::size_t pos = head.find("Content-Length: ");
+	if (pos == std::string_view::npos)
+		return -1;
+
+	std::size_t length = std::strtoull(head.data() + pos + 16, nullptr, 10);
+
+	buf.erase(0, n);
+
+	std::size_t body = (std::min)(length, buf.size());
+
+	buf.erase(0, body);
+
+	char drop[65536];
+
+	while (body < length)
+	{
+		std::size_t bytes = socket.read_some(asio::buffer(drop, (std::min)(sizeof(drop), length - body)), ec);
+		if (ec)
+			return -1;
+		body += bytes;
+	}
+
+	return static_cast<long long>(length);
+}
+
+void run_once(const char* name, asio2::http_server& server, std::string target, std::size_t conns, std::size_t seconds)
+{
+	std::atomic<std::size_t> requests{ 0 }, bytes{ 0 }, errors{ 0 };
+	std::atomic<bool> stop{ false };
+
+	std::vector<std::thread> threads;
+
+	for (std::size_t i = 0; i < conns; ++i)
+	{
+		threads.emplace_back([&]()
+		{
+			asio::io_context ioc;
+			asio::ip::tcp::socket socket(ioc);
+			asio::error_code ec;
+
+			socket.connect(asio::ip::tcp::endpoint(asio::ip::make_address("127.0.0.1"), server.listen_port()), ec);
+			if (ec) { errors++; return; }
+
+			std::string req = "GET " + target + " HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+			std::string buf;
+
+			while (!stop)
+			{
+				asio::write(socket, asio::buffer(req), ec);
+				if (ec) { errors++; return; }
+
+				long long n = read_response(socket, buf);
+				if (n < 0) { errors++; return; }
+
+				requests++;
+				bytes += std::size_t(n);
+			}
+		});
+	}
+
+	auto t1 = std::chrono::steady_clock::now();
+	std::this_thread::sleep_for(std::chrono::seconds(seconds));
+	stop = true;
+	for (auto& t : threads)
+		t.join();
+	auto t2 = std::chrono::steady_clock::now();
+
+	double secs = double(std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count()) / 1000.0;
+
+	printf("%-28s : %12.0lf req/Sec %10.1lf MB/Sec, errors : %zu\n", name,
+		double(requests) / secs, double(bytes) / secs / 1024.0 / 1024.0, errors.load());
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t size    = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4096);
+	std::size_t conns   = (argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 8);
+	std::size_t seconds = (argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 5);
+
+	std::filesystem::path dir = std::filesystem::temp_directory_path() / "asio2_http_static";
+	std::filesystem::create_directories(dir);
+
+	{
+		std::ofstream file(dir / "file.bin", std::ios::binary | std::ios::trunc);
+		std::string data(size, 'A');
+		file.write(data.data(), std::streamsize(data.size()));
+	}
+
+	printf("file size : %zu, connections : %zu, seconds : %zu\n", size, conns, seconds);
+
+	{
+		asio2::http_server server;
+		server.root_directory(dir);
+		server.bind<http::verb::get>("/file.bin", [](http::request&, http::response& rep)
+		{
+			rep.fill_file("file.bin");
+		});
+		server.start("127.0.0.1", 0);
+		run_once("route + fill_file", server, "/file.bin", conns, seconds);
+		server.stop();
+	}
+
+	{
+		asio2::http_server server;
+		server.bind_static("/", dir).static_cache(0, 0);
+		server.start("127.0.0.1", 0);
+		run_once("bind_static, no cache", server, "/file.bin", conns, seconds);
+		asio2::http_static_stats s = server.static_stats();
+		printf("%-28s   hits : %" PRIu64 ", misses : %" PRIu64 ", sendfiles : %" PRIu64 "\n", "", s.hits, s.misses, s.sendfiles);
+		server.stop();
+	}
+
+	{
+		asio2::http_server server;
+		server.bind_static("/", dir).static_cache(64 * 1024 * 1024, (std::max)(size, std::size_t(1)));
+		server.start("127.0.0.1", 0);
+		run_once("bind_static, hot file cache", server, "/file.bin", conns, seconds);
+		asio2::http_static_stats s = server.static_stats();
+		printf("%-28s   hits : %" PRIu64 ", misses : %" PRIu64 ", sendfiles : %" PRIu64 "\n", "", s.hits, s.misses, s.sendfiles);
+		server.stop();
+	}
+
+	std::error_code ec;
+	std::filesystem::remove_all(dir, ec);
+
+	return 0;
+}
@@ -0,0 +1,100 @@
+// Measure the decoding of the mqtt PUBLISH packet, for the mqtt 3.1.1 and the mqtt 5.0.
+//
+// usage : asio2_mqtt_decode [decode count] [payload size]
+// eg    : asio2_mqtt_decode 1000000 1024
+//
+// the packet is serialized once, and then it is decoded by mqtt::data_to_message in a loop, this is
+// the same as what the broker does for each recved packet. the "view" line decodes in a
+// mqtt::borrow_scope (see borrow_recv_data), the topic name and the payload of the decoded message
+// are borrowed from the packet, the "owned" line decodes as default, the decoded message copies
+// the topic name and the payload.
+// the memory allocation count and the allocated bytes are counted by the global operator new.
+
+#include <asio2/mqtt/mqtt_protocol_util.hpp>
+
+#include <cstdlib>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "../../bench_alloc_counter.hpp"
+
+template<asio2::mqtt::version V, class Publish, bool Owned>
+void decode(const char* name, std::vector<char>& packet, std::size_t count)
+{
+	std::size_t bytes = 0;
+
+	allocations = 0;
+	allocated = 0;
+
+	// the "view" line opts in to the borrowed decoding, the "owned" line decodes as default.
+	asio2::mqtt::borrow_scope borrow(!Owned);
+
+	auto t1 = std::chrono::steady_clock::now();
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		std::string_view data{ packet.data(), packet.size() };
+
+		asio2::mqtt::data_to_message<V>(data, [&bytes](auto& msg) mutable
+		{
+			using message_type = std::remove_reference_t<decltype(msg)>;
+
+			if constexpr (std::is_same_v<message_type, Publish>)
+			{
+				bytes += msg.topic_name().size() + msg.payload().size();
+			}
+		});
+	}
+
+	auto t2 = std::chrono::steady_clock::now();
+
+	std::size_t allocs = allocations, alloc_bytes = allocated;
+
+	double ns = double(std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count()) / double(count);
+
+	printf("%-8s : %10.1lf ns/op %12.0lf op/Sec %10.1lf MB/Sec, allocations/op : %.2lf, allocated bytes/op : %.1lf\n",
+		name, ns, 1000000000.0 / ns, double(packet.size()) * 1000000000.0 / ns / 1024.0 / 1024.0,
+		double(allocs) / double(count), double(alloc_bytes) / double(count));
+
+	if (bytes == 0)
+		printf("nothing is decoded\n");
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t count   = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000);
+	std::size_t payload = (argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1024);
+
+	printf("decode count : %zu, payload size : %zu\n", count, payload);
+
+	std::vector<char> v4packet, v5packet;
+
+	{
+		asio2::mqtt::v4::publish pub;
+		pub.qos(asio2::mqtt::qos_type::at_least_once);
+		pub.packet_id(1);
+		pub.topic_name("bench/decode/topic");
+		pub.payload(std::string(payload, 'x'));
+		pub.serialize(v4packet);
+	}
+
+	{
+		asio2::mqtt::v5::publish pub;
+		pub.qos(asio2::mqtt::qos_type::at_least_once);
+		pub.packet_id(1);
+		pub.topic_name("bench/decode/topic");
+		pub.payload(std::string(payload, 'x'));
+		pub.properties(asio2::mqtt::v5::message_expiry_interval(60));
+		pub.serialize(v5packet);
+	}
+
+	decode<asio2::mqtt::version::v4, asio2::mqtt::v4::publish, false>("v4 view" , v4packet, count);
+	decode<asio2::mqtt::version::v4, asio2::mqtt::v4::publish, true >("v4 owned", v4packet, count);
+	decode<asio2::mqtt::version::v5, asio2::mqtt::v5::publish, false>("v5 view" , v5packet, count);
+	decode<asio2::mqtt::version::v5, asio2::mqtt::v5::publish, true >("v5 owned", v5packet, count);
+
+	return 0;
+}
@@ -0,0 +1,161 @@
+// Measure the publish fan-out of the mqtt broker, one publisher sends the messages to a topic which is
+// subscribed by N subscribers, the broker forwards each message to all the subscribers.
+//
+// usage : asio2_mqtt_fanout [subscriber count] [message count] [payload size]
+// eg    : asio2_mqtt_fanout 1000 100 1024
+//
+// the publisher and the subscribers are raw tcp sockets with the mqtt 3.1.1 packets, the subscribers
+// are read by one thread and only the bytes are counted, the time is from the first publish is sent
+// to the last byte is recved by all the subscribers. the memory allocation count and the allocated
+// bytes (of the whole process, most of them are in the broker) are counted by the global operator new,
+// if the payload is copied for each subscriber, the allocated bytes per delivery is greater than
+// the payload size.
+
+#include <asio2/mqtt/mqtt_server.hpp>
+
+#include <cstdlib>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "../../bench_alloc_counter.hpp"
+
+template<class Message>
+void send_packet(asio::ip::tcp::socket& socket, Message&& msg)
+{
+	std::vector<char> data;
+	msg.serialize(data);
+	asio::write(socket, asio::buffer(data));
+}
+
+void connect_client(asio::ip::tcp::socket& socket, unsigned short port, std::string client_id)
+{
+	socket.connect(asio::ip::tcp::endpoint(asio::ip::make_address("127.0.0.1"), port));
+	socket.set_option(asio::ip::tcp::no_delay(true));
+
+	asio2::mqtt::v4::connect conn;
+	conn.client_id(std::move(client_id));
+	conn.clean_session(true);
+	conn.keep_alive(600);
+	send_packet(socket, conn);
+
+	// connack
+	char ack[4];
+	asio::read(socket, asio::buffer(ack));
+}
+
+struct subscriber
+{
+	subscriber(asio::io_context& ioc) : socket(ioc) {}
+
+	asio::ip::tcp::socket socket;
+	std::array<char, 65536> buffer;
+};
+
+void post_read(std::shared_ptr<subscriber> sub, std::atomic<std::size_t>& recved)
+{
+	sub->socket.async_read_some(asio::buffer(sub->buffer), [sub, &recved](const asio::error_code& ec, std::size_t n)
+	{
+		if (ec)
+			return;
+		recved.fetch_add(n, std::memory_order_relaxed);
+		post_read(std::move(sub), recved);
+	});
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t subs     = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000);
+	std::size_t messages = (argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 100);
+	std::size_t payload  = (argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1024);
+
+	printf("subscribers : %zu, messages : %zu, payload size : %zu\n", subs, messages, payload);
+
+	asio2::mqtt_server server;
+
+	server.start("127.0.0.1", 0);
+
+	unsigned short port = server.listen_port();
+
+	asio::io_context ioc;
+
+	std::vector<std::shared_ptr<subscriber>> subscribers;
+
+	for (std::size_t i = 0; i < subs; ++i)
+	{
+		std::shared_ptr<subscriber> sub = std::make_shared<subscriber>(ioc);
+
+		connect_client(sub->socket, port, "sub" + std::to_string(i));
+
+		asio2::mqtt::v4::subscribe msg(std::uint16_t(1));
+		msg.add_subscriptions(asio2::mqtt::subscription("bench/fanout", asio2::mqtt::qos_type::at_most_once));
+		send_packet(sub->socket, msg);
+
+		// suback
+		char ack[5];
+		asio::read(sub->socket, asio::buffer(ack));
+
+		subscribers.emplace_back(std::move(sub));
+	}
+
+	asio2::mqtt::v4::publish pub;
+	pub.qos(asio2::mqtt::qos_type::at_most_once);
+	pub.topic_name("bench/fanout");
+	pub.payload(std::string(payload, 'x'));
+
+	std::vector<char> packet;
+	pub.serialize(packet);
+
+	std::size_t expected = packet.size() * messages * subs;
+
+	std::atomic<std::size_t> recved{ 0 };
+
+	for (auto& sub : subscribers)
+		post_read(sub, recved);
+
+	std::thread reader([&ioc]() { ioc.run(); });
+
+	asio::io_context pioc;
+	asio::ip::tcp::socket publisher(pioc);
+	connect_client(publisher, port, "publisher");
+
+	// wait for all the subscribers and the publisher are ready.
+	std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+	allocations = 0;
+	allocated = 0;
+
+	auto t1 = std::chrono::steady_clock::now();
+
+	for (std::size_t i = 0; i < messages; ++i)
+	{
+		asio::write(publisher, asio::buffer(packet));
+	}
+
+	while (recved < expected && std::chrono::steady_clock::now() - t1 < std::chrono::seconds(60))
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	auto t2 = std::chrono::steady_clock::now();
+
+	std::size_t allocs = allocations, bytes = allocated;
+
+	double secs = double(std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count()) / 1000000.0;
+
+	double deliveries = double(messages * subs);
+
+	printf("deliveries : %12.0lf /Sec %10.1lf MB/Sec, allocations/delivery : %.2lf, allocated bytes/delivery : %.1lf%s\n",
+		deliveries / secs, double(recved) / secs / 1024.0 / 1024.0,
+		double(allocs) / deliveries, double(bytes) / deliveries,
+		recved < expected ? " (timeout)" : "");
+
+	publisher.close();
+	ioc.stop();
+	reader.join();
+	server.stop();
+
+	return 0;
+}
@@ -0,0 +1,170 @@
+// Compare the rpc encode and decode of the serializer which writes the fields into the pooled send
+// buffer directly (rpc_serializer::take) with the old way (the virtual std::streambuf::xsputn call
+// for each field, and the serialized string is copied when it is passed to async_send).
+//
+// usage : asio2_rpc_codec [string size] [loop count]
+// eg    : asio2_rpc_codec 128 1000000
+//
+// the request is : rpc_header + int + std::string + double + std::vector<int>(8), it is about
+// 200 bytes by default. the memory allocation count is counted by the global operator new.
+
+#include <asio2/rpc/rpc_server.hpp>
+
+#include <cstdlib>
+#include <atomic>
+#include <new>
+#include <vector>
+
+#include "../../bench_alloc_counter.hpp"
+
+// the old way, the archive writes each field through the std::ostream's streambuf.
+class old_serializer
+{
+public:
+	old_serializer() : ostream_(&obuffer_), oarchive_(ostream_) {}
+
+	template<class ...Args>
+	inline old_serializer& save(const Args&... args)
+	{
+		obuffer_.clear();
+		oarchive_.save_endian();
+		((oarchive_ << args), ...);
+		return (*this);
+	}
+
+	inline const std::string& str() const { return obuffer_.str(); }
+
+	asio2::detail::ostrbuf            obuffer_;
+	std::ostream                      ostream_;
+	cereal::RPCPortableBinaryOutputArchive oarchive_;
+};
+
+// the old way, the archive reads each field through the std::istream's streambuf.
+class old_deserializer
+{
+public:
+	old_deserializer() : istream_(&ibuffer_), iarchive_(istream_) {}
+
+	template<class ...Args>
+	inline old_deserializer& load(std::string_view s, Args&... args)
+	{
+		ibuffer_.setbuf(s);
+		iarchive_.load_endian();
+		((iarchive_ >> args), ...);
+		return (*this);
+	}
+
+	asio2::detail::istrbuf            ibuffer_;
+	std::istream                      istream_;
+	cereal::RPCPortableBinaryInputArchive iarchive_;
+};
+
+void print(const char* name, std::chrono::steady_clock::duration d, std::size_t loops, std::size_t allocs,
+	std::size_t bytes)
+{
+	double ns = double(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+
+	printf("%-36s : %8.1lf ns/op %12.0lf ops/Sec, bytes : %zu, allocations/op : %.2lf\n",
+		name, ns / double(loops), double(loops) / (ns / 1000000000.0), bytes,
+		double(allocs) / double(loops));
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t size  = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 128);
+	std::size_t loops = (argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000);
+
+	asio2::detail::rpc_header head(asio2::detail::rpc_type_req, 1, "echo");
+
+	int              a = 12345;
+	std::string      s(size, 'A');
+	double           d = 3.1415926;
+	std::vector<int> v{ 1, 2, 3, 4, 5, 6, 7, 8 };
+
+	std::size_t bytes = 0;
+
+	// encode, and hand the data over to the send queue, the send queue holds the data until the
+	// sending is completed, so the data is destroyed after the next encode.
+	{
+		old_serializer sr;
+		std::string sending;
+
+		allocations = 0;
+		auto t1 = std::chrono::steady_clock::now();
+		for (std::size_t i = 0; i < loops; ++i)
+		{
+			head.id(i);
+			// async_send(sr.str()) copies the string into the send queue.
+			sending = std::string(sr.save(head, a, s, d, v).str());
+		}
+		auto t2 = std::chrono::steady_clock::now();
+
+		bytes = sending.size();
+		print("encode : streambuf + copy", t2 - t1, loops, allocations, bytes);
+	}
+
+	{
+		asio2::detail::rpc_serializer sr;
+		asio2::detail::pooled_buffer sending;
+
+		allocations = 0;
+		auto t1 = std::chrono::steady_clock::now();
+		for (std::size_t i = 0; i < loops; ++i)
+		{
+			head.id(i);
+			sr.reset();
+			sr.save(head, a, s, d, v);
+			// async_send(sr.take()) moves the pooled buffer into the send queue.
+			sending = sr.take();
+		}
+		auto t2 = std::chrono::steady_clock::now();
+
+		bytes = sending.size();
+		print("encode : direct + pooled buffer", t2 - t1, loops, allocations, bytes);
+	}
+
+	asio2::detail::rpc_serializer sr;
+	sr.reset();
+	sr.save(head, a, s, d, v);
+	std::string data = sr.str();
+
+	asio2::detail::rpc_header h;
+	int              a2 = 0;
+	std::string      s2;
+	double           d2 = 0;
+	std::vector<int> v2;
+
+	{
+		old_deserializer dr;
+
+		allocations = 0;
+		auto t1 = std::chrono::steady_clock::now();
+		for (std::size_t i = 0; i < loops; ++i)
+		{
+			dr.load(data, h, a2, s2, d2, v2);
+		}
+		auto t2 = std::chrono::steady_clock::now();
+
+		print("decode : streambuf", t2 - t1, loops, allocations, data.size());
+	}
+
+	{
+		asio2::detail::rpc_deserializer dr;
+
+		allocations = 0;
+		auto t1 = std::chrono::steady_clock::now();
+		for (std::size_t i = 0; i < loops; ++i)
+		{
+			dr.reset(data);
+			dr.load(h, a2, s2, d2, v2);
+		}
+		auto t2 = std::chrono::steady_clock::now();
+
+		print("decode : direct", t2 - t1, loops, allocations, data.size());
+	}
+
+	if (a2 != a || s2 != s || d2 != d || v2 != v || h.name() != "echo")
+		printf("decode failed\n");
+
+	return 0;
+}
@@ -0,0 +1,120 @@
+// Compare the pending request table of the rpc (rpc_pending_table with the rpc_pending_callback,
+// the callback type used by rpc_call_cp) with the old std::map of std::function.
+//
+// usage : asio2_rpc_pending [in flight count] [operation count]
+// eg    : asio2_rpc_pending 100000 10000000
+//
+// the table is filled with the in flight requests first, then each operation inserts a new request
+// and completes a random in flight request (find + call + erase), so the response order is random.
+// the callbacks capture the same things as the callback made by rpc_call_cp::async_call : the
+// client reference, the request id, the timer shared_ptr and the user callback.
+// the memory allocation count is counted by the global operator new.
+
+#include <asio2/rpc/rpc_client.hpp>
+
+#include <cstdlib>
+#include <atomic>
+#include <new>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "../../bench_alloc_counter.hpp"
+
+using id_type  = asio2::detail::rpc_header::id_type;
+using callback = std::function<void(asio::error_code, std::string_view)>;
+
+// the callback of the async_call is made by this, see rpc_call_cp::async_call
+inline auto make_callback(asio2::rpc_client& client, id_type id, const std::shared_ptr<int>& timer,
+	std::size_t& called)
+{
+	return [&client, id, timer, cb = [&called](asio::error_code, std::string_view) { ++called; }]
+	(asio::error_code ec, std::string_view data) mutable
+	{
+		asio2::detail::ignore_unused(client, id, timer);
+
+		cb(ec, data);
+	};
+}
+
+// the old way
+class map_table
+{
+public:
+	inline void emplace(id_type id, callback fn) { reqs_.emplace(id, std::move(fn)); }
+
+	inline void invoke(id_type id, asio::error_code ec, std::string_view data)
+	{
+		auto iter = reqs_.find(id);
+		if (iter != reqs_.end())
+		{
+			iter->second(ec, data);
+			reqs_.erase(iter);
+		}
+	}
+
+	std::map<id_type, callback> reqs_;
+};
+
+using slab_table = asio2::detail::rpc_pending_table<id_type, asio2::detail::rpc_pending_callback>;
+
+template<class Table>
+void run_once(const char* name, std::size_t inflight, std::size_t ops)
+{
+	Table table;
+	std::size_t called = 0;
+	id_type next = 1;
+
+	asio2::rpc_client client;
+	std::shared_ptr<int> timer = std::make_shared<int>(0);
+
+	std::vector<id_type> ids;
+	ids.reserve(inflight);
+
+	for (std::size_t i = 0; i < inflight; ++i)
+	{
+		ids.emplace_back(next);
+		table.emplace(next, make_callback(client, next, timer, called));
+		++next;
+	}
+
+	std::mt19937_64 rng(12345);
+
+	allocations = 0;
+
+	auto t1 = std::chrono::steady_clock::now();
+
+	for (std::size_t i = 0; i < ops; ++i)
+	{
+		table.emplace(next, make_callback(client, next, timer, called));
+
+		std::size_t r = static_cast<std::size_t>(rng() % inflight);
+		table.invoke(ids[r], asio::error_code{}, std::string_view{});
+		ids[r] = next++;
+	}
+
+	auto t2 = std::chrono::steady_clock::now();
+
+	std::size_t allocs = allocations;
+
+	double ns = double(std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count());
+
+	printf("%-20s : %8.1lf ns/op %12.0lf ops/Sec, called : %zu, allocations/op : %.2lf\n",
+		name, ns / double(ops), double(ops) / (ns / 1000000000.0), called,
+		double(allocs) / double(ops));
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t inflight = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000);
+	std::size_t ops      = (argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10000000);
+
+	inflight = (std::max)(inflight, std::size_t(1));
+
+	printf("in flight : %zu, operations : %zu\n", inflight, ops);
+
+	run_once<map_table >("std::map"           , inflight, ops);
+	run_once<slab_table>("rpc_pending_table"  , inflight, ops);
+
+	return 0;
+}
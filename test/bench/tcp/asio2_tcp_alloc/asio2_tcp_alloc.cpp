@@ -0,0 +1,117 @@
+// Count the memory allocations of the global heap per echoed message, the server echoes the
+// recved data by session_ptr->async_send(data), the client sends the next message after the
+// echo of the previous message is recved.
+//
+// usage : asio2_tcp_alloc [message count] [message size]
+// eg    : asio2_tcp_alloc 200000 64
+//         asio2_tcp_alloc_heap 200000 64
+//
+// the asio2_tcp_alloc_heap is built with ASIO2_DISABLE_SLAB_ALLOCATOR, the handlers, the event
+// queue nodes and the persisted send data are allocated from the global heap directly, so the
+// difference of the two programs is what the slab cache saves. the first 1000 messages are not
+// counted, they are used to warm up the caches. the allocation count is for both the server and
+// the client, each round trip is two sends and two recvs.
+
+#include <asio2/tcp/tcp_server.hpp>
+#include <asio2/tcp/tcp_client.hpp>
+
+#include <cstdlib>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <new>
+#include <string>
+
+#include "../../bench_alloc_counter.hpp"
+
+int main(int argc, char* argv[])
+{
+	std::size_t count = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000);
+	std::size_t size  = (argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 64);
+	std::size_t warm  = 1000;
+
+#if defined(ASIO2_DISABLE_SLAB_ALLOCATOR)
+	printf("slab cache : disabled, message count : %zu, message size : %zu\n", count, size);
+#else
+	printf("slab cache : enabled, message count : %zu, message size : %zu\n", count, size);
+#endif
+
+	asio2::tcp_server server;
+
+	server.bind_recv([](std::shared_ptr<asio2::tcp_session>& session_ptr, std::string_view data)
+	{
+		session_ptr->async_send(data);
+	});
+
+	server.start("127.0.0.1", 18091);
+
+	asio2::tcp_client client;
+
+	std::string msg(size, 'x');
+
+	std::size_t recvd = 0, echoed = 0;
+
+	std::size_t allocs = 0, alloc_bytes = 0;
+
+	std::chrono::steady_clock::time_point t1;
+
+	asio2::slab_stats stats1;
+
+	std::promise<void> promise;
+
+	client.bind_connect([&](asio::error_code ec)
+	{
+		if (!ec)
+			client.async_send(std::string_view(msg));
+	}).bind_recv([&](std::string_view data)
+	{
+		recvd += data.size();
+
+		if (recvd < size)
+			return;
+
+		recvd = 0;
+
+		if (++echoed == warm)
+		{
+			t1 = std::chrono::steady_clock::now();
+			stats1 = asio2::slab_statistics();
+			allocs = allocations;
+			alloc_bytes = allocated;
+		}
+		else if (echoed == warm + count)
+		{
+			allocs = allocations - allocs;
+			alloc_bytes = allocated - alloc_bytes;
+			promise.set_value();
+			return;
+		}
+
+		client.async_send(std::string_view(msg));
+	});
+
+	client.start("127.0.0.1", 18091);
+
+	promise.get_future().wait();
+
+	auto t2 = std::chrono::steady_clock::now();
+
+	asio2::slab_stats stats2 = asio2::slab_statistics();
+
+	double ns = double(std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count()) / double(count);
+
+	printf("round trip : %10.1lf ns %12.0lf msg/Sec, allocations/msg : %.2lf, allocated bytes/msg : %.1lf\n",
+		ns, 1000000000.0 / ns, double(allocs) / double(count), double(alloc_bytes) / double(count));
+
+	printf("slab cache : hits/msg : %.2lf, misses/msg : %.2lf, large/msg : %.2lf, released/msg : %.2lf, cached bytes : %llu\n",
+		double(stats2.hits     - stats1.hits    ) / double(count),
+		double(stats2.misses   - stats1.misses  ) / double(count),
+		double(stats2.large    - stats1.large   ) / double(count),
+		double(stats2.released - stats1.released) / double(count),
+		static_cast<unsigned long long>(stats2.cached_bytes));
+
+	client.stop();
+	server.stop();
+
+	return 0;
+}
@@ -0,0 +1,164 @@
+// Compare the per session copy broadcast : server.async_send(msg)
+// with the shared payload broadcast       : server.broadcast(msg)
+//
+// usage : asio2_tcp_broadcast [session count] [message size] [message count]
+// eg    : asio2_tcp_broadcast 1000 4096 100
+//         asio2_tcp_broadcast 10000 4096 20
+//         asio2_tcp_broadcast 50000 4096 5
+//
+// every session is a real socket, so the "open files" limit must be greater than
+// session count * 2 + some, eg : ulimit -n 120000
+
+#include <asio2/tcp/tcp_server.hpp>
+
+#include <cstdlib>
+#include <memory>
+#include <vector>
+#include <thread>
+
+class bench_client
+{
+public:
+	bench_client(asio::io_context& ioc, std::atomic<std::size_t>& recvd)
+		: socket_(ioc), recvd_(recvd)
+	{
+	}
+
+	void start(const asio::ip::tcp::endpoint& endpoint,
+		std::atomic<std::size_t>& connected, std::atomic<std::size_t>& failed)
+	{
+		socket_.async_connect(endpoint, [this, &connected, &failed](const asio::error_code& ec)
+		{
+			if (ec)
+			{
+				if (failed++ == 0)
+					printf("connect failure : %s\n", ec.message().c_str());
+				return;
+			}
+			connected++;
+			do_read();
+		});
+	}
+
+	void do_read()
+	{
+		socket_.async_read_some(asio::buffer(buffer_), [this](const asio::error_code& ec, std::size_t n)
+		{
+			if (ec)
+				return;
+			recvd_ += n;
+			do_read();
+		});
+	}
+
+	void close()
+	{
+		asio::error_code ec;
+		socket_.close(ec);
+	}
+
+protected:
+	asio::ip::tcp::socket      socket_;
+	std::atomic<std::size_t> & recvd_;
+	std::array<char, 16 * 1024> buffer_;
+};
+
+template<class Fun>
+double run_once(asio2::tcp_server& server, std::atomic<std::size_t>& recvd,
+	std::size_t total, std::size_t msg_count, Fun&& send)
+{
+	recvd = 0;
+
+	auto t1 = std::chrono::steady_clock::now();
+
+	for (std::size_t i = 0; i < msg_count; ++i)
+	{
+		send(server);
+	}
+
+	while (recvd < total)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	auto t2 = std::chrono::steady_clock::now();
+
+	return double(std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count()) / 1000.0;
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t session_count = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000);
+	std::size_t msg_size      = (argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4096);
+	std::size_t msg_count     = (argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 100);
+
+	asio2::tcp_server server;
+
+	server.start("127.0.0.1", 18089);
+
+	asio::io_context ioc;
+	auto guard = asio::make_work_guard(ioc);
+	std::thread client_thread([&ioc]() { ioc.run(); });
+
+	std::atomic<std::size_t> recvd{ 0 }, connected{ 0 }, failed{ 0 };
+	std::vector<std::unique_ptr<bench_client>> clients;
+
+	asio::ip::tcp::endpoint endpoint(asio::ip::make_address("127.0.0.1"), 18089);
+
+	for (std::size_t i = 0; i < session_count; ++i)
+	{
+		clients.emplace_back(std::make_unique<bench_client>(ioc, recvd));
+	}
+
+	asio::post(ioc, [&]()
+	{
+		for (auto& c : clients)
+			c->start(endpoint, connected, failed);
+	});
+
+	while (server.session_count() < session_count)
+	{
+		if (connected + failed == session_count && failed > 0)
+		{
+			printf("%zu connections failed, check the \"open files\" limit.\n", failed.load());
+			std::exit(1);
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+
+	printf("sessions : %zu, message size : %zu, message count : %zu\n",
+		server.session_count(), msg_size, msg_count);
+
+	std::string msg(msg_size, 'x');
+	std::size_t total = session_count * msg_size * msg_count;
+
+	double copy_ms = run_once(server, recvd, total, msg_count, [&msg](asio2::tcp_server& s)
+	{
+		s.async_send(msg);
+	});
+
+	double shared_ms = run_once(server, recvd, total, msg_count, [&msg](asio2::tcp_server& s)
+	{
+		s.broadcast(asio2::shared_buffer(msg));
+	});
+
+	double mb = double(total) / double(1024) / double(1024);
+
+	printf("async_send (copy per session) : %10.1lf ms  %10.1lf MByte/Sec  %12zu bytes copied\n",
+		copy_ms, mb / (copy_ms / 1000.0), total);
+	printf("broadcast  (shared payload)   : %10.1lf ms  %10.1lf MByte/Sec  %12zu bytes copied\n",
+		shared_ms, mb / (shared_ms / 1000.0), msg_size * msg_count);
+
+	asio::post(ioc, [&]()
+	{
+		for (auto& c : clients)
+			c->close();
+	});
+
+	server.stop();
+
+	guard.reset();
+	client_thread.join();
+
+	return 0;
+}
@@ -0,0 +1,102 @@
+// Compare the connect rate of the single acceptor mode : server.start(host, port)
+// with the SO_REUSEPORT multi acceptor mode             : server.start(host, port, asio2::reuse_port(N))
+//
+// usage : asio2_tcp_connect_rate [server threads] [client threads] [seconds]
+// eg    : asio2_tcp_connect_rate 4 8 5
+//
+// the clients connect to the server and close the connection immediately in a loop,
+// the local ports are consumed quickly and stay in TIME_WAIT state, so don't run the
+// bench for a long time.
+
+#include <asio2/tcp/tcp_server.hpp>
+
+#include <cstdlib>
+#include <vector>
+#include <thread>
+
+template<class... Args>
+double run_once(std::size_t server_threads, std::size_t client_threads, std::size_t seconds,
+	unsigned short port, Args&&... args)
+{
+	asio2::tcp_server server(1024, asio2::detail::max_buffer_size, server_threads);
+
+	std::atomic<std::size_t> accepted{ 0 };
+
+	server.bind_accept([&accepted](std::shared_ptr<asio2::tcp_session>&)
+	{
+		accepted++;
+	});
+
+	if (!server.start("127.0.0.1", port, std::forward<Args>(args)...))
+	{
+		printf("start failure : %s\n", asio2::last_error_msg().c_str());
+		return 0.0;
+	}
+
+	std::atomic<bool> stop_flag{ false };
+	std::vector<std::thread> threads;
+
+	asio::ip::tcp::endpoint endpoint(asio::ip::make_address("127.0.0.1"), port);
+
+	for (std::size_t i = 0; i < client_threads; ++i)
+	{
+		threads.emplace_back([&stop_flag, endpoint]()
+		{
+			asio::io_context ioc;
+			while (!stop_flag)
+			{
+				asio::ip::tcp::socket socket(ioc);
+				asio::error_code ec;
+				socket.connect(endpoint, ec);
+				if (!ec)
+				{
+					// avoid the TIME_WAIT state on the client side, use RST to close the socket.
+					socket.set_option(asio::socket_base::linger(true, 0), ec);
+				}
+				socket.close(ec);
+			}
+		});
+	}
+
+	auto t1 = std::chrono::steady_clock::now();
+
+	std::this_thread::sleep_for(std::chrono::seconds(seconds));
+
+	std::size_t count = accepted.load();
+
+	auto t2 = std::chrono::steady_clock::now();
+
+	stop_flag = true;
+
+	for (auto& t : threads)
+	{
+		t.join();
+	}
+
+	server.stop();
+
+	double ms = double(std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count());
+
+	return double(count) / (ms / 1000.0);
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t server_threads = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4);
+	std::size_t client_threads = (argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 8);
+	std::size_t seconds        = (argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 5);
+
+	printf("server threads : %zu, client threads : %zu, seconds : %zu\n",
+		server_threads, client_threads, seconds);
+
+	double single = run_once(server_threads, client_threads, seconds, 18090);
+
+	printf("single acceptor               : %10.0lf connections/Sec\n", single);
+
+	double multi = run_once(server_threads, client_threads, seconds, 18091,
+		asio2::reuse_port(server_threads));
+
+	printf("reuse_port(%2zu) acceptors      : %10.0lf connections/Sec\n", server_threads, multi);
+
+	return 0;
+}
@@ -0,0 +1,132 @@
+// Compare the multi producer send into the same session with the default event queue (each
+// async_send posts a task into the io strand) and with the lock free event queue (the async_send
+// pushes the data into a mpsc queue, and the io strand drains the queue in batches) :
+// session_ptr->mpsc_event_queue(true)
+//
+// usage : asio2_tcp_mpsc_send [producer threads] [messages per producer] [message size]
+// eg    : asio2_tcp_mpsc_send 4 200000 64
+//         asio2_tcp_mpsc_send 8 100000 16
+//
+// the producers call session_ptr->async_send(msg) at the same time, the elapsed time is measured
+// from the producers start to the peer received all the bytes.
+
+#include <asio2/tcp/tcp_server.hpp>
+
+#include <cstdlib>
+#include <memory>
+#include <vector>
+#include <thread>
+#include <future>
+
+struct result
+{
+	double submit_ms = 0;
+	double total_ms  = 0;
+};
+
+result run_once(bool mpsc, std::size_t producers, std::size_t msg_count, std::size_t msg_size)
+{
+	asio2::tcp_server server;
+
+	std::promise<std::shared_ptr<asio2::tcp_session>> promise;
+
+	server.bind_accept([mpsc](std::shared_ptr<asio2::tcp_session>& session_ptr)
+	{
+		session_ptr->mpsc_event_queue(mpsc);
+	}).bind_connect([&promise](auto& session_ptr)
+	{
+		promise.set_value(session_ptr);
+	});
+
+	server.start("127.0.0.1", 18090);
+
+	asio::io_context ioc;
+	asio::ip::tcp::socket socket(ioc);
+	socket.connect(asio::ip::tcp::endpoint(asio::ip::make_address("127.0.0.1"), 18090));
+
+	std::shared_ptr<asio2::tcp_session> session_ptr = promise.get_future().get();
+
+	std::size_t total = producers * msg_count * msg_size;
+
+	std::thread reader([&socket, total]()
+	{
+		std::size_t recvd = 0;
+		std::array<char, 64 * 1024> buffer;
+		asio::error_code ec;
+		while (recvd < total && !ec)
+		{
+			recvd += socket.read_some(asio::buffer(buffer), ec);
+		}
+	});
+
+	std::string msg(msg_size, 'x');
+
+	std::atomic<std::size_t> ready{ 0 };
+	std::atomic<bool> go{ false };
+	std::vector<std::thread> threads;
+
+	for (std::size_t i = 0; i < producers; ++i)
+	{
+		threads.emplace_back([&]()
+		{
+			ready++;
+			while (!go) { std::this_thread::yield(); }
+			for (std::size_t n = 0; n < msg_count; ++n)
+			{
+				session_ptr->async_send(msg);
+			}
+		});
+	}
+
+	while (ready < producers) { std::this_thread::yield(); }
+
+	auto t1 = std::chrono::steady_clock::now();
+
+	go = true;
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	auto t2 = std::chrono::steady_clock::now();
+
+	reader.join();
+
+	auto t3 = std::chrono::steady_clock::now();
+
+	session_ptr.reset();
+
+	asio::error_code ec;
+	socket.close(ec);
+
+	server.stop();
+
+	result r;
+	r.submit_ms = double(std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count()) / 1000.0;
+	r.total_ms  = double(std::chrono::duration_cast<std::chrono::microseconds>(t3 - t1).count()) / 1000.0;
+	return r;
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t producers = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4);
+	std::size_t msg_count = (argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 200000);
+	std::size_t msg_size  = (argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 64);
+
+	printf("producers : %zu, messages per producer : %zu, message size : %zu\n",
+		producers, msg_count, msg_size);
+
+	double count = double(producers * msg_count);
+
+	for (bool mpsc : { false, true })
+	{
+		result r = run_once(mpsc, producers, msg_count, msg_size);
+
+		printf("%-25s : submit %10.1lf ms %12.0lf sends/Sec, total %10.1lf ms %12.0lf msgs/Sec\n",
+			mpsc ? "lock free event queue" : "strand post per send",
+			r.submit_ms, count / (r.submit_ms / 1000.0), r.total_ms, count / (r.total_ms / 1000.0));
+	}
+
+	return 0;
+}
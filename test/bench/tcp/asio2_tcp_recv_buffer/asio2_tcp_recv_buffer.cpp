@@ -0,0 +1,119 @@
+// Measure the memory which is held by the recv buffers of the tcp sessions, after a burst of the
+// large messages and after the sessions go idle, with and without server.recv_buffer_release(true)
+//
+// usage : asio2_tcp_recv_buffer [session count] [burst message size] [small message count]
+// eg    : asio2_tcp_recv_buffer 200 1048576 20
+//
+// the server is started with the '\n' delimiter, so the large message is accumulated in the recv
+// buffer of the session until the delimiter is recved. each client sends one large message, then
+// some small messages, then nothing. the memory is got from server.recv_buffer_stats(), the
+// "bytes" is the capacity of the recv buffers which are held by the sessions now.
+
+#include <asio2/tcp/tcp_server.hpp>
+#include <asio2/tcp/tcp_client.hpp>
+
+#include <cstdlib>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+void print(const char* state, asio2::tcp_server& server)
+{
+	const asio2::recv_buffer_counter& c = server.recv_buffer_stats();
+
+	printf("  %-12s : bytes %12zu, peak bytes %12zu, buffers %6zu, idle releases %8zu, shrinks %8zu\n",
+		state, c.bytes.load(), c.peak_bytes.load(), c.buffers.load(), c.idle_releases.load(), c.shrinks.load());
+}
+
+void wait_for(std::atomic<std::size_t>& recvd, std::size_t bytes)
+{
+	auto t1 = std::chrono::steady_clock::now();
+
+	while (recvd < bytes && std::chrono::steady_clock::now() - t1 < std::chrono::seconds(60))
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+
+	// let the sessions post the next recv
+	std::this_thread::sleep_for(std::chrono::milliseconds(200));
+}
+
+void run_once(bool release, std::size_t count, std::size_t burst, std::size_t smalls)
+{
+	printf("recv buffer release : %s\n", release ? "enabled" : "disabled");
+
+	asio2::tcp_server server;
+
+	std::atomic<std::size_t> recvd{ 0 };
+
+	server.recv_buffer_release(release);
+
+	server.bind_recv([&recvd](std::shared_ptr<asio2::tcp_session>&, std::string_view data)
+	{
+		recvd += data.size();
+	});
+
+	server.start("127.0.0.1", 18093, '\n');
+
+	std::vector<std::unique_ptr<asio2::tcp_client>> clients;
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		clients.emplace_back(std::make_unique<asio2::tcp_client>());
+		clients.back()->start("127.0.0.1", 18093);
+	}
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+	print("connected", server);
+
+	std::string large(burst, 'x'), small(100, 'y');
+
+	large += '\n';
+	small += '\n';
+
+	for (auto& client : clients)
+	{
+		client->async_send(large);
+	}
+
+	wait_for(recvd, count * large.size());
+
+	print("burst", server);
+
+	for (std::size_t i = 0; i < smalls; ++i)
+	{
+		for (auto& client : clients)
+		{
+			client->async_send(small);
+		}
+
+		wait_for(recvd, count * (large.size() + (i + 1) * small.size()));
+	}
+
+	print("idle", server);
+
+	for (auto& client : clients)
+	{
+		client->stop();
+	}
+
+	server.stop();
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t count  = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200);
+	std::size_t burst  = (argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1024 * 1024);
+	std::size_t smalls = (argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 20);
+
+	printf("session count : %zu, burst message size : %zu, small message count : %zu\n", count, burst, smalls);
+
+	run_once(false, count, burst, smalls);
+	run_once(true , count, burst, smalls);
+
+	return 0;
+}
@@ -7,6 +7,14 @@ bool first = true;
 
 int main()
 {
+#if defined(ASIO2_THREAD_PER_CORE)
+	printf("thread per core mode\n");
+#endif
+
+#if defined(ASIO2_DISABLE_METRICS)
+	printf("metrics disabled\n");
+#endif
+
 	asio2::tcp_server server;
 
 	server.bind_recv([&](std::shared_ptr<asio2::tcp_session>& session_ptr, std::string_view data)
@@ -38,5 +46,17 @@ int main()
 
 	while (std::getchar() != '\n');
 
+#if !defined(ASIO2_DISABLE_METRICS)
+	asio2::metrics_snapshot m = server.metrics();
+
+	printf("messages in %llu out %llu, handler latency ns : p50 %llu p99 %llu p99.9 %llu max %llu\n",
+		static_cast<unsigned long long>(m.messages_in),
+		static_cast<unsigned long long>(m.messages_out),
+		static_cast<unsigned long long>(m.handler_latency.percentile(50)),
+		static_cast<unsigned long long>(m.handler_latency.percentile(99)),
+		static_cast<unsigned long long>(m.handler_latency.percentile(99.9)),
+		static_cast<unsigned long long>(m.handler_latency.max));
+#endif
+
 	return 0;
 }
@@ -0,0 +1,235 @@
+// Compare the cpu usage of the kcp update timer with one asio::steady_timer for each session (the
+// old way) and with the shared timer wheel of the io_context (the new way : io_t::wheel()).
+//
+// usage : asio2_kcp_timer [sessions] [seconds]
+// eg    : asio2_kcp_timer 10000 5
+//
+// the sessions are connected in pairs in memory, the output of a kcp is input to the peer kcp
+// directly, so there is no socket and only the cost of the timer and the kcp is measured.
+// idle   : the sessions send nothing, just like the idle kcp sessions that are connected.
+// active : each session sends a small message to the peer every 100 milliseconds.
+
+#include <asio2/base/iopool.hpp>
+#include <asio2/base/detail/allocator.hpp>
+#include <asio2/udp/detail/kcp_util.hpp>
+
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+#include <thread>
+#include <future>
+
+namespace kcp = asio2::detail::kcp;
+
+inline std::uint32_t kcp_clock()
+{
+	return static_cast<std::uint32_t>(std::chrono::duration_cast<
+		std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+struct session_base
+{
+	session_base(bool active) : active_(active)
+	{
+		kcp_ = kcp::ikcp_create(1, this);
+		kcp_->output = &session_base::output;
+
+		kcp::ikcp_nodelay(kcp_, 1, 10, 2, 1);
+		kcp::ikcp_wndsize(kcp_, 128, 512);
+	}
+
+	~session_base()
+	{
+		kcp::ikcp_release(kcp_);
+	}
+
+	static int output(const char* buf, int len, kcp::ikcpcb*, void* user)
+	{
+		session_base* self = static_cast<session_base*>(user);
+		kcp::ikcp_input(self->peer_->kcp_, buf, len);
+		return 0;
+	}
+
+	void update()
+	{
+		std::uint32_t clock = kcp_clock();
+
+		if (active_ && std::int32_t(clock - next_send_) >= 0)
+		{
+			next_send_ = clock + 100;
+			kcp::ikcp_send(kcp_, message_, int(sizeof(message_)));
+		}
+
+		kcp::ikcp_update(kcp_, clock);
+
+		char buf[256];
+		while (kcp::ikcp_recv(kcp_, buf, int(sizeof(buf))) > 0)
+		{
+			recvd_++;
+		}
+	}
+
+	std::uint32_t next() const
+	{
+		std::uint32_t clock1 = kcp_clock();
+		return kcp::ikcp_check(kcp_, clock1) - clock1;
+	}
+
+	kcp::ikcpcb  * kcp_  = nullptr;
+	session_base * peer_ = nullptr;
+	bool           active_;
+	bool           stopped_ = false;
+	std::uint32_t  next_send_ = kcp_clock() + std::uint32_t(std::rand() % 100);
+	std::size_t    recvd_ = 0;
+	char           message_[64] = {};
+};
+
+// the old way : one steady_timer for each session
+struct timer_session : session_base
+{
+	timer_session(asio2::detail::io_t& io, bool active) : session_base(active), io_(io), timer_(io.context()) {}
+
+	void start()
+	{
+		timer_.expires_after(std::chrono::milliseconds(next()));
+		timer_.async_wait(asio::bind_executor(io_.strand(), asio2::detail::make_allocator(allocator_,
+		[this](const asio::error_code& ec)
+		{
+			// the timer maybe expired already when it is canceled
+			if (ec == asio::error::operation_aborted || stopped_)
+				return;
+			update();
+			start();
+		})));
+	}
+
+	void stop()
+	{
+		stopped_ = true;
+
+		asio::error_code ec_ignore{};
+		timer_.cancel(ec_ignore);
+	}
+
+	asio2::detail::io_t            & io_;
+	asio::steady_timer               timer_;
+	asio2::detail::handler_memory<>  allocator_;
+};
+
+// the new way : the shared timer wheel of the io
+struct wheel_session : session_base
+{
+	wheel_session(asio2::detail::io_t& io, bool active) : session_base(active), io_(io)
+	{
+		entry_.callback([this]()
+		{
+			update();
+			start();
+		});
+	}
+
+	void start()
+	{
+		io_.wheel().schedule(entry_, std::chrono::milliseconds(next()));
+	}
+
+	void stop()
+	{
+		io_.wheel().cancel(entry_);
+	}
+
+	asio2::detail::io_t        & io_;
+	asio2::detail::timer_entry   entry_;
+};
+
+template<class session_t>
+double run_once(std::size_t count, std::size_t seconds, bool active, std::size_t& recvd)
+{
+	asio::io_context ioc;
+	auto guard = asio::make_work_guard(ioc);
+	asio2::detail::io_t io(&ioc);
+
+	std::vector<std::unique_ptr<session_t>> sessions;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		sessions.emplace_back(std::make_unique<session_t>(io, active));
+	}
+	for (std::size_t i = 0; i + 1 < count; i += 2)
+	{
+		sessions[i    ]->peer_ = sessions[i + 1].get();
+		sessions[i + 1]->peer_ = sessions[i    ].get();
+	}
+	if (count % 2)
+	{
+		sessions.back()->peer_ = sessions.back().get();
+	}
+
+	std::thread thread([&ioc]() { ioc.run(); });
+
+	asio::post(io.strand(), [&sessions]()
+	{
+		for (auto& session : sessions)
+		{
+			session->start();
+		}
+	});
+
+	// warm up
+	std::this_thread::sleep_for(std::chrono::seconds(1));
+
+	std::clock_t c1 = std::clock();
+	auto t1 = std::chrono::steady_clock::now();
+
+	std::this_thread::sleep_for(std::chrono::seconds(seconds));
+
+	std::clock_t c2 = std::clock();
+	auto t2 = std::chrono::steady_clock::now();
+
+	std::promise<void> promise;
+	asio::post(io.strand(), [&sessions, &promise]()
+	{
+		for (auto& session : sessions)
+		{
+			session->stop();
+		}
+		promise.set_value();
+	});
+	promise.get_future().wait();
+
+	guard.reset();
+	thread.join();
+
+	recvd = 0;
+	for (auto& session : sessions)
+	{
+		recvd += session->recvd_;
+	}
+
+	double cpu  = double(c2 - c1) / double(CLOCKS_PER_SEC);
+	double wall = double(std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count()) / 1000.0;
+
+	return cpu / wall * 100.0;
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t count   = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000);
+	std::size_t seconds = (argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 5);
+
+	printf("sessions : %zu, seconds : %zu\n", count, seconds);
+
+	for (bool active : { false, true })
+	{
+		std::size_t recvd1 = 0, recvd2 = 0;
+
+		double timer = run_once<timer_session>(count, seconds, active, recvd1);
+		double wheel = run_once<wheel_session>(count, seconds, active, recvd2);
+
+		printf("%-6s steady_timer per session : %6.1lf%% cpu, recvd : %zu\n",
+			active ? "active" : "idle", timer, recvd1);
+		printf("%-6s io timer wheel           : %6.1lf%% cpu, recvd : %zu\n",
+			active ? "active" : "idle", wheel, recvd2);
+	}
+
+	return 0;
+}
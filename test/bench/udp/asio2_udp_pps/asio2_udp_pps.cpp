@@ -0,0 +1,125 @@
+// Compare the datagrams per second of the default recv mode : server.recv_batch(0)
+// with the recvmmsg batch recv mode                        : server.recv_batch(N)
+// and the SO_REUSEPORT multi socket mode                   : server.start(host, port, asio2::reuse_port(N))
+//
+// usage : asio2_udp_pps [server threads] [client threads] [peers per client] [batch] [seconds]
+// eg    : asio2_udp_pps 4 2 64 64 5
+//
+// each client thread owns many sockets (peers), and sends small datagrams to the server
+// round robin as fast as possible, the server counts the recv notifications, so the result
+// is the count of datagrams that are handled by the server per second.
+// the recv batch mode is only available on linux.
+
+#include <asio2/udp/udp_server.hpp>
+
+#include <cstdlib>
+#include <vector>
+#include <thread>
+
+template<class... Args>
+double run_once(std::size_t server_threads, std::size_t client_threads, std::size_t peers,
+	std::size_t batch, std::size_t seconds, unsigned short port, Args&&... args)
+{
+	asio2::udp_server server(1024, asio2::detail::max_buffer_size, server_threads);
+
+	server.recv_batch(batch);
+
+	std::atomic<std::size_t> recvd{ 0 };
+
+	server.bind_recv([&recvd](std::shared_ptr<asio2::udp_session>&, std::string_view)
+	{
+		recvd.fetch_add(1, std::memory_order_relaxed);
+	});
+
+	if (!server.start("127.0.0.1", port, std::forward<Args>(args)...))
+	{
+		printf("start failure : %s\n", asio2::last_error_msg().c_str());
+		return 0.0;
+	}
+
+	std::atomic<bool> stop_flag{ false };
+	std::vector<std::thread> threads;
+
+	asio::ip::udp::endpoint endpoint(asio::ip::make_address("127.0.0.1"), port);
+
+	for (std::size_t i = 0; i < client_threads; ++i)
+	{
+		threads.emplace_back([&stop_flag, endpoint, peers]()
+		{
+			asio::io_context ioc;
+			std::vector<std::unique_ptr<asio::ip::udp::socket>> sockets;
+			for (std::size_t j = 0; j < peers; ++j)
+			{
+				sockets.emplace_back(std::make_unique<asio::ip::udp::socket>(ioc));
+				sockets.back()->open(endpoint.protocol());
+			}
+			char msg[64] = { 'a' };
+			while (!stop_flag)
+			{
+				for (auto& socket : sockets)
+				{
+					asio::error_code ec;
+					socket->send_to(asio::buffer(msg), endpoint, 0, ec);
+				}
+			}
+		});
+	}
+
+	// skip the connect period of the sessions
+	std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+	std::size_t count1 = recvd.load();
+
+	auto t1 = std::chrono::steady_clock::now();
+
+	std::this_thread::sleep_for(std::chrono::seconds(seconds));
+
+	std::size_t count2 = recvd.load();
+
+	auto t2 = std::chrono::steady_clock::now();
+
+	stop_flag = true;
+
+	for (auto& t : threads)
+	{
+		t.join();
+	}
+
+	server.stop();
+
+	double ms = double(std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count());
+
+	return double(count2 - count1) / (ms / 1000.0);
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t server_threads = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4);
+	std::size_t client_threads = (argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 2);
+	std::size_t peers          = (argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 64);
+	std::size_t batch          = (argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 64);
+	std::size_t seconds        = (argc > 5 ? std::strtoull(argv[5], nullptr, 10) : 5);
+
+	printf("server threads : %zu, client threads : %zu, peers per client : %zu, seconds : %zu\n",
+		server_threads, client_threads, peers, seconds);
+
+	double single = run_once(server_threads, client_threads, peers, 0, seconds, 18092);
+
+	printf("recv_batch( 0)                : %10.0lf datagrams/Sec\n", single);
+
+	double multi = run_once(server_threads, client_threads, peers, batch, seconds, 18093);
+
+	printf("recv_batch(%2zu)                : %10.0lf datagrams/Sec\n", batch, multi);
+
+	double reuse = run_once(server_threads, client_threads, peers, 0, seconds, 18094,
+		asio2::reuse_port(server_threads));
+
+	printf("reuse_port(%2zu)                : %10.0lf datagrams/Sec\n", server_threads, reuse);
+
+	double both = run_once(server_threads, client_threads, peers, batch, seconds, 18095,
+		asio2::reuse_port(server_threads));
+
+	printf("reuse_port(%2zu) recv_batch(%2zu) : %10.0lf datagrams/Sec\n", server_threads, batch, both);
+
+	return 0;
+}